@@ -49,6 +49,12 @@ if(NOT "${PROFILER}" STREQUAL "None")
         endif(SHINY_CALL_LOGGING)
              	
         
+    # Native: thread-aware profiler, which uses the shiny tree for reporting
+    elseif("${PROFILER}" STREQUAL "Native")
+    	add_definitions(-DUG_PROFILER_SHINY -DUG_PROFILER_NATIVE)
+     	set(UG_PROFILER_SHINY ON)
+     	set(UG_PROFILER_NATIVE ON)
+
     # Scalasca
     elseif("${PROFILER}" STREQUAL "Scalasca")
         find_package(Scalasca)
@@ -122,7 +122,7 @@ set(precisionDefault "double")
 set(precisionOptions "single, double")
 
 # Values for the PROFILER option
-set(profilerOptions "None, Shiny, Scalasca, Vampir, ScoreP")
+set(profilerOptions "None, Shiny, Native, Scalasca, Vampir, ScoreP")
 set(profilerDefault "None")
 
 # Option to set frequency
@@ -472,6 +472,17 @@ elseif(WIN32)
 endif(UNIX)
 
 
+########################################
+# zlib (optional, used for compressed vtk output)
+find_package(ZLIB QUIET)
+if(ZLIB_FOUND)
+	add_definitions(-DUG_ZLIB)
+	include_directories(SYSTEM ${ZLIB_INCLUDE_DIRS})
+	set(linkLibraries ${linkLibraries} ${ZLIB_LIBRARIES})
+	message(STATUS "Info: Using zlib for compressed output.")
+endif(ZLIB_FOUND)
+
+
 
 
 ########################################
@@ -499,6 +510,9 @@ endif(buildCompileInfo)
 ########################################
 if(POSIX)
 	add_definitions(-DUG_POSIX)
+	# threads are used for background file writing
+	find_package(Threads)
+	set(linkLibraries ${linkLibraries} ${CMAKE_THREAD_LIBS_INIT})
 endif(POSIX)
 
 ########################################
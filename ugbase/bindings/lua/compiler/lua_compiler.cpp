@@ -71,6 +71,7 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 	UG_DLOG(DID_LUACOMPILER, 1, "LUA2C: parsing " << functionName << "... ");
 	try{
 		m_f=NULL;
+		m_fBatch=NULL;
 		LUAParserClass parser;
 		int ret = 0;
 		if(pHandle == NULL){
@@ -166,6 +167,8 @@ bool LUACompiler::createC(const char *functionName, LuaFunctionHandle* pHandle)
 			return false;
 		}
 		m_f = (LUA2C_Function) GetLibraryProcedure(m_libHandle, functionName);
+		m_fBatch = (LUA2C_BatchFunction) GetLibraryProcedure(m_libHandle,
+		                               (string(functionName) + "_batch").c_str());
 
 		if(m_f !=NULL) { UG_DLOG(DID_LUACOMPILER, 1, "OK\n"); }
 		else { UG_DLOG(DID_LUACOMPILER, 1, "FAILED\n"); }
@@ -275,6 +278,29 @@ bool LUACompiler::call(double *ret, const double *in) const
 	}
 }
 
+bool LUACompiler::call_batch(double *ret, const double *in, size_t n) const
+{
+	if(bVM)
+	{
+		VMAdd* pVM = const_cast<LUACompiler*>(this)->vm;
+		for(size_t i = 0; i < n; ++i)
+			pVM->execute(ret + i*m_iOut, in + i*m_iIn);
+		return true;
+	}
+	else if(m_fBatch != NULL)
+	{
+		m_fBatch(ret, in, (int)n);
+		return true;
+	}
+	else
+	{
+		UG_ASSERT(m_f != NULL, "function " << m_name << " not valid");
+		for(size_t i = 0; i < n; ++i)
+			m_f(ret + i*m_iOut, in + i*m_iIn);
+		return true;
+	}
+}
+
 
 }
 }
@@ -51,6 +51,7 @@ class LUACompiler
 	
 private:
 	typedef int (*LUA2C_Function)(double *, const double *) ;
+	typedef int (*LUA2C_BatchFunction)(double *, const double *, int) ;
 	
 	DynLibHandle m_libHandle;
 	std::string m_pDyn;
@@ -59,12 +60,14 @@ private:
 public:
 	std::string m_name;
 	LUA2C_Function m_f;
+	LUA2C_BatchFunction m_fBatch;
 	int m_iIn, m_iOut;
 	bool bInitialized;
 	bool bVM;
 	LUACompiler()
 	{ 
 		m_f= NULL; 
+		m_fBatch = NULL;
 		m_name = "uninitialized"; 
 		m_pDyn = ""; 
 		m_libHandle = NULL;
@@ -98,6 +101,10 @@ public:
 	bool createC(const char *functionName, LuaFunctionHandle* pHandle = NULL);
 	
 	bool call(double *ret, const double *in) const;
+
+	///	evaluates the function for n input tuples stored consecutively in 'in'
+	/**	The results are stored consecutively in 'ret' (num_out() values each). */
+	bool call_batch(double *ret, const double *in, size_t n) const;
 	virtual ~LUACompiler();
 };
 
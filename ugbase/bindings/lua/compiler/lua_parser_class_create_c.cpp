@@ -345,6 +345,18 @@ int LUAParserClass::createC(ostream &out)
 	out << "\t// code:\n";
 	for(size_t i=0; i<nodes.size(); i++)
 		createC(nodes[i], out, 1);
+	out << "}\n\n";
+
+	// batched version: evaluates the function for n consecutive input tuples,
+	// such that the loop is compiled (and vectorized) together with the function
+	out << "int " << name << "_batch(";
+	out << "double *LUA2C_ret, const double *LUA2C_in, int LUA2C_n)\n";
+	out << "{\n";
+	out << "\tint LUA2C_i;\n";
+	out << "\tfor(LUA2C_i = 0; LUA2C_i < LUA2C_n; ++LUA2C_i)\n";
+	out << "\t\t" << name << "(LUA2C_ret + LUA2C_i*" << num_out()
+		<< ", LUA2C_in + LUA2C_i*" << num_in() << ");\n";
+	out << "\treturn 1;\n";
 	out << "}\n";
 	return LUAParserOK;
 }
@@ -135,6 +135,15 @@ class LuaUserData
 	///	evaluates the data at a given point and time
 		inline TRet evaluate(TData& D, const MathVector<dim>& x, number time, int si) const;
 
+	///	evaluates the data at several points at once
+	/**
+	 * If the callback has been compiled (LUA2C/LUA2VM), the points are passed
+	 * in chunks to the compiled function, such that no Lua interpreter is
+	 * involved. Otherwise, the callback is called point by point.
+	 */
+		void evaluate_batch(TData vValue[], const MathVector<dim> vGlobIP[],
+		                    number time, int si, const size_t nip) const;
+
 	protected:
 	///	sets that LuaUserData is created by LuaUserDataFactory
 		void set_created_from_factory(bool bFromFactory) {m_bFromFactory = bFromFactory;}
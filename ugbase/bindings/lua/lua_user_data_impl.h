@@ -33,6 +33,8 @@
 #ifndef __H__UG_BRIDGE__BRIDGES__USER_DATA__USER_DATA_IMPL_
 #define __H__UG_BRIDGE__BRIDGES__USER_DATA__USER_DATA_IMPL_
 
+#include <algorithm>
+
 #include "lua_user_data.h"
 #include "lib_disc/spatial_disc/user_data/linker/linker_traits.h"
 #include "lib_disc/spatial_disc/user_data/const_user_data.h"
@@ -349,6 +351,52 @@ evaluate(TData& D, const MathVector<dim>& x, number time, int si) const
 	}
 }
 
+template <typename TData, int dim, typename TRet>
+void LuaUserData<TData,dim,TRet>::
+evaluate_batch(TData vValue[], const MathVector<dim> vGlobIP[],
+               number time, int si, const size_t nip) const
+{
+	PROFILE_CALLBACK()
+	#ifdef USE_LUA2C
+	if(useLuaCompiler && m_luaComp.is_valid())
+	{
+	//	points are passed in chunks, using buffers on the stack
+		static const size_t chunkSize = 32;
+		static const int numIn = dim+2;
+		static const int maxOut = lua_traits<TData>::size+1;
+		const int numOut = m_luaComp.num_out();
+		UG_ASSERT(numOut <= maxOut, m_luaComp.name() << ", " << numOut << " > " << maxOut);
+
+		double in[chunkSize*numIn];
+		double ret[chunkSize*maxOut];
+		TRet *t=NULL;
+
+		for(size_t ip0 = 0; ip0 < nip; ip0 += chunkSize)
+		{
+			const size_t n = std::min(chunkSize, nip - ip0);
+
+			for(size_t k = 0; k < n; ++k)
+			{
+				double* d = in + k*numIn;
+				for(int i=0; i<dim; i++)
+					d[i] = vGlobIP[ip0+k][i];
+				d[dim] = time;
+				d[dim+1] = si;
+			}
+
+			m_luaComp.call_batch(ret, in, n);
+
+			for(size_t k = 0; k < n; ++k)
+				lua_traits<TData>::read(vValue[ip0+k], ret + k*numOut, t);
+		}
+		return;
+	}
+	#endif
+
+	for(size_t ip = 0; ip < nip; ++ip)
+		evaluate(vValue[ip], vGlobIP[ip], time, si);
+}
+
 template <typename TData, int dim, typename TRet>
 LuaUserData<TData,dim,TRet>::~LuaUserData()
 {
@@ -191,6 +191,8 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<matrix_type>(name, grp)
 			.add_constructor()
 			.add_method("print|hide=true", &matrix_type::p)
+			.add_method("enable_packed_storage", &matrix_type::enable_packed_storage, "", "bEnable", "use a packed (SELL-C-sigma/block-CRS) copy of the matrix for matrix-vector products")
+			.add_method("update_packed_storage", &matrix_type::update_packed_storage, "", "", "rebuild the packed copy after the matrix has been changed")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "Matrix", tag);
 	}
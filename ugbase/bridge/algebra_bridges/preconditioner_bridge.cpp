@@ -178,7 +178,11 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "makes the matrix and defect consistent at the proc. interfaces")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
 			.add_method("set_sor_relax", &T::set_sor_relax,
-					"", "sor relaxation", "sets sor relaxation parameter");
+					"", "sor relaxation", "sets sor relaxation parameter")
+			.add_method("set_mixed_precision", &T::set_mixed_precision,
+					"", "mixed", "uses a single precision copy of the matrix for the sweeps")
+			.add_method("enable_level_scheduling", &T::enable_level_scheduling,
+					"", "enable", "threads the sweeps using level sets of the matrix");
 		reg.add_class_to_group(name, "GaussSeidelBase", tag);
 	}
 
@@ -248,6 +252,8 @@ static void Algebra(Registry& reg, string grp)
 						"set whether preprocessing (notably, LU factorization) is to be disabled - usable when the operator has not changed; use with care")
 			.add_method("enable_consistent_interfaces", &T::enable_consistent_interfaces, "", "enable", "Make Matrix consistent for connections in interfaces.")
 			.add_method("enable_overlap", &T::enable_overlap, "", "enable", "Enables matrix overlap. This also means that interfaces are consistent.")
+			.add_method("set_mixed_precision", &T::set_mixed_precision, "", "mixed", "stores the factors in single precision for the triangular solves")
+			.add_method("enable_level_scheduling", &T::enable_level_scheduling, "", "enable", "threads the triangular solves using level sets of the factors")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILU", tag);
 	}
@@ -265,6 +271,7 @@ static void Algebra(Registry& reg, string grp)
 			.add_method("set_info", &T::set_info,
 						"", "info", "sets storage information output")
 			.add_method("set_sort", &T::set_sort, "", "bSort", "if bSort=true, use a cuthill-mckey sorting to reduce fill-in. default true")
+			.add_method("set_mixed_precision", &T::set_mixed_precision, "", "mixed", "stores the factors in single precision for the triangular solves")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "ILUT", tag);
 	}
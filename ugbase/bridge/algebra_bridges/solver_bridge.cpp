@@ -48,6 +48,8 @@
 #include "lib_algebra/operator/linear_solver/analyzing_solver.h"
 #include "lib_algebra/operator/linear_solver/cg.h"
 #include "lib_algebra/operator/linear_solver/bicgstab.h"
+#include "lib_algebra/operator/linear_solver/pipe_cg.h"
+#include "lib_algebra/operator/linear_solver/pipe_bicgstab.h"
 #include "lib_algebra/operator/linear_solver/gmres.h"
 #include "lib_algebra/operator/linear_solver/lu.h"
 #include "lib_algebra/operator/linear_solver/agglomerating_solver.h"
@@ -233,6 +235,32 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "BiCGStab", tag);
 	}
 
+// 	PipeCG Solver
+	{
+		typedef PipeCG<vector_type> T;
+		typedef IPreconditionedLinearOperatorInverse<vector_type> TBase;
+		string name = string("PipeCG").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Pipelined Conjugate Gradient Solver (one overlapped reduction per iteration)")
+			.add_constructor()
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> > ) )("precond")
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> >, SmartPtr<IConvergenceCheck<vector_type> >) )("precond#convCheck")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "PipeCG", tag);
+	}
+
+// 	PipeBiCGStab Solver
+	{
+		typedef PipeBiCGStab<vector_type> T;
+		typedef IPreconditionedLinearOperatorInverse<vector_type> TBase;
+		string name = string("PipeBiCGStab").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Pipelined BiCGStab Solver (two overlapped reductions per iteration)")
+			.add_constructor()
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> > ) )("precond")
+			. ADD_CONSTRUCTOR( (SmartPtr<ILinearIterator<vector_type,vector_type> >, SmartPtr<IConvergenceCheck<vector_type> >) )("precond#convCheck")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "PipeBiCGStab", tag);
+	}
+
 // 	GMRES Solver
 	{
 		typedef GMRES<vector_type> T;
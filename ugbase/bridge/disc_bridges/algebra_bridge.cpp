@@ -51,7 +51,9 @@
 #include "lib_disc/spatial_disc/constraints/constraint_interface.h"
 #include "lib_disc/time_disc/time_disc_interface.h"
 #include "lib_disc/time_disc/theta_time_step.h"
+#include "lib_disc/time_disc/adaptive_time_integrator.h"
 #include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
+#include "lib_disc/operator/linear_operator/jacobian_free_operator.h"
 #include "lib_disc/operator/non_linear_operator/assembled_non_linear_operator.h"
 #include "lib_disc/operator/non_linear_operator/line_search.h"
 #include "lib_disc/operator/linear_operator/nested_iteration/nested_iteration.h"
@@ -178,7 +180,17 @@ static void Algebra(Registry& reg, string parentGroup)
 				"calculate error indicators for elements from error estimators of the elemDiscs")
 			.add_method("invalidate_error", &T::invalidate_error, "", "Marks error indicators as invalid, "
 				"which will prohibit refining and coarsening before a new call to calc_error.")
-			.add_method("is_error_valid", &T::is_error_valid, "", "Returns whether error indicators are valid");
+			.add_method("is_error_valid", &T::is_error_valid, "", "Returns whether error indicators are valid")
+			.add_method("set_linear_time_invariant", &T::set_linear_time_invariant, "", "bLTI",
+				"caches mass and stiffness matrix of a linear problem with time-invariant operators")
+			.add_method("linear_time_invariant", &T::linear_time_invariant)
+			.add_method("invalidate_operator_cache", &T::invalidate_operator_cache, "", "",
+				"forces a reassembling of the cached mass and stiffness matrix")
+			.add_method("num_operator_assemblies", &T::num_operator_assemblies)
+			.add_method("invalidate_system_matrix", &T::invalidate_system_matrix, "", "",
+				"forces the system matrix to be formed in the next assemble_linear")
+			.add_method("system_matrix_changed", &T::system_matrix_changed, "bChanged", "",
+				"returns if the last assemble_linear has formed the system matrix");
 		reg.add_class_to_group(name, "MultiStepTimeDiscretization", tag);
 	}
 
@@ -247,6 +259,20 @@ static void Algebra(Registry& reg, string parentGroup)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "AssembledLinearOperator", tag);
 	}
+
+//	JacobianFreeOperator
+	{
+		std::string grp = parentGroup; grp.append("/Discretization");
+		typedef JacobianFreeOperator<TAlgebra> T;
+		typedef AssembledLinearOperator<TAlgebra> TBase;
+		string name = string("JacobianFreeOperator").append(suffix);
+		reg.add_class_<T, TBase>(name, grp, "Matrix-free Jacobian by finite differences of the defect")
+			.template add_constructor<void (*)(SmartPtr<IAssemble<TAlgebra> >)>("Assembling Routine")
+			.add_method("set_preconditioner_discretization", &T::set_preconditioner_discretization, "", "ass", "sets a discretization used to assemble the preconditioning matrix")
+			.add_method("set_step_size", &T::set_step_size, "", "eps", "sets a fixed finite difference step size (0 = automatic)")
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "JacobianFreeOperator", tag);
+	}
 	
 
 //	NewtonSolver
@@ -282,6 +308,14 @@ static void Algebra(Registry& reg, string parentGroup)
 			.add_method("clear_inner_step_update", &T::clear_inner_step_update, "clear inner step update", "")
 			.add_method("add_step_update", &T::add_step_update, "data update called before every Newton step", "")
 			.add_method("clear_step_update", &T::clear_step_update, "clear step update", "")
+			.add_method("set_jacobian_operator", &T::set_jacobian_operator, "", "J", "sets the operator used as Jacobian, e.g. a JacobianFreeOperator")
+			.add_method("set_jacobian_reuse", &T::set_jacobian_reuse, "", "maxSteps", "reassembles the Jacobian only every maxSteps Newton steps")
+			.add_method("set_preconditioner_reuse", &T::set_preconditioner_reuse, "", "maxSteps", "reinitializes the linear solver only every maxSteps Newton steps")
+			.add_method("set_reuse_contraction_limit", &T::set_reuse_contraction_limit, "", "rate", "renews reused Jacobian and setup if the Newton rate exceeds this value")
+			.add_method("set_eisenstat_walker", &T::set_eisenstat_walker, "", "bEnable", "enables adaptive linear tolerances")
+			.add_method("set_eisenstat_walker_params", &T::set_eisenstat_walker_params, "", "etaMax#gamma#alpha")
+			.add_method("num_jacobian_assemblies", &T::num_jacobian_assemblies, "number of Jacobian assemblies")
+			.add_method("num_linsolver_setups", &T::num_linsolver_setups, "number of linear solver setups")
 			.add_method("config_string", &T::config_string)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "NewtonSolver", tag);
@@ -407,6 +441,33 @@ static void Algebra(Registry& reg, string parentGroup)
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "SolutionTimeSeries", tag);
 	}
+
+//	AdaptiveTimeIntegrator
+	{
+		std::string grp = parentGroup; grp.append("/Discretization/TimeDisc");
+		string name = string("AdaptiveTimeIntegrator").append(suffix);
+		typedef AdaptiveTimeIntegrator<TAlgebra> T;
+		reg.add_class_<T>(name, grp)
+			.template add_constructor<void (*)(SmartPtr<MultiStepTimeDiscretization<TAlgebra> >,
+			                                   SmartPtr<IOperatorInverse<vector_type> >)>("TimeDisc#Solver")
+			.add_method("set_tolerance", &T::set_tolerance, "", "rtol#atol", "tolerances for the local error")
+			.add_method("set_initial_time_step", &T::set_initial_time_step, "", "dt")
+			.add_method("set_time_step_bounds", &T::set_time_step_bounds, "", "dtMin#dtMax")
+			.add_method("set_step_factor_bounds", &T::set_step_factor_bounds, "", "minFactor#maxFactor")
+			.add_method("set_safety", &T::set_safety, "", "safety")
+			.add_method("set_pi_params", &T::set_pi_params, "", "kI#kP")
+			.add_method("set_order", &T::set_order, "", "order", "order of the scheme (0 = derive from time disc)")
+			.add_method("set_grid_level", &T::set_grid_level, "", "gl")
+			.add_method("set_verbose", &T::set_verbose, "", "bVerbose")
+			.add_method("apply", &T::apply, "success", "solTimeSeries#endTime",
+				"advances the time series up to the end time")
+			.add_method("num_accepted_steps", &T::num_accepted_steps)
+			.add_method("num_rejected_steps", &T::num_rejected_steps)
+			.add_method("time_step", &T::time_step)
+			.add_method("last_error", &T::last_error)
+			.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "AdaptiveTimeIntegrator", tag);
+	}
 }
 
 /**
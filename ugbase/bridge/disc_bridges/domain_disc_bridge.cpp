@@ -237,6 +237,8 @@ static void Algebra(Registry& reg, string grp)
 		reg.add_class_<T>(name+suffix, grp)
 			.add_method("set_matrix_is_const", &T::set_matrix_is_const, "",
 						"whether matrix is constant in time", "")
+			.add_method("set_reuse_matrix_pattern", &T::set_reuse_matrix_pattern, "",
+						"whether sparsity pattern of assembled matrices is reused", "")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name+suffix, name, tag);
 	}
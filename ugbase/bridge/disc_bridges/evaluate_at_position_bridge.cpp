@@ -35,6 +35,8 @@
 #include <sstream>
 #include <string>
 #include <limits>
+#include <list>
+#include <vector>
 
 // include bridge
 #include "bridge/bridge.h"
@@ -45,6 +47,10 @@
 #include "lib_disc/dof_manager/dof_distribution.h"
 #include "lib_disc/function_spaces/grid_function.h"
 
+// lib_grid includes
+#include "lib_grid/lib_grid_messages.h"
+#include "lib_grid/algorithms/trees/kd_tree_static.h"
+
 // pcl includes
 #ifdef UG_PARALLEL
 	#include "pcl/pcl_util.h"
@@ -128,101 +134,330 @@ bool CloseVertexExists(const MathVector<TDomain::dim>& globPos,
  * \{
  */
 
-template <typename TGridFunction>
-number EvaluateAtVertex(const MathVector<TGridFunction::dim>& globPos,
-						SmartPtr<TGridFunction> spGridFct,
-						size_t fct,
-						const SubsetGroup& ssGrp,
-						typename TGridFunction::domain_type::subset_handler_type* sh,
-						bool minimizeOverAllProcs = false)
+///	spatial index over the vertices considered by EvaluateAtVertex
+/**
+ * Collects the local surface vertices (no children, no ghosts, no h-slaves)
+ * of the given subsets, on which a function is defined, and organizes them
+ * in a KDTreeStatic. Closest vertex queries are then answered in O(log(n))
+ * instead of a scan over all vertices.
+ *
+ * The locator depends only on the domain, the subset handler, the subsets
+ * and the subsets in which the function is defined, but not on a grid
+ * function. It holds no owning pointers: it observes the grid and is marked
+ * dead, when the grid is destroyed.
+ *
+ * The tree is recreated lazily after the grid has been adapted, created or
+ * redistributed, which is signaled through the message hub of the grid. In
+ * addition, the position revision of the domain is stored, so that a movement
+ * of vertices (e.g. on moving meshes) leads to a recreation as well. Code
+ * moving vertices has to announce this by IDomain::positions_changed().
+ */
+template <typename TDomain>
+class ClosestVertexLocator : public GridObserver
 {
+	public:
+	///	world dimension
+		static const int dim = TDomain::dim;
+
+	///	domain type
+		typedef TDomain domain_type;
+		typedef typename domain_type::grid_type grid_type;
+		typedef typename domain_type::subset_handler_type subset_handler_type;
+		typedef typename domain_type::position_attachment_type position_attachment_type;
+
+	public:
+	///	constructor
+	/**
+	 * \param[in]	dom				domain
+	 * \param[in]	sh				subset handler defining the subsets
+	 * \param[in]	vSubset			subsets (of sh) whose vertices are collected
+	 * \param[in]	bDefEverywhere	if the function is defined in all subsets
+	 * \param[in]	vDefInSubset	subsets (of the domain) where the function is defined
+	 */
+		ClosestVertexLocator(domain_type* dom, subset_handler_type* sh,
+		                     const std::vector<int>& vSubset, bool bDefEverywhere,
+		                     const std::vector<bool>& vDefInSubset)
+			: m_pDom(dom), m_pGrid(dom->grid().get()), m_pSH(sh),
+			  m_vSubset(vSubset), m_bDefEverywhere(bDefEverywhere),
+			  m_vDefInSubset(vDefInSubset), m_bValid(false)
+		{
+			m_pGrid->register_observer(this, OT_GRID_OBSERVER);
+
+			MessageHub* msgHub = m_pGrid->message_hub().get();
+			m_spAdaptionCallbackID = msgHub->register_class_callback(this,
+						&ClosestVertexLocator<TDomain>::grid_adaption_callback);
+			m_spCreationCallbackID = msgHub->register_class_callback(this,
+						&ClosestVertexLocator<TDomain>::grid_creation_callback);
+			m_spDistributionCallbackID = msgHub->register_class_callback(this,
+						&ClosestVertexLocator<TDomain>::grid_distribution_callback);
+		}
 
-//	domain type
-	typedef typename TGridFunction::domain_type domain_type;
-	typedef typename domain_type::grid_type grid_type;
-	typedef typename domain_type::subset_handler_type subset_handler_type;
-// get position accessor
-	domain_type* dom = spGridFct->domain().get();
-	grid_type* grid = dom->grid().get();
+	///	destructor
+		virtual ~ClosestVertexLocator()
+		{
+			if(m_pGrid) m_pGrid->unregister_observer(this);
+		}
 
-	subset_handler_type* domSH = dom->subset_handler().get();
+	///	returns false if the grid of the locator has been destroyed
+		bool alive() const {return m_pGrid != NULL;}
+
+	///	returns if the locator has been created for the given arguments
+		bool matches(domain_type* dom, subset_handler_type* sh,
+		             const std::vector<int>& vSubset, bool bDefEverywhere,
+		             const std::vector<bool>& vDefInSubset) const
+		{
+			return alive() && m_pDom == dom && m_pGrid == dom->grid().get()
+				&& m_pSH == sh && m_vSubset == vSubset
+				&& m_bDefEverywhere == bDefEverywhere
+				&& (bDefEverywhere || m_vDefInSubset == vDefInSubset);
+		}
 
-	const typename domain_type::position_accessor_type& aaPos
-										= dom->position_accessor();
+	///	returns the closest vertex (or NULL if no vertex exists) and the squared distance
+		Vertex* closest_vertex(number& distSqOut, const MathVector<dim>& globPos)
+		{
+			if(!m_bValid || m_posRevision != m_pDom->position_revision())
+				update();
 
-	std::vector<DoFIndex> ind;
-	Vertex* chosen = NULL;
+			distSqOut = std::numeric_limits<number>::max();
+			if(m_vVrt.empty()) return NULL;
 
-	typename subset_handler_type::template traits<Vertex>::const_iterator iterEnd, iter;
-	number minDistanceSq = std::numeric_limits<double>::max();
+			MathVector<dim> pos = globPos;
+			m_tree.get_neighbourhood(m_vClosest, pos, 1);
+			if(m_vClosest.empty()) return NULL;
 
-	#ifdef UG_PARALLEL
-		DistributedGridManager* dgm = grid->distributed_grid_manager();
-	#endif
+			distSqOut = VecDistanceSq(globPos, m_pDom->position_accessor()[m_vClosest[0]]);
+			return m_vClosest[0];
+		}
 
-	for(size_t i = 0; i < ssGrp.size(); ++i)
-	{
-	//	get subset index
-		const int si = ssGrp[i];
+	///	the grid is destroyed, the locator must not be used anymore
+		virtual void grid_to_be_destroyed(Grid* grid)
+		{
+			m_pGrid = NULL;
+			m_bValid = false;
+			m_vVrt.clear();
+			m_tree.clear();
+		}
 
-	// 	iterate over all elements
-		for(size_t lvl = 0; lvl < sh->num_levels(); ++lvl){
-			iterEnd = sh->template end<Vertex>(si, lvl);
-			iter = sh->template begin<Vertex>(si, lvl);
-			for(; iter != iterEnd; ++iter)
+	protected:
+	///	collects the vertices and recreates the tree
+		void update()
+		{
+			subset_handler_type* domSH = m_pDom->subset_handler().get();
+			const typename domain_type::position_accessor_type& aaPos
+												= m_pDom->position_accessor();
+
+			#ifdef UG_PARALLEL
+				DistributedGridManager* dgm = m_pGrid->distributed_grid_manager();
+			#endif
+
+			m_vVrt.clear();
+			typename subset_handler_type::template traits<Vertex>::const_iterator iterEnd, iter;
+			for(size_t i = 0; i < m_vSubset.size(); ++i)
 			{
-			//	get element
-			//todo: replace most of the following checks by a spGridFct->contains(...)
-				Vertex* vrt = *iter;
-				if(grid->has_children(vrt)) continue;
+				const int si = m_vSubset[i];
+				for(size_t lvl = 0; lvl < m_pSH->num_levels(); ++lvl){
+					iterEnd = m_pSH->template end<Vertex>(si, lvl);
+					iter = m_pSH->template begin<Vertex>(si, lvl);
+					for(; iter != iterEnd; ++iter)
+					{
+						Vertex* vrt = *iter;
+						if(m_pGrid->has_children(vrt)) continue;
+
+						#ifdef UG_PARALLEL
+							if(dgm->is_ghost(vrt))	continue;
+							if(dgm->contains_status(vrt, INT_H_SLAVE)) continue;
+						#endif
+
+					//	skip if function is not defined in subset
+						if(!m_bDefEverywhere){
+							const int domSI = domSH->get_subset_index(vrt);
+							if(domSI < 0 || domSI >= (int)m_vDefInSubset.size()
+								|| !m_vDefInSubset[domSI])
+								continue;
+						}
+
+						m_vVrt.push_back(vrt);
+					}
+				}
+			}
 
-				#ifdef UG_PARALLEL
-					if(dgm->is_ghost(vrt))	continue;
-					if(dgm->contains_status(vrt, INT_H_SLAVE)) continue;
-				#endif
+			m_tree.create_from_grid(*m_pGrid, m_vVrt.begin(), m_vVrt.end(),
+			                        aaPos, 32, 16);
+			m_posRevision = m_pDom->position_revision();
+			m_bValid = true;
+		}
 
-				int domSI = domSH->get_subset_index(vrt);
+		void grid_adaption_callback(const GridMessage_Adaption& msg)
+		{
+			if(msg.adaption_ends()) m_bValid = false;
+		}
 
-			//	skip if function is not defined in subset
-				if(!spGridFct->is_def_in_subset(fct, domSI)) continue;
+		void grid_creation_callback(const GridMessage_Creation& msg)
+		{
+			if(msg.msg() == GMCT_CREATION_STOPS) m_bValid = false;
+		}
 
-			//	global position
-				number buffer = VecDistanceSq(globPos, aaPos[vrt]);
-				if(buffer < minDistanceSq)
-				{
-					minDistanceSq = buffer;
-					chosen = *iter;
-				}
-			}
+		void grid_distribution_callback(const GridMessage_Distribution& msg)
+		{
+			if(msg.msg() == GMDT_DISTRIBUTION_STOPS) m_bValid = false;
+		}
+
+	protected:
+		domain_type* m_pDom;
+		grid_type* m_pGrid;
+		subset_handler_type* m_pSH;
+		std::vector<int> m_vSubset;
+		bool m_bDefEverywhere;
+		std::vector<bool> m_vDefInSubset;
+
+		bool m_bValid;
+		std::vector<Vertex*> m_vVrt;
+		RevisionCounter m_posRevision;
+		KDTreeStatic<position_attachment_type, dim, MathVector<dim> > m_tree;
+		std::vector<Vertex*> m_vClosest;
+
+		MessageHub::SPCallbackId m_spAdaptionCallbackID;
+		MessageHub::SPCallbackId m_spCreationCallbackID;
+		MessageHub::SPCallbackId m_spDistributionCallbackID;
+};
+
+
+///	returns a cached locator for the vertices of a function in the given subsets
+/**
+ * The most recently used locators are kept, so that repeated queries (e.g.
+ * monitoring points in every time step) reuse the spatial index. The cache
+ * is keyed on the domain, the subset handler, the subsets and the subsets in
+ * which the function is defined. Thus, all grid functions of an approximation
+ * space share a locator. Locators of destroyed grids are removed.
+ */
+template <typename TGridFunction>
+ClosestVertexLocator<typename TGridFunction::domain_type>&
+GetClosestVertexLocator(SmartPtr<TGridFunction> spGridFct, size_t fct,
+                        const SubsetGroup& ssGrp,
+                        typename TGridFunction::domain_type::subset_handler_type* sh)
+{
+	typedef typename TGridFunction::domain_type domain_type;
+	typedef ClosestVertexLocator<domain_type> locator_type;
+	typedef std::list<SmartPtr<locator_type> > cache_type;
+	static cache_type cache;
+	static const size_t maxCacheSize = 16;
+
+	domain_type* dom = spGridFct->domain().get();
+
+//	key of the locator
+	std::vector<int> vSubset(ssGrp.size());
+	for(size_t i = 0; i < ssGrp.size(); ++i)
+		vSubset[i] = ssGrp[i];
+
+	const bool bDefEverywhere = spGridFct->is_def_everywhere(fct);
+	std::vector<bool> vDefInSubset;
+	if(!bDefEverywhere){
+		vDefInSubset.resize(dom->subset_handler()->num_subsets());
+		for(size_t si = 0; si < vDefInSubset.size(); ++si)
+			vDefInSubset[si] = spGridFct->is_def_in_subset(fct, (int)si);
+	}
+
+	for(typename cache_type::iterator it = cache.begin(); it != cache.end();){
+		if(!(*it)->alive()){
+			it = cache.erase(it);
+			continue;
 		}
+		if((*it)->matches(dom, sh, vSubset, bDefEverywhere, vDefInSubset)){
+			cache.splice(cache.begin(), cache, it);
+			return *cache.front();
+		}
+		++it;
 	}
 
-	// get corresponding value (if vertex found, otherwise take 0)
-	number value = 0.0;
-	if (chosen)
+	cache.push_front(make_sp(new locator_type(dom, sh, vSubset, bDefEverywhere,
+	                                          vDefInSubset)));
+	if(cache.size() > maxCacheSize)
+		cache.pop_back();
+	return *cache.front();
+}
+
+
+template <typename TGridFunction>
+void EvaluateAtVertices(std::vector<number>& vValueOut,
+						const std::vector<MathVector<TGridFunction::dim> >& vGlobPos,
+						SmartPtr<TGridFunction> spGridFct,
+						size_t fct,
+						const SubsetGroup& ssGrp,
+						typename TGridFunction::domain_type::subset_handler_type* sh,
+						bool minimizeOverAllProcs = false)
+{
+	ClosestVertexLocator<typename TGridFunction::domain_type>& locator
+		= GetClosestVertexLocator<TGridFunction>(spGridFct, fct, ssGrp, sh);
+
+	const size_t numPos = vGlobPos.size();
+	std::vector<number> vMinDistanceSq(numPos);
+	vValueOut.resize(numPos);
+
+	std::vector<DoFIndex> ind;
+	bool bAllFound = true;
+	for(size_t p = 0; p < numPos; ++p)
 	{
-		spGridFct->inner_dof_indices(chosen, fct, ind);
-		value = DoFRef(*spGridFct, ind[0]);
+		Vertex* chosen = locator.closest_vertex(vMinDistanceSq[p], vGlobPos[p]);
+
+	// get corresponding value (if vertex found, otherwise take 0)
+		vValueOut[p] = 0.0;
+		if(chosen)
+		{
+			spGridFct->inner_dof_indices(chosen, fct, ind);
+			vValueOut[p] = DoFRef(*spGridFct, ind[0]);
+		}
+		else
+			bAllFound = false;
 	}
 
 	// in parallel environment, find global minimal distance and corresponding value
 #ifdef UG_PARALLEL
-	if (minimizeOverAllProcs)
+	if (minimizeOverAllProcs && pcl::NumProcs() > 1)
 	{
-		pcl::MinimalKeyValuePairAcrossAllProcs<number, number, std::less<number> >(minDistanceSq, value);
-
-		// check that a vertex has been found
-		UG_COND_THROW(minDistanceSq == std::numeric_limits<double>::max(),
-		"No vertex of given subsets could be located on any process.");
-
-		return value;
+	//	global minimal distances
+		pcl::ProcessCommunicator com;
+		std::vector<number> vGlobMinDistSq;
+		com.allreduce(vMinDistanceSq, vGlobMinDistSq, PCL_RO_MIN);
+
+	//	the lowest rank with minimal distance provides the value
+		const int rank = pcl::ProcRank();
+		std::vector<int> vRank(numPos), vGlobRank;
+		for(size_t p = 0; p < numPos; ++p)
+		{
+			UG_COND_THROW(vGlobMinDistSq[p] == std::numeric_limits<number>::max(),
+				"No vertex of given subsets could be located on any process.");
+			vRank[p] = (vMinDistanceSq[p] == vGlobMinDistSq[p]) ? rank
+										: std::numeric_limits<int>::max();
+		}
+		com.allreduce(vRank, vGlobRank, PCL_RO_MIN);
+
+		for(size_t p = 0; p < numPos; ++p)
+			if(vGlobRank[p] != rank) vValueOut[p] = 0.0;
+		std::vector<number> vGlobValue;
+		com.allreduce(vValueOut, vGlobValue, PCL_RO_SUM);
+		vValueOut.swap(vGlobValue);
+		return;
 	}
 #endif
 
 	// check that a vertex has been found
-	UG_COND_THROW(!chosen, "No vertex of given subsets could be located.");
+	UG_COND_THROW(!bAllFound, "No vertex of given subsets could be located.");
+}
 
-	return value;
+
+template <typename TGridFunction>
+number EvaluateAtVertex(const MathVector<TGridFunction::dim>& globPos,
+						SmartPtr<TGridFunction> spGridFct,
+						size_t fct,
+						const SubsetGroup& ssGrp,
+						typename TGridFunction::domain_type::subset_handler_type* sh,
+						bool minimizeOverAllProcs = false)
+{
+	std::vector<MathVector<TGridFunction::dim> > vGlobPos(1, globPos);
+	std::vector<number> vValue;
+	EvaluateAtVertices<TGridFunction>(vValue, vGlobPos, spGridFct, fct, ssGrp,
+									  sh, minimizeOverAllProcs);
+	return vValue[0];
 }
 
 
@@ -288,6 +523,56 @@ number EvaluateAtClosestVertexAllProcs
 }
 
 
+/**
+ * Evaluates a function at the vertices closest to a list of positions.
+ * The coordinates of the positions are passed consecutively, i.e.
+ * (x_0, y_0, x_1, y_1, ...) in 2d. The closest vertices are found through a
+ * cached spatial index and, if bAllProcs is true, the values are
+ * communicated for all positions at once.
+ */
+template <typename TGridFunction>
+std::vector<number> EvaluateAtClosestVertices
+(
+	const std::vector<number>& vCoords,
+	SmartPtr<TGridFunction> spGridFct,
+	const char* cmp,
+	const char* subsets,
+	SmartPtr<typename TGridFunction::domain_type::subset_handler_type> sh,
+	bool bAllProcs
+)
+{
+	static const int dim = TGridFunction::dim;
+
+	// get function id of name
+	const size_t fct = spGridFct->fct_id_by_name(cmp);
+
+	// check that function found
+	if (fct > spGridFct->num_fct())
+		UG_THROW("Evaluate: Name of component '"<<cmp<<"' not found.");
+
+	if (vCoords.size() % dim != 0)
+		UG_THROW("Evaluate: Expected a multiple of "<<dim<<" coordinates, but "
+				 "given "<<vCoords.size()<<".");
+
+	// create subset group
+	SubsetGroup ssGrp(sh);
+	if (subsets != NULL)
+		ssGrp.add(TokenizeString(subsets));
+	else
+		ssGrp.add_all();
+
+	std::vector<MathVector<dim> > vPos(vCoords.size() / dim);
+	for(size_t p = 0; p < vPos.size(); ++p)
+		for(int d = 0; d < dim; ++d)
+			vPos[p][d] = vCoords[p*dim + d];
+
+	std::vector<number> vValue;
+	EvaluateAtVertices<TGridFunction>(vValue, vPos, spGridFct, fct, ssGrp,
+									  sh.get(), bAllProcs);
+	return vValue;
+}
+
+
 /**
  * Class exporting the functionality. All functionality that is to
  * be used in scripts or visualization must be registered here.
@@ -324,6 +609,10 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_function("EvaluateAtClosestVertexAllProcs",
 						 &EvaluateAtClosestVertexAllProcs<TFct>,
 						 grp, "Evaluate_at_closest_vertex", "Position#GridFunction#Component#Subsets#SubsetHandler");
+		reg.add_function("EvaluateAtClosestVertices",
+						 &EvaluateAtClosestVertices<TFct>,
+						 grp, "Values", "Coordinates#GridFunction#Component#Subsets#SubsetHandler#AllProcs",
+						 "evaluates at the vertices closest to the given positions (coordinates given consecutively)");
 	}
 }
 
@@ -51,6 +51,8 @@
 #include "lib_disc/operator/linear_operator/element_gauss_seidel/element_gauss_seidel.h"
 #include "lib_disc/operator/linear_operator/element_gauss_seidel/component_gauss_seidel.h"
 #include "lib_disc/operator/linear_operator/uzawa/uzawa.h"
+#include "lib_disc/operator/linear_operator/sum_factorization_operator.h"
+#include "lib_disc/operator/linear_operator/level_operator_interface.h"
 
 using namespace std;
 
@@ -207,6 +209,8 @@ static void DomainAlgebra(Registry& reg, string grp)
 			.add_method("set_rap", &T::set_rap)
 			.add_method("set_smooth_on_surface_rim", &T::set_smooth_on_surface_rim)
 			.add_method("set_comm_comp_overlap", &T::set_comm_comp_overlap)
+			.add_method("set_mixed_precision", &T::set_mixed_precision)
+			.add_method("set_level_operator", &T::set_level_operator, "", "Level Operator")
 			.add_method("ignore_init_for_base_solver", static_cast<void (T::*)(bool)>(&T::ignore_init_for_base_solver), "", "ignore")
 			.add_method("ignore_init_for_base_solver", static_cast<bool (T::*)() const>(&T::ignore_init_for_base_solver), "is ignored", "")
 			.set_construct_as_smart_pointer(true);
@@ -246,6 +250,35 @@ static void DomainAlgebra(Registry& reg, string grp)
 		reg.add_class_to_group(name, "ComponentGaussSeidel", tag);
 	}
 
+	//	SumFactorizationOperator
+	{
+		typedef SumFactorizationOperator<TDomain, TAlgebra> T;
+		typedef ILevelOperator<TAlgebra> TBase;
+		string name = string("SumFactorizationOperator").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Matrix-free operator for tensor product elements")
+		.template add_constructor<void (*)(SmartPtr<ApproximationSpace<TDomain> >, const char*)>("ApproxSpace#Function")
+		.add_method("set_diffusion", &T::set_diffusion, "", "k")
+		.add_method("set_reaction", &T::set_reaction, "", "c")
+		.add_method("add_dirichlet_subsets", &T::add_dirichlet_subsets, "", "Subsets")
+		.add_method("set_level", &T::set_level, "", "GridLevel")
+		.add_method("order", &T::order)
+		.add_method("num_elements", &T::num_elements)
+		.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "SumFactorizationOperator", tag);
+	}
+
+	//	MatrixFreeJacobi
+	{
+		typedef MatrixFreeJacobi<TDomain, TAlgebra> T;
+		typedef ILinearIterator<typename TAlgebra::vector_type> TBase;
+		string name = string("MatrixFreeJacobi").append(suffix);
+		reg.add_class_<T,TBase>(name, grp, "Jacobi smoother for SumFactorizationOperator")
+		.add_constructor()
+		.template add_constructor<void (*)(number)>("damp")
+		.set_construct_as_smart_pointer(true);
+		reg.add_class_to_group(name, "MatrixFreeJacobi", tag);
+	}
+
 	// Uzawa (smoother/iteration)
 	    {
 	        typedef UzawaBase<TDomain, TAlgebra> T;
@@ -269,6 +302,34 @@ static void DomainAlgebra(Registry& reg, string grp)
 
 }
 
+/**
+ * Function called for the registration of Algebra dependent parts.
+ * All Functions and Classes depending on Algebra
+ * are to be placed here when registering. The method is called for all
+ * available Algebra types, based on the current build options.
+ *
+ * @param reg				registry
+ * @param parentGroup		group for sorting of functionality
+ */
+template <typename TAlgebra>
+static void Algebra(Registry& reg, string grp)
+{
+	string suffix = GetAlgebraSuffix<TAlgebra>();
+	string tag = GetAlgebraTag<TAlgebra>();
+
+	grp.append("/MultiGrid");
+
+//	ILevelOperator
+	{
+		typedef ILevelOperator<TAlgebra> T;
+		typedef ILinearOperator<typename TAlgebra::vector_type> TBase;
+		string name = string("ILevelOperator").append(suffix);
+		reg.add_class_<T, TBase>(name, grp)
+			.add_method("set_grid_level", &T::set_grid_level, "", "GridLevel");
+		reg.add_class_to_group(name, "ILevelOperator", tag);
+	}
+}
+
 };
 
 // end group multigrid_bridge
@@ -283,6 +344,7 @@ void RegisterBridge_MultiGrid(Registry& reg, string grp)
 	typedef MultiGrid::Functionality Functionality;
 
 	try{
+		RegisterAlgebraDependent<Functionality>(reg,grp);
 		RegisterDomainAlgebraDependent<Functionality>(reg,grp);
 	}
 	UG_REGISTRY_CATCH_THROW(grp);
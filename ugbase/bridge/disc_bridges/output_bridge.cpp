@@ -268,6 +268,12 @@ static void Dimension(Registry& reg, string grp)
 			.add_method("select_element", static_cast<void (T::*)(SmartPtr<UserData<number, dim> >, const char*)>(&T::select_element))
 			.add_method("select_element", static_cast<void (T::*)(SmartPtr<UserData<MathVector<dim>, dim> >, const char*)>(&T::select_element))
 			.add_method("set_binary", &T::set_binary, "", "bBinary", "should values be printed in binary (base64 encoded way ) or plain ascii")
+			.add_method("set_appended", &T::set_appended, "", "bAppended", "writes binary values raw in an appended section instead of base64 encoded")
+			.add_method("set_compression", &T::set_compression, "", "bCompress", "compresses the appended binary values using zlib")
+			.add_method("set_background_writing", &T::set_background_writing, "", "bBackground", "writes the files in a background thread")
+			.add_method("flush", &T::flush, "", "", "waits until all files queued for background writing are written")
+			.add_method("set_cache_topology", &T::set_cache_topology, "", "bCache", "encodes the grid only once per grid revision")
+			.add_method("set_time_series_mode", &T::set_time_series_mode, "", "bTimeSeries", "enables the appended output with topology caching and background writing")
 			.set_construct_as_smart_pointer(true);
 		reg.add_class_to_group(name, "VTKOutput", tag);
 	}
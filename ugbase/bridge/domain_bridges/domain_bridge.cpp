@@ -139,6 +139,8 @@ static void ScaleDomain(TDomain& dom, number sx, number sy, number sz)
 		for(int i = 0; i < numCoords; ++i)
 			aaPos[*iter][i] *= s[i];
 	}
+
+	dom.positions_changed();
 }
 
 /**
@@ -169,6 +171,8 @@ static void RandomizeDomain(TDomain& dom, number dx, number dy, number dz)
 		for(int i = 0; i < numCoords; ++i)
 			aaPos[*iter][i] += urand(-d[i], d[i]);
 	}
+
+	dom.positions_changed();
 }
 
 
@@ -188,6 +192,8 @@ static void TranslateDomain(TDomain& dom, number tx, number ty, number tz)
 		for(int i = 0; i < numCoords; ++i)
 			aaPos[*iter][i] += t[i];
 	}
+
+	dom.positions_changed();
 }
 
 /**
@@ -233,6 +239,8 @@ static void ProjectVerticesToSphere(TDomain& dom, std::vector<number> center,
 		// set new pos
 		VecScaleAdd(pos, 1.0, Center, s, dir);
 	}
+
+	dom.positions_changed();
 }
 
 /**
@@ -463,6 +471,16 @@ static void Domain(Registry& reg, string grp)
 		static_cast<bool (*)(TDomain&, PartitionMap&, bool)>(&DistributeDomain<TDomain>),
 		grp);
 
+//	Partitioned domain io
+	reg.add_function("SavePartitionedDomain", &SavePartitionedDomain<TDomain>, grp,
+					"", "Domain # Filename",
+					"Writes the local parts of a distributed domain and its "
+					"interfaces to one archive using MPI-IO");
+	reg.add_function("LoadPartitionedDomain", &LoadPartitionedDomain<TDomain>, grp,
+					"", "Domain # Filename",
+					"Loads a domain written by SavePartitionedDomain. Each process "
+					"only reads its own part.");
+
 //	PartitionDomain
 	reg.add_function("PartitionDomain_MetisKWay",
 					 static_cast<bool (*)(TDomain&, PartitionMap&, int, size_t, int, int)>(&PartitionDomain_MetisKWay<TDomain>), grp);
@@ -547,6 +565,8 @@ static void Common(Registry& reg, string grp)
 			.add_method("refinement_projector", &T::refinement_projector,
 						"projector", "")
 			.add_method("geometry3d", &T::geometry3d, "geometry3d", "")
+			.add_method("positions_changed", &T::positions_changed, "", "",
+						"marks the vertex positions as changed (e.g. for moving meshes)")
 			.set_construct_as_smart_pointer(true);
 	}
 
@@ -73,6 +73,8 @@ void TranslateDomain(TDomain& dom, ISelector& sel, const vector3& offset)
 		pos_t& v = aaPos[vrts[i]];
 		VecAdd(v, v, o);
 	}
+
+	dom.positions_changed();
 }
 
 
@@ -100,6 +102,8 @@ void ScaleDomain(TDomain& dom, const vector3& center, const vector3& scale)
 		for(size_t j = 0; j < pos_t::Size; ++j)
 			v[j] = c[j] + (v[j] - c[j]) * s[j];
 	}
+
+	dom.positions_changed();
 }
 
 
@@ -130,6 +134,8 @@ void ScaleDomain(TDomain& dom, ISelector& sel, const vector3& center,
 		for(size_t j = 0; j < pos_t::Size; ++j)
 			v[j] = c[j] + (v[j] - c[j]) * s[j];
 	}
+
+	dom.positions_changed();
 }
 
 template <class TDomain>
@@ -168,6 +174,8 @@ void ScaleDomainSquaredWeighting(TDomain& dom, ISelector& sel, const vector3& ce
             v[j] = c[j] + (v[j] - c[j]) * ((s[j]-1.0)*sqrdWeight + 1.0);
     }
 
+    dom.positions_changed();
+
 }
 
 template <class TDomain>
@@ -205,6 +213,8 @@ void ScaleDomainWeighting(TDomain& dom, ISelector& sel, const vector3& center,
         for(size_t j = 0; j < pos_t::Size; ++j)
             v[j] = c[j] + (v[j] - c[j]) * ((s[j]-1.0)*weight + 1.0);
     }
+
+    dom.positions_changed();
 }
 
 
@@ -244,6 +254,8 @@ void ScaleDomainSqrtWeighting(TDomain& dom, ISelector& sel, const vector3& cente
             v[j] = c[j] + (v[j] - c[j]) * ((s[j]-1.0)*weight + 1.0);
     }
 
+    dom.positions_changed();
+
 }
 
 // end group transform_bridge
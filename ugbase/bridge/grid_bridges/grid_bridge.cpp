@@ -99,6 +99,9 @@ void RegisterGridBridge_Grid(Registry& reg, string parentGroup)
 		.add_method("reserve_edges", &Grid::reserve<Edge>, "", "num")
 		.add_method("reserve_faces", &Grid::reserve<Face>, "", "num")
 		.add_method("reserve_volumes", &Grid::reserve<Volume>, "", "num")
+		.add_method("defragment", &Grid::defragment)
+		.add_method("set_auto_defragment", &Grid::set_auto_defragment, "", "enable")
+		.add_method("auto_defragment", &Grid::auto_defragment)
 		.set_construct_as_smart_pointer(true);
 
 //	MultiGrid
@@ -60,6 +60,15 @@ static void SetShinyCallLoggingMaxFrequency(int maxFreq)
 }
 
 
+static void SetProfilerThrottling_BridgeImpl(int numCalls, number minMicroSeconds)
+{
+#ifdef UG_PROFILER_NATIVE
+	SetProfilerThrottling(numCalls, minMicroSeconds);
+#else
+	UG_LOG("PROFILER THROTTLING ONLY AVAILABLE FOR NATIVE PROFILER! Enable with 'cmake -DPROFILER=Native ..'\n")
+#endif
+}
+
 static void SetFrequency(const std::string& csvFile){
 #ifdef UG_CPU_FREQ
 	FreqAdaptValues::set_freqs(csvFile);
@@ -178,10 +187,18 @@ void RegisterBridge_Profiler(Registry &reg, string parentGroup)
 					 grp,
 	                 "", "filename|save-dialog|endings=[\"txt\"]", "writes txt file with call log");
 
+	reg.add_function("EnableProfilerTimeline", &EnableProfilerTimeline, grp,
+	                 "", "eventsPerThread", "records begin/end events of all profiled zones (Native profiler only)");
+	reg.add_function("WriteProfilerTimeline", &WriteProfilerTimeline, grp,
+	                 "", "filename|save-dialog|endings=[\"json\"]", "writes the recorded timeline of all processes as Chrome trace / Perfetto json file");
+
 	reg.add_function("UpdateProfiler", &UpdateProfiler_BridgeImpl, grp);
 
 	reg.add_function("SetShinyCallLoggingMaxFrequency", &SetShinyCallLoggingMaxFrequency, grp, "", "maxFreq");
 
+	reg.add_function("SetProfilerThrottling", &SetProfilerThrottling_BridgeImpl, grp,
+	                 "", "numCalls#minMicroSeconds", "zones entered numCalls times with an average time below minMicroSeconds are only counted (Native profiler only, numCalls = 0 disables)");
+
 	reg.add_function("SetFrequency", &SetFrequency, grp, "", "CSV-File");
 
 }
@@ -38,61 +38,59 @@
 
 /**	Instances of this class can be used to allocate small objects of the same size
  *	in a highly efficient way.
+ *
+ *	Blocks are cut from large chunks in the order in which they are requested,
+ *	so that objects created one after another also lie next to each other in
+ *	memory. Released blocks are kept in an intrusive free list and are handed
+ *	out again by subsequent calls to allocate. Both operations are O(1).
+ *	Chunks are only returned to the system through release_unused_memory,
+ *	which frees all chunks if no block is currently in use.
+ *
+ *	\note	The allocator is not thread safe.
  */
 class FixedAllocator
 {
 	public:
-		FixedAllocator(std::size_t blockSize, unsigned char numBlocksPerChunk);
+	///	blockSize has to be a multiple of sizeof(void*)
+		FixedAllocator(std::size_t blockSize, std::size_t numBlocksPerChunk);
+		~FixedAllocator();
+
 		void* allocate();
 		void deallocate(void* p);
-		
-	private:
-	/**	The Chunk structure has to be used with great care.
-	 *	A represents is a block of memory, in which it allocates
-	 *	small objects. Be sure that the blockSize used in the calls
-	 *	is the same for all calls to an instance.
-	 */
-		struct Chunk
-		{
-		///	be careful. numBlocks has to be <= 255.
-			void init(std::size_t blockSize, unsigned char numBlocks);
-
-		///	call this method instead of a destructor
-			void free();
-			
-		///	returns 0 if no more blocks are available.
-			void* allocate(std::size_t blockSize);
-		///	deallocates the given pointer.
-		/**	Make sure that p was allocated by the same instance on which you
-		 *	call deallocate.*/
-			void deallocate(void* p, std::size_t blockSize);
-			
-			unsigned char* m_pData;
-			unsigned char m_firstAvailableBlock;
-			unsigned char m_numAvailableBlocks;
-		};
+
+	///	returns the number of blocks which are currently in use
+		std::size_t num_used_blocks() const		{return m_numUsedBlocks;}
+
+	///	frees all chunks if no block is in use. Does nothing otherwise.
+		void release_unused_memory();
 
 	private:
-		inline bool pointer_is_in_chunk(void* p, Chunk* chunk)
-		{
-			return (p >= chunk->m_pData)
-				   && (p < chunk->m_pData + m_blockSize * m_numBlocksPerChunk);
-		}
-		
+	//	copying is not allowed, since the allocator owns its chunks
+		FixedAllocator(const FixedAllocator&);
+		FixedAllocator& operator=(const FixedAllocator&);
+
 	private:
-		typedef std::vector<Chunk> Chunks;
-		
+		typedef std::vector<unsigned char*> Chunks;
+
 	private:
 		std::size_t m_blockSize;
-		unsigned char m_numBlocksPerChunk;
+		std::size_t m_numBlocksPerChunk;
 		Chunks m_chunks;
-		Chunk* m_allocChunk;
-		int m_emptyChunkIndex;
-		int m_deallocChunkIndex;
-		std::size_t m_numFreeBlocks;
+	///	first block in the list of released blocks
+		void* m_pFreeList;
+	///	next never used block in the last chunk
+		unsigned char* m_pNextBlock;
+		std::size_t m_numUnusedBlocksInChunk;
+		std::size_t m_numUsedBlocks;
 };
 
-/**	A singleton that can be used to allocate small objects.*/
+/**	A singleton that can be used to allocate small objects.
+ *	Objects are grouped by their size (rounded up to a multiple of the pointer
+ *	size) and each group is served by its own FixedAllocator.
+ *
+ *	The singleton is never destroyed, so that objects which are released
+ *	during static destruction (e.g. by global grids) can still be deallocated.
+ */
 template <std::size_t maxObjSize = 64, std::size_t maxChunkSize = 4096>
 class SmallObjectAllocator
 {
@@ -105,12 +103,20 @@ class SmallObjectAllocator
 		
 	///	make sure that size exactly specifies the number of bytes of the object to which p points.
 		void deallocate(void* p, std::size_t size);
+
+	///	returns the memory of all object sizes, for which no object is alive.
+		void release_unused_memory();
 		
 	private:
 		SmallObjectAllocator();
+
+		static std::size_t size_class(std::size_t numBytes)
+		{
+			return numBytes == 0 ? 0 : (numBytes - 1) / sizeof(void*);
+		}
 		
 	private:
-		std::vector<FixedAllocator>	m_allocators;
+		std::vector<FixedAllocator*>	m_allocators;
 };
 
 
@@ -126,6 +132,9 @@ class SmallObject
 		static void* operator new(std::size_t size);
 		static void operator delete(void* p, std::size_t size);
 		virtual ~SmallObject()	{}
+
+	///	releases the memory of all object sizes, for which no object is alive.
+		static void release_unused_memory();
 };
 
 ////////////////////////////////
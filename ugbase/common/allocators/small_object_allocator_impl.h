@@ -38,8 +38,10 @@ SmallObjectAllocator<maxObjSize, maxChunkSize>&
 SmallObjectAllocator<maxObjSize, maxChunkSize>::
 inst()
 {
-	static SmallObjectAllocator<maxObjSize, maxChunkSize> alloc;
-	return alloc;
+//	the allocator is intentionally never deleted (see class description)
+	static SmallObjectAllocator<maxObjSize, maxChunkSize>* alloc =
+						new SmallObjectAllocator<maxObjSize, maxChunkSize>;
+	return *alloc;
 }
 
 template <std::size_t maxObjSize, std::size_t maxChunkSize>
@@ -49,7 +51,7 @@ allocate(std::size_t numBytes)
 	if(numBytes > maxObjSize)
 		return new unsigned char[numBytes];
 	
-	return m_allocators[numBytes].allocate();
+	return m_allocators[size_class(numBytes)]->allocate();
 }
 
 template <std::size_t maxObjSize, std::size_t maxChunkSize>
@@ -59,21 +61,31 @@ deallocate(void* p, std::size_t size)
 	if(size > maxObjSize)
 		delete[] static_cast<unsigned char*>(p);
 	else{
-		m_allocators[size].deallocate(p);
+		m_allocators[size_class(size)]->deallocate(p);
 	}
 }
+
+template <std::size_t maxObjSize, std::size_t maxChunkSize>
+void SmallObjectAllocator<maxObjSize, maxChunkSize>::
+release_unused_memory()
+{
+	for(std::size_t i = 0; i < m_allocators.size(); ++i)
+		m_allocators[i]->release_unused_memory();
+}
 		
 template <std::size_t maxObjSize, std::size_t maxChunkSize>
 SmallObjectAllocator<maxObjSize, maxChunkSize>::
 SmallObjectAllocator()
 {
-//	initialize the allocators
-	for(std::size_t i = 0; i <= maxObjSize; ++i){
-		std::size_t maxNumBlocks = maxChunkSize / maxObjSize;
-		if(maxNumBlocks > 255)
-			maxNumBlocks = 255;
-		m_allocators.push_back(FixedAllocator(maxObjSize,
-									static_cast<unsigned char>(maxNumBlocks)));
+//	initialize one allocator for each size class. Chunks are only created
+//	on the first allocation.
+	const std::size_t numClasses = size_class(maxObjSize) + 1;
+	for(std::size_t i = 0; i < numClasses; ++i){
+		const std::size_t blockSize = (i + 1) * sizeof(void*);
+		std::size_t numBlocks = maxChunkSize / blockSize;
+		if(numBlocks < 1)
+			numBlocks = 1;
+		m_allocators.push_back(new FixedAllocator(blockSize, numBlocks));
 	}
 }
 
@@ -92,4 +104,11 @@ operator delete(void* p, std::size_t size)
 	SmallObjectAllocator<maxObjSize, maxChunkSize>::inst().deallocate(p, size);
 }
 
+template <std::size_t maxObjSize, std::size_t maxChunkSize>
+void SmallObject<maxObjSize, maxChunkSize>::
+release_unused_memory()
+{
+	SmallObjectAllocator<maxObjSize, maxChunkSize>::inst().release_unused_memory();
+}
+
 #endif
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include "native_profiler.h"
+#include "src/ShinyManager.h"
+
+#ifdef _MSC_VER
+	#define NATIVE_PROFILER_FETCH_AND_ADD(ptr, val)	\
+		_InterlockedExchangeAdd((volatile long*)(ptr), (val))
+	#define NATIVE_PROFILER_CAS(ptr, oldVal, newVal)	\
+		(_InterlockedCompareExchangePointer((void* volatile*)(ptr), (newVal), (oldVal)) == (oldVal))
+	#define NATIVE_PROFILER_MEMORY_BARRIER()	_mm_mfence()
+#else
+	#define NATIVE_PROFILER_FETCH_AND_ADD(ptr, val)	__sync_fetch_and_add(ptr, val)
+	#define NATIVE_PROFILER_CAS(ptr, oldVal, newVal)	\
+		__sync_bool_compare_and_swap(ptr, oldVal, newVal)
+	#define NATIVE_PROFILER_MEMORY_BARRIER()	__sync_synchronize()
+#endif
+
+namespace ug{
+
+UG_PROFILER_THREAD_LOCAL NativeThreadProfile* g_pNativeThreadProfile = NULL;
+uint64_t g_nativeProfilerThrottleCalls = 100000;
+bool g_nativeProfilerTimeline = false;
+
+////////////////////////////////////////////////////////////////////////////////
+//	globals which are shared by all threads
+static NativeThreadProfile* volatile s_threadList = NULL;
+static long s_numThreads = 0;
+
+static size_t s_timelineSize = 1 << 20;
+static native_tick_t s_timelineOrigin = 0;
+
+static double s_throttleMicroSeconds = 10;
+static double s_throttleTicks = 0;
+
+//	ticks of the time stamp counter per Shiny tick and the time stamps used
+//	to compute the ratio
+static double s_tscPerShinyTick = 1.0;
+static native_tick_t s_tsc0 = 0;
+static Shiny::tick_t s_shiny0 = 0;
+
+static void CalibrateTicks()
+{
+#ifdef UG_NATIVE_PROFILER_RDTSC
+//	busy wait for 2ms to get an initial estimate. The ratio is refined on
+//	every call to NativeProfilerPublish.
+	Shiny::tick_t shiny, shinyStop;
+	Shiny::GetTicks(&s_shiny0);
+	s_tsc0 = NativeProfilerTicks();
+	shinyStop = s_shiny0 + Shiny::GetTickFreq() / 500;
+	do{
+		Shiny::GetTicks(&shiny);
+	}while(shiny < shinyStop);
+	s_tscPerShinyTick = (double)(NativeProfilerTicks() - s_tsc0)
+						/ (double)(shiny - s_shiny0);
+#endif
+	s_throttleTicks = s_throttleMicroSeconds * 1e-6
+						* (double)Shiny::GetTickFreq() * s_tscPerShinyTick;
+}
+
+static void RefineCalibration()
+{
+#ifdef UG_NATIVE_PROFILER_RDTSC
+	Shiny::tick_t shiny;
+	Shiny::GetTicks(&shiny);
+	const native_tick_t tsc = NativeProfilerTicks();
+
+//	only use intervals of at least 100ms
+	if(shiny - s_shiny0 >= Shiny::GetTickFreq() / 10)
+		s_tscPerShinyTick = (double)(tsc - s_tsc0) / (double)(shiny - s_shiny0);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	NativeThreadProfile
+NativeThreadProfile* NativeThreadProfile::create()
+{
+	NativeThreadProfile* tp =
+			static_cast<NativeThreadProfile*>(calloc(1, sizeof(NativeThreadProfile)));
+
+	tp->index = (int)NATIVE_PROFILER_FETCH_AND_ADD(&s_numThreads, 1);
+	if(tp->index == 0)
+		CalibrateTicks();
+
+	snprintf(tp->name, sizeof(tp->name), "thread %d", tp->index);
+	tp->zone._state = Shiny::ProfileZone::STATE_HIDDEN;
+	tp->zone.name = tp->name;
+	tp->root.zone = &tp->zone;
+	tp->root.entryCount = 1;
+	tp->cur = &tp->root;
+	tp->lastTick = NativeProfilerTicks();
+
+//	push the profile to the global list
+	NativeThreadProfile* head;
+	do{
+		head = s_threadList;
+		tp->next = head;
+	}while(!NATIVE_PROFILER_CAS(&s_threadList, head, tp));
+
+	g_pNativeThreadProfile = tp;
+	return tp;
+}
+
+NativeProfileNode* NativeThreadProfile::
+lookup_child(NativeProfileNode* parent, Shiny::ProfileZone* zone)
+{
+	for(NativeProfileNode* n = parent->firstChild; n; n = n->nextSibling)
+		if(n->zone == zone)
+			return n;
+
+	if(poolBegin == poolEnd){
+		poolBegin = static_cast<NativeProfileNode*>(
+				calloc(NATIVE_PROFILER_POOL_SIZE, sizeof(NativeProfileNode)));
+		poolEnd = poolBegin + NATIVE_PROFILER_POOL_SIZE;
+	}
+
+	NativeProfileNode* node = poolBegin++;
+	node->zone = zone;
+	node->parent = parent;
+
+//	the node has to be complete before other threads can see it
+	NATIVE_PROFILER_MEMORY_BARRIER();
+	if(parent->lastChild)
+		parent->lastChild->nextSibling = node;
+	else
+		parent->firstChild = node;
+	parent->lastChild = node;
+	return node;
+}
+
+void NativeThreadProfile::check_throttling(NativeProfileNode* node)
+{
+	node->throttleChecked = true;
+	if((double)node->totalTicks < s_throttleTicks * (double)node->entryCount)
+		node->throttled = true;
+}
+
+void NativeThreadProfile::create_timeline()
+{
+	events = static_cast<NativeTimelineEvent*>(
+				malloc(s_timelineSize * sizeof(NativeTimelineEvent)));
+	eventMask = s_timelineSize - 1;
+	numEvents = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	publishing
+static void PublishChildren(NativeProfileNode* node,
+                            Shiny::ProfileNode* shinyNode, double tscPerTick)
+{
+	Shiny::ProfileManager& pm = Shiny::ProfileManager::instance;
+
+	for(NativeProfileNode* c = node->firstChild; c; c = c->nextSibling)
+	{
+		if(!c->shinyNode || c->shinyNode->parent != shinyNode){
+			pm._curNode = shinyNode;
+			c->shinyNode = pm._lookupNode(&c->shinyCache, c->zone);
+		}
+
+	//	transfer the differences since the last call
+		const uint64_t entries = c->entryCount;
+		const native_tick_t ticks = c->selfTicks;
+
+		const Shiny::tick_t shinyTicks =
+				(Shiny::tick_t)((double)(ticks - c->publishedTicks) / tscPerTick);
+		c->shinyNode->_last.entryCount += (uint32_t)(entries - c->publishedEntries);
+		c->shinyNode->_last.selfTicks += shinyTicks;
+
+		c->publishedEntries = entries;
+		c->publishedTicks += (native_tick_t)((double)shinyTicks * tscPerTick);
+
+		PublishChildren(c, c->shinyNode, tscPerTick);
+	}
+}
+
+void NativeProfilerPublish()
+{
+	Shiny::ProfileManager& pm = Shiny::ProfileManager::instance;
+	pm.preLoad();
+
+//	account the running zone of the calling thread
+	NativeThreadProfile* self = g_pNativeThreadProfile;
+	if(self){
+		const native_tick_t now = NativeProfilerTicks();
+		self->cur->selfTicks += now - self->lastTick;
+		self->lastTick = now;
+	}
+
+	RefineCalibration();
+	const double tscPerTick = s_tscPerShinyTick;
+
+	for(NativeThreadProfile* tp = s_threadList; tp; tp = tp->next)
+	{
+		Shiny::ProfileNode* shinyRoot = &pm.rootNode;
+
+	//	the time outside of all zones is only reported for the main thread.
+	//	For all other threads it mostly consists of idle time.
+		if(tp->index == 0){
+			const Shiny::tick_t shinyTicks = (Shiny::tick_t)
+				((double)(tp->root.selfTicks - tp->root.publishedTicks) / tscPerTick);
+			shinyRoot->_last.selfTicks += shinyTicks;
+			tp->root.publishedTicks += (native_tick_t)((double)shinyTicks * tscPerTick);
+		}
+		else{
+			if(!tp->root.shinyNode){
+				pm._curNode = shinyRoot;
+				tp->root.shinyNode = pm._lookupNode(&tp->root.shinyCache, &tp->zone);
+			}
+			shinyRoot = tp->root.shinyNode;
+			shinyRoot->_last.entryCount += (uint32_t)(1 - tp->root.publishedEntries);
+			tp->root.publishedEntries = 1;
+		}
+
+		PublishChildren(&tp->root, shinyRoot, tscPerTick);
+	}
+
+//	the Shiny timer itself is not running. Make sure that update() does not
+//	add any time to the root node.
+	pm._curNode = &pm.rootNode;
+	Shiny::GetTicks(&pm._lastTick);
+}
+
+void SetProfilerThrottling(size_t numCalls, double minMicroSeconds)
+{
+	g_nativeProfilerThrottleCalls = numCalls;
+	s_throttleMicroSeconds = minMicroSeconds;
+	s_throttleTicks = s_throttleMicroSeconds * 1e-6
+						* (double)Shiny::GetTickFreq() * s_tscPerShinyTick;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//	timeline
+void NativeProfilerEnableTimeline(size_t eventsPerThread)
+{
+	size_t size = 1;
+	while(size < eventsPerThread)
+		size *= 2;
+	s_timelineSize = size;
+
+//	the first thread profile calibrates the ticks
+	if(!g_pNativeThreadProfile)
+		NativeThreadProfile::create();
+	s_timelineOrigin = NativeProfilerTicks();
+	g_nativeProfilerTimeline = true;
+}
+
+static void WriteJSONString(std::ostream& out, const char* str)
+{
+	out << '"';
+	if(str){
+		for(; *str; ++str){
+			const unsigned char c = *str;
+			if(c == '"' || c == '\\') out << '\\' << c;
+			else if(c < 0x20) out << ' ';
+			else out << c;
+		}
+	}
+	out << '"';
+}
+
+void NativeProfilerWriteTimeline(std::ostream& out, int pid)
+{
+	RefineCalibration();
+	const double microSecsPerTick =
+			1e6 / ((double)Shiny::GetTickFreq() * s_tscPerShinyTick);
+
+	const std::ios::fmtflags flags = out.flags();
+	const std::streamsize precision = out.precision();
+	out.setf(std::ios::fixed, std::ios::floatfield);
+	out.precision(3);
+
+	out << ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+		<< ",\"tid\":0,\"args\":{\"name\":\"rank " << pid << "\"}}";
+
+	for(NativeThreadProfile* tp = s_threadList; tp; tp = tp->next)
+	{
+		out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+			<< ",\"tid\":" << tp->index << ",\"args\":{\"name\":";
+		WriteJSONString(out, tp->name);
+		out << "}}";
+
+		if(!tp->events) continue;
+
+	//	only the latest events are contained in the ring buffer. End events
+	//	whose begin event has been overwritten are skipped.
+		uint64_t first = 0;
+		if(tp->numEvents > tp->eventMask + 1)
+			first = tp->numEvents - (tp->eventMask + 1);
+
+		int depth = 0;
+		for(uint64_t i = first; i < tp->numEvents; ++i)
+		{
+			const NativeTimelineEvent& e = tp->events[i & tp->eventMask];
+			if(e.begin) ++depth;
+			else if(depth == 0) continue;
+			else --depth;
+
+			const double ts = (e.tick > s_timelineOrigin) ?
+					(double)(e.tick - s_timelineOrigin) * microSecsPerTick : 0;
+
+			out << ",\n{\"name\":";
+			WriteJSONString(out, e.zone->name);
+			out << ",\"cat\":";
+			WriteJSONString(out, e.zone->groups ? e.zone->groups : "ug");
+			out << ",\"ph\":\"" << (e.begin ? 'B' : 'E') << "\",\"ts\":" << ts
+				<< ",\"pid\":" << pid << ",\"tid\":" << tp->index << "}";
+		}
+	}
+
+	out.flags(flags);
+	out.precision(precision);
+}
+
+}// end of namespace
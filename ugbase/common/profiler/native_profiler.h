@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__PROFILER__NATIVE_PROFILER__
+#define __H__UG__COMMON__PROFILER__NATIVE_PROFILER__
+
+#include <cstddef>
+#include <ostream>
+#include "src/ShinyZone.h"
+#include "src/ShinyNode.h"
+#include "src/ShinyTools.h"
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#define UG_NATIVE_PROFILER_RDTSC
+	#define UG_PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+	#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		#include <x86intrin.h>
+		#define UG_NATIVE_PROFILER_RDTSC
+	#endif
+	#define UG_PROFILER_THREAD_LOCAL __thread
+#endif
+
+namespace ug{
+
+///	number of entries of the per-thread (parent, zone) -> node lookup cache
+const size_t NATIVE_PROFILER_CACHE_SIZE = 1024;
+
+///	number of nodes allocated at once for a thread
+const size_t NATIVE_PROFILER_POOL_SIZE = 256;
+
+typedef Shiny::tick_t native_tick_t;
+
+///	returns the current value of the time stamp counter
+/**	On x86 the time stamp counter is read directly (rdtsc). On all other
+ * platforms the ticks of the Shiny timer are used instead.*/
+inline native_tick_t NativeProfilerTicks()
+{
+#ifdef UG_NATIVE_PROFILER_RDTSC
+	return __rdtsc();
+#else
+	native_tick_t t;
+	Shiny::GetTicks(&t);
+	return t;
+#endif
+}
+
+///	A node in the zone tree of one thread
+/**	All counters are written by the owning thread only. They are read by
+ * NativeProfilerPublish without locks, which only needs snapshots. The
+ * members below 'publishedEntries' are only accessed during publishing.*/
+struct NativeProfileNode
+{
+	Shiny::ProfileZone* zone;
+	NativeProfileNode* parent;
+	NativeProfileNode* firstChild;
+	NativeProfileNode* lastChild;
+	NativeProfileNode* nextSibling;
+
+	uint64_t entryCount;
+	native_tick_t selfTicks;
+	native_tick_t totalTicks;
+	native_tick_t entryTick;
+	bool throttled;
+	bool throttleChecked;
+
+	uint64_t publishedEntries;
+	native_tick_t publishedTicks;
+	Shiny::ProfileNode* shinyNode;
+	Shiny::ProfileNodeCache shinyCache;
+};
+
+///	A begin or end event of a zone in the timeline of a thread
+struct NativeTimelineEvent
+{
+	Shiny::ProfileZone* zone;
+	native_tick_t tick;
+	bool begin;
+};
+
+///	Profiling state of a single thread
+/**	The state is created on the first profiled zone of a thread and is
+ * registered in a global lock-free list. It is never released, so that
+ * results of finished threads remain available for reporting.*/
+struct NativeThreadProfile
+{
+	NativeProfileNode root;
+	NativeProfileNode* cur;
+	native_tick_t lastTick;
+
+	NativeProfileNode* cache[NATIVE_PROFILER_CACHE_SIZE];
+	NativeProfileNode* poolBegin;
+	NativeProfileNode* poolEnd;
+
+	int index;
+	NativeThreadProfile* next;
+
+	char name[32];
+	Shiny::ProfileZone zone;
+
+///	ring buffer of timeline events (allocated on the first event)
+	NativeTimelineEvent* events;
+	size_t eventMask;
+	uint64_t numEvents;
+
+///	creates and registers the profile of the calling thread
+	static NativeThreadProfile* create();
+
+///	returns the child of parent for the given zone. Creates it if necessary.
+	NativeProfileNode* lookup_child(NativeProfileNode* parent,
+	                                Shiny::ProfileZone* zone);
+
+///	called once, after g_nativeProfilerThrottleCalls timed entries of a node
+	void check_throttling(NativeProfileNode* node);
+
+///	allocates the ring buffer for timeline events
+	void create_timeline();
+
+///	appends an event to the timeline. Older events are overwritten.
+	inline void record_event(Shiny::ProfileZone* z, native_tick_t t, bool b)
+	{
+		if(!events) create_timeline();
+		NativeTimelineEvent& e = events[numEvents++ & eventMask];
+		e.zone = z;
+		e.tick = t;
+		e.begin = b;
+	}
+};
+
+///	profile of the calling thread (NULL if the thread did not profile yet)
+extern UG_PROFILER_THREAD_LOCAL NativeThreadProfile* g_pNativeThreadProfile;
+
+///	number of timed calls after which a zone is checked for throttling
+extern uint64_t g_nativeProfilerThrottleCalls;
+
+///	true if begin and end events are recorded in the timeline
+extern bool g_nativeProfilerTimeline;
+
+///	Enters the given zone in the zone tree of the calling thread
+/**	Zones whose average inclusive time fell below the throttling limit are
+ * only counted. Their time is attributed to the nearest enclosing zone,
+ * that is still timed.*/
+inline void NativeProfilerBegin(Shiny::ProfileZone* zone)
+{
+	NativeThreadProfile* tp = g_pNativeThreadProfile;
+	if(!tp) tp = NativeThreadProfile::create();
+
+	NativeProfileNode* parent = tp->cur;
+	const size_t h = (((size_t)parent >> 4) ^ ((size_t)zone >> 3))
+						& (NATIVE_PROFILER_CACHE_SIZE - 1);
+	NativeProfileNode* node = tp->cache[h];
+	if(!node || node->parent != parent || node->zone != zone)
+		tp->cache[h] = node = tp->lookup_child(parent, zone);
+
+	++node->entryCount;
+	if(!node->throttled){
+	//	the time since the last stamp belongs to the nearest timed zone
+		NativeProfileNode* timed = parent;
+		while(timed->throttled)
+			timed = timed->parent;
+
+		const native_tick_t now = NativeProfilerTicks();
+		timed->selfTicks += now - tp->lastTick;
+		tp->lastTick = now;
+		node->entryTick = now;
+		if(g_nativeProfilerTimeline)
+			tp->record_event(zone, now, true);
+	}
+	tp->cur = node;
+}
+
+///	Leaves the current zone of the calling thread
+inline void NativeProfilerEnd()
+{
+	NativeThreadProfile* tp = g_pNativeThreadProfile;
+	NativeProfileNode* node = tp->cur;
+	if(!node->throttled){
+		const native_tick_t now = NativeProfilerTicks();
+		node->selfTicks += now - tp->lastTick;
+		node->totalTicks += now - node->entryTick;
+		tp->lastTick = now;
+		if(g_nativeProfilerTimeline)
+			tp->record_event(node->zone, now, false);
+		if(!node->throttleChecked && g_nativeProfilerThrottleCalls > 0
+			&& node->entryCount >= g_nativeProfilerThrottleCalls)
+			tp->check_throttling(node);
+	}
+	tp->cur = node->parent;
+}
+
+///	Records a zone in the timeline only, without adding it to the zone tree
+/**	Used for frequent events like communication, which should show up in the
+ * timeline even if they are not profiled otherwise.*/
+class NativeTimelineScope
+{
+	public:
+		NativeTimelineScope(Shiny::ProfileZone* zone) : m_zone(NULL)
+		{
+			if(g_nativeProfilerTimeline){
+				m_zone = zone;
+				record(true);
+			}
+		}
+
+		~NativeTimelineScope()
+		{
+			if(m_zone)
+				record(false);
+		}
+
+	private:
+		void record(bool begin)
+		{
+			NativeThreadProfile* tp = g_pNativeThreadProfile;
+			if(!tp) tp = NativeThreadProfile::create();
+			tp->record_event(m_zone, NativeProfilerTicks(), begin);
+		}
+
+		Shiny::ProfileZone* m_zone;
+};
+
+///	Transfers the zone trees of all threads to the Shiny profile tree
+/**	Afterwards the reporting functions of UGProfileNode (call trees, sorted
+ * tables, pdxml output) include the data of all threads. The zones of the
+ * first profiled thread are placed directly below the root node, the zones
+ * of every other thread below a node 'thread <n>'.
+ *
+ * Recording threads are not stopped, so zones that are currently running
+ * will be included on the next call. Must not be called concurrently.*/
+void NativeProfilerPublish();
+
+///	Sets the parameters of the overhead limitation
+/**	A zone which has been entered 'numCalls' times with an average inclusive
+ * time below 'minMicroSeconds' is no longer timed, but only counted. Its
+ * time is attributed to the nearest enclosing zone, that is still timed.
+ * Each zone is checked only once, so zones that have already been checked
+ * keep their state. Pass numCalls = 0 to time all zones.*/
+void SetProfilerThrottling(size_t numCalls, double minMicroSeconds);
+
+///	Starts recording begin and end events of all zones
+/**	Each thread keeps the latest 'eventsPerThread' events (rounded up to a
+ * power of 2) in a ring buffer. The size only applies to threads which did
+ * not record an event yet. Timestamps are relative to this call.*/
+void NativeProfilerEnableTimeline(size_t eventsPerThread);
+
+///	Writes the timeline events of all threads as Chrome trace events
+/**	Every event is written with a leading comma, so that the output of
+ * several processes can be concatenated into the 'traceEvents' array of a
+ * Chrome trace / Perfetto json file. Should only be called while no other
+ * thread is profiling.
+ * \param pid	process id used in the trace (e.g. the rank)*/
+void NativeProfilerWriteTimeline(std::ostream& out, int pid);
+
+}// end of namespace
+
+#endif /* __H__UG__COMMON__PROFILER__NATIVE_PROFILER__ */
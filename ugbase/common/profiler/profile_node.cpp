@@ -65,6 +65,9 @@ namespace ug
 
 void ProfilerUpdate()
 {
+#ifdef UG_PROFILER_NATIVE
+	NativeProfilerPublish();
+#endif
 	Shiny::ProfileManager::instance.update(1.0);
 	UpdateTotalMem();
 }
@@ -578,6 +581,9 @@ void ProfileTestFunction2()
 
 void UGProfileNode::CheckForTooSmallNodes()
 {
+#ifdef UG_PROFILER_NATIVE
+	NativeProfilerPublish();
+#endif
 	Shiny::ProfileManager::instance.update(1.0); // WE call with damping = 1.0
 	const UGProfileNode *pnRoot = UGProfileNode::get_root();
 
@@ -587,6 +593,10 @@ void UGProfileNode::CheckForTooSmallNodes()
 		ProfileTestFunction1();
 		ProfileTestFunction2();
 	}
+#ifdef UG_PROFILER_NATIVE
+//	make the nodes of the test functions available
+	NativeProfilerPublish();
+#endif
 
 	const UGProfileNode *ptf1 = GetProfileNode("ProfileTestFunction1");
 
@@ -849,6 +859,65 @@ void WriteProfileDataXML(const char *filename, int procId)
 	
 }
 
+void EnableProfilerTimeline(size_t eventsPerThread)
+{
+#ifdef UG_PROFILER_NATIVE
+#ifdef UG_PARALLEL
+//	start the timelines of all processes at roughly the same time
+	pcl::SynchronizeProcesses();
+#endif
+	NativeProfilerEnableTimeline(eventsPerThread);
+#else
+	UG_LOG("Did NOT enable the profiler timeline since it is only available for the native profiler (enable with cmake -DPROFILER=Native ..)\n");
+#endif
+}
+
+void WriteProfilerTimeline(const char *filename)
+{
+#ifdef UG_PROFILER_NATIVE
+	stringstream ss;
+	NativeProfilerWriteTimeline(ss, pcl::ProcRank());
+
+//	every chunk starts with a comma, which is skipped for the first one
+	string content = ss.str();
+	if(pcl::ProcRank() == 0)
+		content = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" + content.substr(1);
+	if(pcl::ProcRank() == pcl::NumProcs() - 1)
+		content += "\n]}\n";
+
+#ifdef UG_PARALLEL
+//	each process writes its chunk directly at its offset in the file
+	pcl::ProcessCommunicator pc;
+	MPI_Comm comm = pc.get_mpi_communicator();
+
+	long long mySize = (long long)content.size(), myOffset = 0;
+	MPI_Exscan(&mySize, &myOffset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+	if(pcl::ProcRank() == 0) myOffset = 0;
+
+	MPI_File fh;
+	if(MPI_File_open(comm, const_cast<char*>(filename),
+	                 MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh))
+		UG_THROW("WriteProfilerTimeline: Could not open " << filename);
+	MPI_File_set_size(fh, 0);
+
+	MPI_Status status;
+	const int maxChunk = 1 << 30;
+	for(size_t pos = 0; pos < content.size(); pos += maxChunk)
+	{
+		const int n = (int)min(content.size() - pos, (size_t)maxChunk);
+		MPI_File_write_at(fh, (MPI_Offset)(myOffset + pos),
+		                  const_cast<char*>(content.data() + pos), n, MPI_BYTE, &status);
+	}
+	MPI_File_close(&fh);
+#else
+	fstream f(filename, ios::out);
+	f << content;
+#endif
+#else
+	UG_LOG("Did NOT write the profiler timeline since it is only available for the native profiler (enable with cmake -DPROFILER=Native ..)\n");
+#endif
+}
+
 const UGProfileNode *GetProfileNode(const char *name, const UGProfileNode *node)
 {
 	ProfilerUpdate();
@@ -1067,6 +1136,8 @@ void UGProfileNode::CheckForTooSmallNodes()
 
 void WriteCallLog(const char *filename) {}
 void WriteCallLog(const char *filename, int procId) {}
+void EnableProfilerTimeline(size_t eventsPerThread) {}
+void WriteProfilerTimeline(const char *filename) {}
 #endif // SHINY
 
 } // namespace ug
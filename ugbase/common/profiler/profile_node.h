@@ -238,6 +238,17 @@ void WriteProfileDataXML(const char *filename, int procId);
 void WriteCallLog(const char *filename);
 void WriteCallLog(const char *filename, int procId);
 
+///	Starts recording a timeline of all profiled zones (native profiler only)
+/**	Has to be called by all processes. Each thread keeps the latest
+ * 'eventsPerThread' begin/end events.*/
+void EnableProfilerTimeline(size_t eventsPerThread);
+
+///	Writes the timelines of all processes and threads to a Chrome trace file
+/**	Has to be called by all processes. Every process writes its own part of
+ * the file with MPI-IO, so no process has to hold the data of the others.
+ * The json file can be viewed with chrome://tracing or ui.perfetto.dev.*/
+void WriteProfilerTimeline(const char *filename);
+
 }
 
 
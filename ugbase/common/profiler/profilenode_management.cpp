@@ -34,6 +34,34 @@
 
 #ifdef UG_PROFILER
 
+#ifdef UG_PROFILER_NATIVE
+//	the global stack can't be shared between threads. Each thread thus keeps
+//	its own chain of active nodes.
+static UG_PROFILER_THREAD_LOCAL AutoProfileNode* s_latestNode = NULL;
+
+void ProfileNodeManager::
+add(AutoProfileNode* node)
+{
+	node->m_pPrev = s_latestNode;
+	s_latestNode = node;
+}
+
+void ProfileNodeManager::
+release_latest()
+{
+	if(s_latestNode){
+		AutoProfileNode* node = s_latestNode;
+		s_latestNode = node->m_pPrev;
+		node->release();
+	}
+}
+
+AutoProfileNode* ProfileNodeManager::
+latest()
+{
+	return s_latestNode;
+}
+#else
 void ProfileNodeManager::
 add(AutoProfileNode* node)
 {
@@ -50,6 +78,15 @@ release_latest()
 	}
 }
 
+AutoProfileNode* ProfileNodeManager::
+latest()
+{
+	if(inst().m_nodes.empty())
+		return NULL;
+	return inst().m_nodes.top();
+}
+#endif
+
 ProfileNodeManager::
 ProfileNodeManager()	{}
 
@@ -87,7 +124,10 @@ AutoProfileNode::AutoProfileNode(SCOREP_User_RegionHandle handle) : m_bActive(tr
 void AutoProfileNode::release()
 {
 	if(m_bActive){
-#ifdef UG_PROFILER_SHINY
+#if defined(UG_PROFILER_NATIVE)
+		ug::NativeProfilerEnd();
+		PROFILE_LOG_CALL_END();
+#elif defined(UG_PROFILER_SHINY)
 		Shiny::ProfileManager::instance._endCurNode();
 		PROFILE_LOG_CALL_END();
 #endif
@@ -44,6 +44,7 @@ class ProfileNodeManager
 	public:
 		static void add(AutoProfileNode* node);
 		static void release_latest();
+		static AutoProfileNode* latest();
 
 	private:
 		ProfileNodeManager();
@@ -77,6 +78,10 @@ class AutoProfileNode
 
 	private:
 		bool m_bActive;
+#ifdef UG_PROFILER_NATIVE
+	//	the native profiler keeps a separate chain of nodes for each thread
+		AutoProfileNode* m_pPrev;
+#endif
 #if defined(UG_PROFILER_SCALASCA) || defined(UG_PROFILER_VAMPIR)
 		const char* m_pName;
 #endif
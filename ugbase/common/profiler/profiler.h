@@ -64,6 +64,24 @@
 	#include "src/ShinyNode.h"
 
 
+#ifdef UG_PROFILER_NATIVE
+//	the native profiler records into per-thread zone trees and uses the
+//	shiny profile tree for reporting only (see native_profiler.h)
+	#include "native_profiler.h"
+
+	/**	Helper makro used in PROFILE_BEGIN and PROFILE_FUNC.*/
+	#define PROFILE_BEGIN_AUTO_END(id, name, group, file, line)			\
+															\
+		CPU_FREQ_BEGIN_AUTO_END(id, file, line); 			\
+		AutoProfileNode	id;									\
+		static Shiny::ProfileZone __ShinyZone_##id = {		\
+			NULL, Shiny::ProfileZone::STATE_HIDDEN, name, 	\
+			group, file, line,								\
+			{ { 0, 0 }, { 0, 0 }, { 0, 0 } }				\
+		};													\
+		ug::NativeProfilerBegin(&__ShinyZone_##id);			\
+		PROFILE_LOG_CALL_START()
+#else
 	/**	Helper makro used in PROFILE_BEGIN and PROFILE_FUNC.*/
 	#define PROFILE_BEGIN_AUTO_END(id, name, group, file, line)			\
 															\
@@ -81,6 +99,7 @@
 			Shiny::ProfileManager::instance._beginNode(&cache, &__ShinyZone_##id);\
 		}\
 		PROFILE_LOG_CALL_START()
+#endif
 
 
 	/**	Creates a new profile-environment with the given name.
@@ -106,8 +125,20 @@
 			PROFILE_BEGIN_AUTO_END(__ShinyFunction, __FUNCTION__, group, __FILE__, __LINE__)
 
 	/**	Performs update on the profiler (call before output)*/
+#ifdef UG_PROFILER_NATIVE
+	namespace ug{
+		inline void NativeProfilerUpdate(float damping = 0.9f)
+		{
+			NativeProfilerPublish();
+			Shiny::ProfileManager::instance.update(damping);
+		}
+	}
+	#define PROFILER_UPDATE									\
+		ug::NativeProfilerUpdate
+#else
 	#define PROFILER_UPDATE									\
 		Shiny::ProfileManager::instance.update
+#endif
 
 	/**	Outputs the profile-times*/
 	#define PROFILER_OUTPUT									\
@@ -237,7 +268,7 @@
 #endif // UG_PROFILER_SCOREP
 
 #define PROFILE_END_(name) \
-			assert(&(apn_##name) == ProfileNodeManager::inst().m_nodes.top());	\
+			assert(&(apn_##name) == ProfileNodeManager::latest());	\
 			struct apn_already_ended_##name { } ; \
 			PROFILE_END();
 
@@ -64,7 +64,10 @@ public:
 
 	inline void beginNode()
 	{
-#ifdef UG_PROFILER_SHINY
+#if defined(UG_PROFILER_NATIVE)
+		ug::NativeProfilerBegin(&profileInformation);
+		PROFILE_LOG_CALL_START();
+#elif defined(UG_PROFILER_SHINY)
 		Shiny::ProfileManager::instance._beginNode(&profilerCache, &profileInformation);
 		PROFILE_LOG_CALL_START();
 #endif
@@ -82,7 +85,10 @@ public:
 
 	inline void endNode()
 	{
-#ifdef UG_PROFILER_SHINY
+#if defined(UG_PROFILER_NATIVE)
+		ug::NativeProfilerEnd();
+		PROFILE_LOG_CALL_END();
+#elif defined(UG_PROFILER_SHINY)
 		Shiny::ProfileManager::instance._endCurNode();
 		PROFILE_LOG_CALL_END();
 #endif
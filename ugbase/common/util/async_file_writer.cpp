@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <fstream>
+#include "common/util/async_file_writer.h"
+#include "common/log.h"
+#include "common/error.h"
+#include "common/profiler/profiler.h"
+
+namespace ug {
+
+void AsyncFileWriter::write_file(const std::string& filename, const std::string& content)
+{
+	std::ofstream out(filename.c_str(), std::ios_base::out | std::ios_base::trunc
+										| std::ios_base::binary);
+	if(!out.is_open())
+		UG_THROW("Could not open output file: " << filename);
+	out.write(content.data(), content.size());
+	if(!out.good())
+		UG_THROW("Can not write to output file: " << filename);
+}
+
+#ifdef UG_POSIX
+
+AsyncFileWriter::AsyncFileWriter(size_t maxPending) :
+	m_bThreadStarted(false), m_bStop(false), m_bBusy(false),
+	m_maxPending(maxPending > 0 ? maxPending : 1)
+{
+	pthread_mutex_init(&m_mutex, NULL);
+	pthread_cond_init(&m_condQueue, NULL);
+	pthread_cond_init(&m_condDone, NULL);
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+	if(m_bThreadStarted){
+		pthread_mutex_lock(&m_mutex);
+		m_bStop = true;
+		pthread_cond_signal(&m_condQueue);
+		pthread_mutex_unlock(&m_mutex);
+		pthread_join(m_thread, NULL);
+	}
+
+	if(!m_error.empty())
+		UG_LOG("AsyncFileWriter: " << m_error << "\n");
+
+	pthread_cond_destroy(&m_condDone);
+	pthread_cond_destroy(&m_condQueue);
+	pthread_mutex_destroy(&m_mutex);
+}
+
+void* AsyncFileWriter::thread_func(void* pWriter)
+{
+	static_cast<AsyncFileWriter*>(pWriter)->run();
+	return NULL;
+}
+
+void AsyncFileWriter::run()
+{
+	std::pair<std::string, std::string> job;
+
+	pthread_mutex_lock(&m_mutex);
+	for(;;)
+	{
+		while(m_queue.empty() && !m_bStop)
+			pthread_cond_wait(&m_condQueue, &m_mutex);
+
+	//	all files are written before the thread stops
+		if(m_queue.empty()) break;
+
+		job.first.swap(m_queue.front().first);
+		job.second.swap(m_queue.front().second);
+		m_queue.pop_front();
+		m_bBusy = true;
+		pthread_cond_broadcast(&m_condDone);
+		pthread_mutex_unlock(&m_mutex);
+
+		std::string error;
+		try{
+			write_file(job.first, job.second);
+		}
+		catch(UGError& err){
+			error = err.get_msg();
+		}
+		std::string().swap(job.second);
+
+		pthread_mutex_lock(&m_mutex);
+		if(!error.empty() && m_error.empty()) m_error = error;
+		m_bBusy = false;
+		pthread_cond_broadcast(&m_condDone);
+	}
+	pthread_mutex_unlock(&m_mutex);
+}
+
+void AsyncFileWriter::write(const std::string& filename, std::string& content)
+{
+	PROFILE_FUNC();
+	pthread_mutex_lock(&m_mutex);
+
+	if(!m_bThreadStarted){
+		if(pthread_create(&m_thread, NULL, &AsyncFileWriter::thread_func, this) != 0){
+			pthread_mutex_unlock(&m_mutex);
+			UG_LOG("AsyncFileWriter: Cannot create thread, writing directly.\n");
+			write_file(filename, content);
+			content.clear();
+			return;
+		}
+		m_bThreadStarted = true;
+	}
+
+	while(m_queue.size() >= m_maxPending)
+		pthread_cond_wait(&m_condDone, &m_mutex);
+
+	m_queue.push_back(std::make_pair(filename, std::string()));
+	m_queue.back().second.swap(content);
+	pthread_cond_signal(&m_condQueue);
+	pthread_mutex_unlock(&m_mutex);
+
+	check_error();
+}
+
+void AsyncFileWriter::wait()
+{
+	PROFILE_FUNC();
+	pthread_mutex_lock(&m_mutex);
+	while(!m_queue.empty() || m_bBusy)
+		pthread_cond_wait(&m_condDone, &m_mutex);
+	pthread_mutex_unlock(&m_mutex);
+
+	check_error();
+}
+
+void AsyncFileWriter::check_error()
+{
+	pthread_mutex_lock(&m_mutex);
+	std::string error;
+	error.swap(m_error);
+	pthread_mutex_unlock(&m_mutex);
+
+	if(!error.empty())
+		UG_THROW("AsyncFileWriter: " << error);
+}
+
+#else
+
+AsyncFileWriter::AsyncFileWriter(size_t maxPending) : m_maxPending(maxPending) {}
+
+AsyncFileWriter::~AsyncFileWriter() {}
+
+void AsyncFileWriter::write(const std::string& filename, std::string& content)
+{
+	PROFILE_FUNC();
+	write_file(filename, content);
+	content.clear();
+}
+
+void AsyncFileWriter::wait() {}
+
+void AsyncFileWriter::check_error() {}
+
+#endif
+
+} // namespace ug
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__COMMON__UTIL__ASYNC_FILE_WRITER__
+#define __H__UG__COMMON__UTIL__ASYNC_FILE_WRITER__
+
+#include <string>
+#include <deque>
+#include <utility>
+
+#ifdef UG_POSIX
+	#include <pthread.h>
+#endif
+
+namespace ug {
+
+/// \addtogroup ugbase_common_io
+/// \{
+
+///	writes files in a background thread
+/**
+ * The content of a file is assembled in memory by the caller and handed over
+ * to the writer, which writes it to disk in a background thread. This way,
+ * the (slow) file system access overlaps with the computation of the caller.
+ * The files are written in the order in which they have been queued.
+ *
+ * At most maxPending files are queued. If the queue is full, write() blocks
+ * until the oldest file has been written.
+ *
+ * Errors occurring in the background thread are reported by throwing an
+ * exception on the next call of write() or wait().
+ *
+ * If UG_POSIX is not defined, the files are written directly in write().
+ */
+class AsyncFileWriter
+{
+	public:
+	///	constructor
+		AsyncFileWriter(size_t maxPending = 2);
+
+	///	destructor, waits until all queued files are written
+		~AsyncFileWriter();
+
+	///	queues a file for writing
+	/**	The content is taken over by the writer, i.e. content is empty
+	 * afterwards.*/
+		void write(const std::string& filename, std::string& content);
+
+	///	blocks until all queued files are written
+		void wait();
+
+	///	writes a file directly (not profiled, since called by the writer thread)
+		static void write_file(const std::string& filename, const std::string& content);
+
+	private:
+	//	disallow copy
+		AsyncFileWriter(const AsyncFileWriter&);
+		AsyncFileWriter& operator=(const AsyncFileWriter&);
+
+	///	throws the error of the background thread (if any)
+		void check_error();
+
+#ifdef UG_POSIX
+	///	entry point of the background thread
+		static void* thread_func(void* pWriter);
+
+	///	loop of the background thread
+		void run();
+
+		pthread_t m_thread;
+		pthread_mutex_t m_mutex;
+		pthread_cond_t m_condQueue;
+		pthread_cond_t m_condDone;
+		bool m_bThreadStarted;
+		bool m_bStop;
+		bool m_bBusy;
+#endif
+
+		size_t m_maxPending;
+		std::deque<std::pair<std::string, std::string> > m_queue;
+		std::string m_error;
+};
+
+// end group ugbase_common_io
+/// \}
+
+} // namespace ug
+
+#endif // __H__UG__COMMON__UTIL__ASYNC_FILE_WRITER__
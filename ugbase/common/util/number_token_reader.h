@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+#ifndef __H__UG_number_token_reader
+#define __H__UG_number_token_reader
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include "common/types.h"
+
+namespace ug{
+
+///	Reads whitespace separated numbers directly from a character buffer.
+/**	The reader mimics the extraction interface of std::istream
+ * (operator>>, eof(), fail()) but neither copies the buffer nor uses locales.
+ * It is thus a drop-in replacement for std::stringstream when large lists of
+ * numbers have to be parsed, e.g. the vertex and element lists of ugx files.
+ *
+ * Real numbers with at most 15 significant digits and a decimal exponent in
+ * [-22, 22] are converted exactly from their integer mantissa. All other real
+ * numbers are passed to strtod, so the results equal those of std::istream.
+ *
+ * Integers out of the range of the target type set the fail flag.
+ *
+ * In contrast to std::istream, a failed extraction also sets eof, so that
+ * loops of the form 'while(!in.eof())' terminate on malformed input.
+ */
+class NumberTokenReader
+{
+	public:
+		NumberTokenReader(const char* buf, size_t size) :
+			m_p(buf), m_end(buf + size), m_fail(false)	{}
+
+		bool eof() const	{return m_fail || m_p == m_end;}
+		bool fail() const	{return m_fail;}
+
+		NumberTokenReader& operator>>(int& valOut)				{read_integer(valOut); return *this;}
+		NumberTokenReader& operator>>(unsigned int& valOut)		{read_integer(valOut); return *this;}
+		NumberTokenReader& operator>>(long& valOut)				{read_integer(valOut); return *this;}
+		NumberTokenReader& operator>>(unsigned long& valOut)	{read_integer(valOut); return *this;}
+		NumberTokenReader& operator>>(double& valOut)			{read_real(valOut); return *this;}
+		NumberTokenReader& operator>>(float& valOut)
+		{
+			double d;
+			if(read_real(d))
+				valOut = (float)d;
+			return *this;
+		}
+
+	private:
+		static bool is_space(char c)	{return c == ' ' || (c >= '\t' && c <= '\r');}
+		static bool is_digit(char c)	{return c >= '0' && c <= '9';}
+
+	///	skips whitespace and sets the fail flag if no token is left
+		bool next_token()
+		{
+			if(m_fail)
+				return false;
+			while(m_p != m_end && is_space(*m_p))
+				++m_p;
+			if(m_p == m_end)
+				m_fail = true;
+			return !m_fail;
+		}
+
+		template <class TInt>
+		bool read_integer(TInt& valOut)
+		{
+			if(!next_token())
+				return false;
+
+			const char* p = m_p;
+			bool negative = false;
+			if(*p == '-' || *p == '+'){
+				negative = (*p == '-');
+				++p;
+			}
+
+			if(p == m_end || !is_digit(*p)){
+				m_fail = true;
+				return false;
+			}
+
+		//	accumulate the magnitude and fail on values out of the range of TInt
+			const uint64 maxMag = (uint64)std::numeric_limits<TInt>::max()
+								+ ((negative && std::numeric_limits<TInt>::is_signed) ? 1 : 0);
+			uint64 mag = 0;
+			while(p != m_end && is_digit(*p)){
+				const uint64 d = (uint64)(*p - '0');
+				if(mag > (maxMag - d) / 10){
+					m_fail = true;
+					return false;
+				}
+				mag = mag * 10 + d;
+				++p;
+			}
+
+			if(negative && mag > 0)
+				valOut = (TInt)(TInt(0) - (TInt)(mag - 1) - TInt(1));
+			else
+				valOut = (TInt)mag;
+			m_p = p;
+			return true;
+		}
+
+		bool read_real(double& valOut)
+		{
+			if(!next_token())
+				return false;
+
+			static const double pow10[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+				1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+				1e21, 1e22};
+
+			const char* p = m_p;
+			bool negative = false;
+			if(*p == '-' || *p == '+'){
+				negative = (*p == '-');
+				++p;
+			}
+
+		//	accumulate the significant digits in an integer mantissa
+			uint64 mantissa = 0;
+			int numDigits = 0;
+			int exponent = 0;
+			bool anyDigit = false;
+			bool exact = true;
+
+			for(; p != m_end && is_digit(*p); ++p){
+				anyDigit = true;
+				if(numDigits < 19){
+					mantissa = mantissa * 10 + (*p - '0');
+					if(mantissa)	++numDigits;
+				}
+				else{
+					++exponent;
+					exact = false;
+				}
+			}
+
+			if(p != m_end && *p == '.'){
+				++p;
+				for(; p != m_end && is_digit(*p); ++p){
+					anyDigit = true;
+					if(numDigits < 19){
+						mantissa = mantissa * 10 + (*p - '0');
+						if(mantissa)	++numDigits;
+						--exponent;
+					}
+					else
+						exact = false;
+				}
+			}
+
+			if(anyDigit && p != m_end && (*p == 'e' || *p == 'E')){
+				const char* pExp = p + 1;
+				bool negExp = false;
+				if(pExp != m_end && (*pExp == '-' || *pExp == '+')){
+					negExp = (*pExp == '-');
+					++pExp;
+				}
+				if(pExp != m_end && is_digit(*pExp)){
+					int e = 0;
+					for(; pExp != m_end && is_digit(*pExp); ++pExp){
+						if(e < 100000)
+							e = e * 10 + (*pExp - '0');
+					}
+					exponent += negExp ? -e : e;
+					p = pExp;
+				}
+			}
+
+			if(anyDigit && exact && numDigits <= 15
+			   && exponent >= -22 && exponent <= 22)
+			{
+			//	both the mantissa and the power of ten are exactly representable,
+			//	so a single multiplication or division rounds correctly.
+				double val = (double)mantissa;
+				if(exponent < 0)	val /= pow10[-exponent];
+				else				val *= pow10[exponent];
+				valOut = negative ? -val : val;
+				m_p = p;
+				return true;
+			}
+
+		//	fall back to strtod on a terminated copy of the token (this also
+		//	handles 'inf' and 'nan').
+			const char* pEnd = m_p;
+			while(pEnd != m_end && !is_space(*pEnd))
+				++pEnd;
+			const std::string token(m_p, pEnd);
+
+			char* tokenEnd;
+			double val = strtod(token.c_str(), &tokenEnd);
+			if(tokenEnd == token.c_str()){
+				m_fail = true;
+				return false;
+			}
+			valOut = val;
+			m_p += (tokenEnd - token.c_str());
+			return true;
+		}
+
+		const char*	m_p;
+		const char*	m_end;
+		bool		m_fail;
+};
+
+}//	end of namespace
+
+#endif	//__H__UG_number_token_reader
@@ -33,6 +33,13 @@
 #ifndef __H__COMMON__UTIL__PROVIDER__
 #define __H__COMMON__UTIL__PROVIDER__
 
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
 namespace ug{
 
 /// \addtogroup ugbase_common_util
@@ -57,6 +64,113 @@ class Provider
 		}
 };
 
+/// storage class specifier for thread local variables
+#ifdef _MSC_VER
+	#define UG_THREAD_LOCAL __declspec(thread)
+#else
+	#define UG_THREAD_LOCAL __thread
+#endif
+
+/// Provider, holding a single instance of an object for each thread
+/**
+ * This class is used like the Provider, but returns a separate instance of
+ * the object for each thread. This is needed for objects that store state,
+ * such as element geometries updated for the current element, if they are
+ * used concurrently by several threads.
+ *
+ * The instance of a thread is created on first access by the thread itself
+ * and is found afterwards through a thread local pointer, i.e. the lookup
+ * needs no locking and works for every kind of thread (OpenMP threads of
+ * nested teams, pthreads, ...). All created instances are additionally
+ * registered in a list, from which they are deleted at program exit. Since
+ * instances are kept until then, threads should be long living (e.g. the
+ * OpenMP thread pool).
+ */
+template <typename TClass>
+class ThreadProvider
+{
+	public:
+		///	type of provided object
+		typedef TClass Type;
+
+		///	returns the instance of the calling thread
+		static inline TClass& get(){
+			if(!s_pInst) s_pInst = create();
+			return *s_pInst;
+		}
+
+		///	returns the instances of all threads created so far
+		/**	The returned instances must not be used while other threads may
+		 * access them.*/
+		static void instances(std::vector<TClass*>& vInst){
+			vInst.clear();
+			for(Entry* e = registry().m_pHead; e; e = e->pNext)
+				vInst.push_back(e->pInst);
+		}
+
+	protected:
+		///	entry of the list of all instances
+		struct Entry{
+			TClass* pInst;
+			Entry* pNext;
+		};
+
+		///	list of all instances, deleting them on destruction
+		struct Registry{
+			Registry() : m_pHead(NULL) {}
+			~Registry(){
+				while(m_pHead){
+					Entry* e = m_pHead;
+					m_pHead = e->pNext;
+					destroy(e->pInst);
+					delete e;
+				}
+			}
+			Entry* volatile m_pHead;
+		};
+
+		///	singleton registry
+		static Registry& registry(){
+			static Registry reg;
+			return reg;
+		}
+
+		///	creates and registers the instance of the calling thread
+		static TClass* create(){
+		//	make sure the registry is constructed before any instance, such
+		//	that it is destroyed after all of them
+			Registry& reg = registry();
+
+			Entry* e = new Entry;
+			e->pInst = new TClass;
+
+		//	lock-free push to the front of the list
+			do{
+				e->pNext = reg.m_pHead;
+			}while(!compare_and_swap(&reg.m_pHead, e->pNext, e));
+
+			return e->pInst;
+		}
+
+		///	deletes an instance (within the scope of possible friends of TClass)
+		static void destroy(TClass* pInst) {delete pInst;}
+
+		///	sets *ptr to newVal if it equals oldVal, returns if set
+		static bool compare_and_swap(Entry* volatile* ptr, Entry* oldVal, Entry* newVal){
+#ifdef _MSC_VER
+			return _InterlockedCompareExchangePointer((void* volatile*)ptr, newVal, oldVal) == oldVal;
+#else
+			return __sync_bool_compare_and_swap(ptr, oldVal, newVal);
+#endif
+		}
+
+		///	instance of the calling thread
+		static UG_THREAD_LOCAL TClass* s_pInst;
+};
+
+template <typename TClass>
+UG_THREAD_LOCAL TClass* ThreadProvider<TClass>::s_pInst = NULL;
+
 // end group ugbase_common_util
 /// \}
 
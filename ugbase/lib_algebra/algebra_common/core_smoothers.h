@@ -34,6 +34,8 @@
 #define __H__UG__CPU_ALGEBRA__CORE_SMOOTHERS__
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "lib_algebra/cpu_algebra/level_schedule.h"
+
 namespace ug
 {
 
@@ -200,6 +202,121 @@ void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const
 	gs_step_UR(A, c, c, relaxFactor);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+//	level scheduled gauss-seidel steps
+/**
+ * \brief Performs a forward gauss-seidel-step, processing the rows level by level.
+ * The rows of a level of the lower triangular part are independent of each
+ * other and are processed by several threads. The result is identical to
+ * gs_step_LL. If the levels are too small for threading, gs_step_LL is used.
+ *
+ * \param A Matrix \f$A = D - L - U\f$
+ * \param c Vector. \f$ c = N * d = (D-L)^{-1} * d \f$
+ * \param d Vector d.
+ * \param sched level schedule of A
+ * \sa gs_step_LL, TriangularLevelSchedule
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_LL(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                const TriangularLevelSchedule& sched)
+{
+	const int nThreads = sched.num_lower_threads();
+	if(nThreads == 1 || sched.num_rows() != c.size())
+		{gs_step_LL(A, c, d, relaxFactor); return;}
+
+	const std::vector<size_t>& vStart = sched.lower_level_start();
+	const std::vector<size_t>& vRow = sched.lower_rows();
+	const size_t numLevels = sched.num_lower_levels();
+
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel num_threads(nThreads))
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		UG_CPU_ALGEBRA_PRAGMA(omp for schedule(static))
+		for(size_t k = vStart[lev]; k < vStart[lev+1]; ++k)
+		{
+			const size_t i = vRow[k];
+			typename Vector_type::value_type s = d[i];
+
+			for(typename Matrix_type::const_row_iterator it = A.begin_row(i); it != A.end_row(i)
+			&& it.index() < i; ++it)
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+			InverseMatMult(c[i], relaxFactor, A(i,i), s);
+		}
+	}
+}
+
+/**
+ * \brief Performs a backward gauss-seidel-step, processing the rows level by level.
+ * The result is identical to gs_step_UR.
+ *
+ * \param A Matrix \f$A = D - L - U\f$
+ * \param c will be \f$c = N * d = (D-U)^{-1} * d \f$
+ * \param d the vector d.
+ * \param sched level schedule of A
+ * \sa gs_step_UR, TriangularLevelSchedule
+ */
+template<typename Matrix_type, typename Vector_type>
+void gs_step_UR(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+                const TriangularLevelSchedule& sched)
+{
+	const int nThreads = sched.num_upper_threads();
+	if(nThreads == 1 || sched.num_rows() != c.size())
+		{gs_step_UR(A, c, d, relaxFactor); return;}
+
+	const std::vector<size_t>& vStart = sched.upper_level_start();
+	const std::vector<size_t>& vRow = sched.upper_rows();
+	const size_t numLevels = sched.num_upper_levels();
+
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel num_threads(nThreads))
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		UG_CPU_ALGEBRA_PRAGMA(omp for schedule(static))
+		for(size_t k = vStart[lev]; k < vStart[lev+1]; ++k)
+		{
+			const size_t i = vRow[k];
+			typename Vector_type::value_type s = d[i];
+			typename Matrix_type::const_row_iterator diag = A.get_connection(i, i);
+
+			typename Matrix_type::const_row_iterator it = diag; ++it;
+			for(; it != A.end_row(i); ++it)
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()]);
+
+			InverseMatMult(c[i], relaxFactor, diag.value(), s);
+		}
+	}
+}
+
+/**
+ * \brief Performs a symmetric gauss-seidel step, processing the rows level by level.
+ * The result is identical to sgs_step.
+ *
+ * \param A Matrix \f$A = D - L - R\f$
+ * \param c will be \f$c = N * d = (D-U)^{-1} D (D-L)^{-1} d \f$
+ * \param d the vector d.
+ * \param sched level schedule of A
+ * \sa sgs_step, TriangularLevelSchedule
+ */
+template<typename Matrix_type, typename Vector_type>
+void sgs_step(const Matrix_type &A, Vector_type &c, const Vector_type &d, const number relaxFactor,
+              const TriangularLevelSchedule& sched)
+{
+	// c1 = (D-L)^{-1} d
+	gs_step_LL(A, c, d, relaxFactor, sched);
+
+	// c2 = D c1
+	const size_t n = c.size();
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(n)))
+	for(size_t i = 0; i < n; i++)
+	{
+		typename Vector_type::value_type s = c[i];
+		MatMult(c[i], 1.0, A(i, i), s);
+	}
+
+	// c3 = (D-U)^{-1} c2
+	gs_step_UR(A, c, c, relaxFactor, sched);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 //	diag_step
 /**
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__CPU_ALGEBRA_THREADING__
+#define __H__UG__CPU_ALGEBRA__CPU_ALGEBRA_THREADING__
+
+#include <cstddef>
+
+#ifdef UG_OPENMP
+#include <omp.h>
+#define UG_CPU_ALGEBRA_PRAGMA(x)	_Pragma(#x)
+#else
+#define UG_CPU_ALGEBRA_PRAGMA(x)
+#endif
+
+namespace ug{
+
+/// \addtogroup cpu_algebra
+/// \{
+
+///	minimal number of rows (resp. vector entries) for which the kernels are threaded
+/**
+ * Below this size the fork/join overhead of a parallel region dominates the
+ * memory bound work of SpMV and BLAS-1 kernels.
+ */
+enum {CPU_ALGEBRA_THREADING_MIN_SIZE = 4096};
+
+///	returns the number of threads used by the cpu algebra kernels for a given size
+/**
+ * Returns 1 if OpenMP is not enabled, if the size is below
+ * CPU_ALGEBRA_THREADING_MIN_SIZE or if called from inside a parallel region
+ * (e.g. from a threaded element loop).
+ */
+inline int CPUAlgebraNumThreads(size_t n)
+{
+#ifdef UG_OPENMP
+	if(n < (size_t)CPU_ALGEBRA_THREADING_MIN_SIZE || omp_in_parallel())
+		return 1;
+	return omp_get_max_threads();
+#else
+	return 1;
+#endif
+}
+
+/// \}
+
+} // end namespace ug
+
+#endif /* __H__UG__CPU_ALGEBRA__CPU_ALGEBRA_THREADING__ */
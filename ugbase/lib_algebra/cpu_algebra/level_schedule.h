@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__LEVEL_SCHEDULE__
+#define __H__UG__CPU_ALGEBRA__LEVEL_SCHEDULE__
+
+#include <vector>
+#include <algorithm>
+#include "common/types.h"
+#include "cpu_algebra_threading.h"
+
+namespace ug{
+
+/// \addtogroup cpu_algebra
+/// \{
+
+///	level sets of the lower and upper triangular part of a sparse matrix
+/**
+ * The rows of a forward sweep (solve with the lower triangular part) are
+ * grouped into levels: a row is in level k, if the maximal level of the rows
+ * it depends on (the columns j < i of its entries) is k-1. Thus, all rows of
+ * a level are independent of each other and can be processed in parallel,
+ * while the levels are processed one after another. The same is done for the
+ * backward sweep (columns j > i). Since no rows are reordered, the scheduled
+ * sweeps compute the same result as the sequential ones.
+ *
+ * Threading pays off only if the levels are large, i.e. for matrices whose
+ * graph has a small depth compared to the number of rows (e.g. ILU(0) and
+ * Gauss-Seidel on typical finite element matrices with a suitable ordering).
+ * The schedule is only used if the average number of rows per level is at
+ * least MIN_ROWS_PER_LEVEL.
+ */
+class TriangularLevelSchedule
+{
+	public:
+	///	minimal average number of rows per level, for which threads are used
+		enum {MIN_ROWS_PER_LEVEL = 64};
+
+	public:
+		TriangularLevelSchedule() : m_numRows(0) {}
+
+	///	computes the level sets of a matrix
+		template<typename TMatrix>
+		void init(const TMatrix &A)
+		{
+			m_numRows = A.num_rows();
+			std::vector<size_t> vLevel(m_numRows);
+
+		//	lower part
+			for(size_t i = 0; i < m_numRows; ++i)
+			{
+				size_t lev = 0;
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it)
+					if(it.index() < i) lev = std::max(lev, vLevel[it.index()] + 1);
+				vLevel[i] = lev;
+			}
+			sort_into_levels(m_vLowerStart, m_vLowerRow, vLevel);
+
+		//	upper part
+			for(size_t i = m_numRows; i-- != 0;)
+			{
+				size_t lev = 0;
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it)
+					if(it.index() > i) lev = std::max(lev, vLevel[it.index()] + 1);
+				vLevel[i] = lev;
+			}
+			sort_into_levels(m_vUpperStart, m_vUpperRow, vLevel);
+		}
+
+	///	frees the memory
+		void clear()
+		{
+			m_numRows = 0;
+			std::vector<size_t>().swap(m_vLowerStart);
+			std::vector<size_t>().swap(m_vLowerRow);
+			std::vector<size_t>().swap(m_vUpperStart);
+			std::vector<size_t>().swap(m_vUpperRow);
+		}
+
+	///	returns if a schedule has been computed
+		bool valid() const {return m_numRows > 0;}
+
+	///	returns the number of rows
+		size_t num_rows() const {return m_numRows;}
+
+	///	returns the number of levels of the lower resp. upper part
+	/// \{
+		size_t num_lower_levels() const {return m_vLowerStart.empty() ? 0 : m_vLowerStart.size() - 1;}
+		size_t num_upper_levels() const {return m_vUpperStart.empty() ? 0 : m_vUpperStart.size() - 1;}
+	/// \}
+
+	///	returns the rows of the lower resp. upper part, ordered by level
+	/// \{
+		const std::vector<size_t>& lower_level_start() const {return m_vLowerStart;}
+		const std::vector<size_t>& lower_rows() const {return m_vLowerRow;}
+		const std::vector<size_t>& upper_level_start() const {return m_vUpperStart;}
+		const std::vector<size_t>& upper_rows() const {return m_vUpperRow;}
+	/// \}
+
+	///	returns the number of threads to use for the lower resp. upper sweep
+	/**	Returns 1, if the sweep should be performed sequentially.*/
+	/// \{
+		int num_lower_threads() const {return num_threads(num_lower_levels());}
+		int num_upper_threads() const {return num_threads(num_upper_levels());}
+	/// \}
+
+	protected:
+		int num_threads(size_t numLevels) const
+		{
+			if(numLevels == 0 || m_numRows / numLevels < (size_t)MIN_ROWS_PER_LEVEL)
+				return 1;
+			return CPUAlgebraNumThreads(m_numRows);
+		}
+
+		void sort_into_levels(std::vector<size_t>& vStart, std::vector<size_t>& vRow,
+		                      const std::vector<size_t>& vLevel)
+		{
+			size_t numLevels = 0;
+			for(size_t i = 0; i < m_numRows; ++i)
+				numLevels = std::max(numLevels, vLevel[i] + 1);
+
+			vStart.assign(numLevels + 1, 0);
+			for(size_t i = 0; i < m_numRows; ++i)
+				++vStart[vLevel[i] + 1];
+			for(size_t l = 0; l < numLevels; ++l)
+				vStart[l+1] += vStart[l];
+
+			std::vector<size_t> vPos(vStart.begin(), vStart.end() - 1);
+			vRow.resize(m_numRows);
+			for(size_t i = 0; i < m_numRows; ++i)
+				vRow[vPos[vLevel[i]]++] = i;
+		}
+
+	protected:
+		size_t m_numRows;
+		std::vector<size_t> m_vLowerStart, m_vLowerRow;
+		std::vector<size_t> m_vUpperStart, m_vUpperRow;
+};
+
+/// \}
+
+} // end namespace ug
+
+#endif /* __H__UG__CPU_ALGEBRA__LEVEL_SCHEDULE__ */
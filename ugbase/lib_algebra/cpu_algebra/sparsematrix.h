@@ -43,6 +43,7 @@
 #include "../algebra_common/connection.h"
 #include "../algebra_common/matrixrow.h"
 #include "../common/operations_mat/operations_mat.h"
+#include "sparsematrix_packed.h"
 
 #define PROFILE_SPMATRIX(name) PROFILE_BEGIN_GROUP(name, "SparseMatrix algebra")
 
@@ -127,6 +128,14 @@ public:
 	void resize_and_clear(size_t newRows, size_t newCols);
 	void resize_and_keep_values(size_t newRows, size_t newCols);
 
+	/**
+	 * \brief sets all values to zero, but keeps the sparsity pattern
+	 * The matrix is defragmented, so that a subsequent assembling with the
+	 * same pattern finds all connections in place and does not need to
+	 * insert or move any entries.
+	 */
+	void clear_retain_structure();
+
 	/**
 	 * \brief write in a empty SparseMatrix (this) the transpose SparseMatrix of B.
 	 * \param B			the matrix of which to create the transpose of
@@ -148,6 +157,27 @@ public:
 		return *this;
 	}
 
+	/**
+	 * \brief enables the packed storage for matrix-vector products
+	 * If enabled, axpy uses an immutable, defragmented copy of the matrix
+	 * (SELL-C-sigma for double entries, block-CRS for block entries, see
+	 * PackedSparseMatrix). The copy is created from the current matrix by
+	 * this method and by update_packed_storage(). Any non-const access to the
+	 * matrix discards the copy, and products use the CRS storage until
+	 * update_packed_storage() is called again. The copy is never built within
+	 * a product, so concurrent products on the same matrix are safe. This pays
+	 * off for matrices that are assembled once and applied many times, e.g.
+	 * the operator of a linear solver.
+	 * \param bEnable		enable/disable
+	 */
+	void enable_packed_storage(bool bEnable);
+
+	//! (re)builds the packed copy of the matrix if enabled and outdated
+	void update_packed_storage();
+
+	//! returns if the packed storage is used for matrix-vector products
+	bool packed_storage_enabled() const {return m_bUsePacked;}
+
 
 public:
 	//! calculate dest = alpha1*v1 + beta1*A*w1 (A = this matrix)
@@ -287,6 +317,7 @@ public:
 	value_type &operator() (size_t r, size_t c)
 	{
 		check_rc(r, c);
+		invalidate_packed();
 		int j=get_index(r, c);
         UG_ASSERT(j != -1 && cols[j]==(int)c && j >= rowStart[r] && j < rowEnd[r], "");
         return values[j];
@@ -363,7 +394,7 @@ public:
         size_t i;
     public:
         inline void check() const {A.check_row(row, i); }
-        row_iterator(SparseMatrix &_A, size_t _row, size_t _i) : A(_A), row(_row), i(_i) { A.add_iterator(row); }
+        row_iterator(SparseMatrix &_A, size_t _row, size_t _i) : A(_A), row(_row), i(_i) { A.add_iterator(row); A.invalidate_packed(); }
         row_iterator(const row_iterator &other) : A(other.A), row(other.row), i(other.i) { A.add_iterator(row); }
         ~row_iterator() { A.remove_iterator(row); }
         row_iterator *operator ->() { return this; }
@@ -544,6 +575,7 @@ public:
 			value_type *&pValues, size_t *pRowStart, size_t *pColInd, size_t &nnz) const
 	{
 		defragment();
+		(const_cast<this_type*>(this))->invalidate_packed();
 		pValues = &values[0];
 		pRowStart = &rowStart[0];
 		pColInd = &cols[0];
@@ -605,6 +637,9 @@ private:
     void assureValuesSize(size_t s);
     size_t get_nnz() const { return nnz; }
 
+	//! marks the packed copy as outdated, products use the CRS storage until it is updated
+	void invalidate_packed() { m_bPackedValid = false; }
+
 private:
 	// disallowed operations (not defined):
 	//---------------------------------------
@@ -638,6 +673,10 @@ protected:
     int m_numCols;
     mutable int iIterators;
 
+    bool m_bUsePacked;
+    bool m_bPackedValid;
+    PackedSparseMatrix<value_type> m_packed;
+
 #ifdef CHECK_ROW_ITERATORS
 public:
     mutable std::vector<int> nrOfRowIterators;
@@ -41,6 +41,7 @@
 #include "lib_algebra/common/operations_vec.h"
 #include "common/profiler/profiler.h"
 #include "sparsematrix.h"
+#include "cpu_algebra_threading.h"
 #include <vector>
 #include <algorithm>
 
@@ -57,6 +58,8 @@ SparseMatrix<T>::SparseMatrix()
 	nnz = 0;
 	m_numCols = 0;
 	maxValues = 0;
+	m_bUsePacked = false;
+	m_bPackedValid = false;
 	cols.resize(32);
 	if(bNeedsValues) values.resize(32);
 }
@@ -65,6 +68,7 @@ template<typename T>
 void SparseMatrix<T>::resize_and_clear(size_t newRows, size_t newCols)
 {
 	PROFILE_SPMATRIX(SparseMatrix_resize_and_clear);
+	invalidate_packed();
 	rowStart.clear(); rowStart.resize(newRows+1, -1);
 	rowMax.clear(); rowMax.resize(newRows);
 	rowEnd.clear(); rowEnd.resize(newRows, -1);
@@ -82,10 +86,22 @@ void SparseMatrix<T>::resize_and_clear(size_t newRows, size_t newCols)
 #endif
 }
 
+template<typename T>
+void SparseMatrix<T>::clear_retain_structure()
+{
+	PROFILE_SPMATRIX(SparseMatrix_clear_retain_structure);
+	invalidate_packed();
+	defragment();
+	if(bNeedsValues)
+		for(size_t i=0; i < values.size(); i++)
+			values[i] = 0.0;
+}
+
 template<typename T>
 void SparseMatrix<T>::resize_and_keep_values(size_t newRows, size_t newCols)
 {
 	PROFILE_SPMATRIX(SparseMatrix_resize_and_keep_values);
+	invalidate_packed();
 	//UG_LOG("SparseMatrix resize " << newRows << "x" << newCols << "\n");
 	if(newRows == 0 && newCols == 0)
 		return resize_and_clear(0,0);
@@ -112,6 +128,26 @@ void SparseMatrix<T>::resize_and_keep_values(size_t newRows, size_t newCols)
 }
 
 
+template<typename T>
+void SparseMatrix<T>::enable_packed_storage(bool bEnable)
+{
+	m_bUsePacked = bEnable;
+	invalidate_packed();
+	if(bEnable) update_packed_storage();
+	else m_packed.clear();
+}
+
+template<typename T>
+void SparseMatrix<T>::update_packed_storage()
+{
+	if(!m_bUsePacked || m_bPackedValid) return;
+
+	PROFILE_SPMATRIX(SparseMatrix_update_packed_storage);
+	m_packed.init(*this);
+	m_bPackedValid = true;
+}
+
+
 template<typename T>
 void SparseMatrix<T>::set_as_transpose_of(const SparseMatrix<value_type> &B, double scale)
 {
@@ -168,7 +204,10 @@ template<typename vector_t>
 void SparseMatrix<T>::apply_ignore_zero_rows(vector_t &dest,
 		const number &beta1, const vector_t &w1) const
 {
-	for(size_t i=0; i < num_rows(); i++)
+	const size_t nRows = num_rows();
+
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads((&dest != &w1) ? CPUAlgebraNumThreads(nRows) : 1))
+	for(size_t i=0; i < nRows; i++)
 	{
 		size_t rowIt=rowStart[i];
 		size_t itEnd=rowEnd[i];
@@ -191,10 +230,26 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 		const number &beta1, const vector_t &w1) const
 {
 	PROFILE_SPMATRIX(SparseMatrix_axpy);
+
+	if(m_bPackedValid && &dest != &w1)
+	{
+		m_packed.axpy(dest, alpha1, v1, beta1, w1);
+		return;
+	}
+
 	check_fragmentation();
+
+//	rows are independent as long as the result does not overwrite w1, so
+//	the row loops are split into contiguous blocks of rows, one per thread
+	const size_t nRows = num_rows();
+#ifdef UG_OPENMP
+	const int nThreads = (&dest != &w1) ? CPUAlgebraNumThreads(nRows) : 1;
+#endif
+
 	if(alpha1 == 0.0)
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) if(nThreads > 1) num_threads(nThreads))
+		for(size_t i=0; i < nRows; i++)
 		{
 			size_t rowIt=rowStart[i];
 			size_t itEnd=rowEnd[i];
@@ -212,20 +267,25 @@ void SparseMatrix<T>::axpy(vector_t &dest,
 	else if(&dest == &v1)
 	{
 		if(alpha1 != 1.0) {
-			for(size_t i=0; i < num_rows(); i++)
+			UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) if(nThreads > 1) num_threads(nThreads))
+			for(size_t i=0; i < nRows; i++)
 			{
 				dest[i] *= alpha1;
 				mat_mult_add_row(i, dest[i], beta1, w1);
 			}
 		}
 		else
-			for(size_t i=0; i < num_rows(); i++)
+		{
+			UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) if(nThreads > 1) num_threads(nThreads))
+			for(size_t i=0; i < nRows; i++)
 				mat_mult_add_row(i, dest[i], beta1, w1);
+		}
 
 	}
 	else
 	{
-		for(size_t i=0; i < num_rows(); i++)
+		UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) if(nThreads > 1) num_threads(nThreads))
+		for(size_t i=0; i < nRows; i++)
 		{
 			VecScaleAssign(dest[i], alpha1, v1[i]);
 			mat_mult_add_row(i, dest[i], beta1, w1);
@@ -253,6 +313,41 @@ void SparseMatrix<T>::axpy_transposed(vector_t &dest,
 	else
 		VecScaleAssign(dest, alpha1, v1);
 
+#ifdef UG_OPENMP
+//	several rows scatter into the same entry of dest. To stay race free,
+//	every thread accumulates its block of rows into a private buffer and
+//	the buffers are summed up afterwards.
+	const size_t nRows = num_rows();
+	const int nThreads = (&dest != &w1) ? CPUAlgebraNumThreads(nRows) : 1;
+	if(nThreads > 1)
+	{
+		typedef typename vector_t::value_type entry_type;
+		const size_t n = dest.size();
+		entry_type zero; zero = 0.0;
+		std::vector<entry_type> vBuffer(nThreads*n, zero);
+
+		#pragma omp parallel num_threads(nThreads)
+		{
+			entry_type* buffer = &vBuffer[omp_get_thread_num()*n];
+
+			#pragma omp for schedule(static)
+			for(size_t i=0; i<nRows; i++)
+			{
+				size_t itEnd=rowEnd[i];
+				for(size_t rowIt=rowStart[i]; rowIt != itEnd; ++rowIt)
+					if(values[rowIt] != 0.0)
+						MatMultTransposedAdd(buffer[cols[rowIt]], 1.0, buffer[cols[rowIt]], beta1, values[rowIt], w1[i]);
+			}
+
+			#pragma omp for schedule(static)
+			for(size_t j=0; j<n; j++)
+				for(int t=0; t<nThreads; t++)
+					dest[j] += vBuffer[t*n+j];
+		}
+		return;
+	}
+#endif
+
 	for(size_t i=0; i<num_rows(); i++)
 	{
 
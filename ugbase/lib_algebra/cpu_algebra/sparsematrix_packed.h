@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__SPARSEMATRIX_PACKED__
+#define __H__UG__CPU_ALGEBRA__SPARSEMATRIX_PACKED__
+
+#include <vector>
+#include <algorithm>
+#include "common/types.h"
+#include "../small_algebra/storage/fixed_array.h"
+#include "../small_algebra/small_matrix/densematrix.h"
+#include "cpu_algebra_threading.h"
+
+namespace ug{
+
+/// \addtogroup cpu_algebra
+/// \{
+
+////////////////////////////////////////////////////////////////////////////////
+//	row kernels
+////////////////////////////////////////////////////////////////////////////////
+
+///	computes one row of dest = alpha1*v1 + beta1*A*w1 for the packed formats
+/**
+ * The generic version works on arbitrary block types by the usual
+ * MatMult/MatMultAdd operations.
+ */
+template<typename TValueType>
+struct PackedRowKernel
+{
+	template<typename vector_t>
+	static inline void axpy_row(typename vector_t::value_type &d,
+			const number &alpha1, const typename vector_t::value_type &v,
+			const number &beta1, const vector_t &w1,
+			const TValueType *pValue, const int *pCol, size_t num)
+	{
+		if(alpha1 == 0.0)
+		{
+			if(num == 0) {d = 0.0; return;}
+			MatMult(d, beta1, pValue[0], w1[pCol[0]]);
+			for(size_t k = 1; k < num; ++k)
+				MatMultAdd(d, 1.0, d, beta1, pValue[k], w1[pCol[k]]);
+		}
+		else
+		{
+			if(&d != &v || alpha1 != 1.0)
+				VecScaleAssign(d, alpha1, v);
+			for(size_t k = 0; k < num; ++k)
+				MatMultAdd(d, 1.0, d, beta1, pValue[k], w1[pCol[k]]);
+		}
+	}
+};
+
+///	unrolled row kernel for fixed size blocks of doubles
+/**
+ * The sums of all blocks of the row are accumulated into a local array of
+ * the compile time block size, so that the block products are unrolled by
+ * the compiler and alpha1, beta1 are applied only once per row.
+ */
+template<size_t TBlockSize, eMatrixOrdering TOrdering>
+struct PackedRowKernel<DenseMatrix<FixedArray2<double, TBlockSize, TBlockSize, TOrdering> > >
+{
+	typedef DenseMatrix<FixedArray2<double, TBlockSize, TBlockSize, TOrdering> > block_type;
+
+	template<typename vector_t>
+	static inline void axpy_row(typename vector_t::value_type &d,
+			const number &alpha1, const typename vector_t::value_type &v,
+			const number &beta1, const vector_t &w1,
+			const block_type *pValue, const int *pCol, size_t num)
+	{
+		double s[TBlockSize];
+		for(size_t r = 0; r < TBlockSize; ++r) s[r] = 0.0;
+
+		for(size_t k = 0; k < num; ++k)
+		{
+			const block_type &A = pValue[k];
+			const typename vector_t::value_type &w = w1[pCol[k]];
+			for(size_t c = 0; c < TBlockSize; ++c)
+			{
+				const double wc = w[c];
+				for(size_t r = 0; r < TBlockSize; ++r)
+					s[r] += A(r, c) * wc;
+			}
+		}
+
+		if(alpha1 == 0.0)
+			for(size_t r = 0; r < TBlockSize; ++r)
+				d[r] = beta1 * s[r];
+		else
+			for(size_t r = 0; r < TBlockSize; ++r)
+				d[r] = alpha1 * v[r] + beta1 * s[r];
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+//	PackedSparseMatrix
+////////////////////////////////////////////////////////////////////////////////
+
+///	immutable copy of a SparseMatrix used for the matrix-vector product
+/**
+ * The variable CRS storage of SparseMatrix allows fragmented rows, which is
+ * needed during assembling, but costs indirections in every product. This
+ * class stores a defragmented, read-only copy of the matrix:
+ * - for block entries the rows are stored one after another in a block-CRS
+ *   (BCSR) format and fixed size blocks of doubles use an unrolled kernel,
+ * - for double entries the SELL-C-sigma format is used (see specialization).
+ *
+ * The copy must be recreated by init() whenever the matrix changes.
+ */
+template<typename TValueType>
+class PackedSparseMatrix
+{
+	public:
+		typedef TValueType value_type;
+
+	public:
+		PackedSparseMatrix() : m_numRows(0) {}
+
+	///	creates the packed copy of a matrix
+		template<typename TMatrix>
+		void init(const TMatrix &A)
+		{
+			m_numRows = A.num_rows();
+			m_vRowStart.resize(m_numRows + 1);
+			m_vCol.clear(); m_vValue.clear();
+			m_vCol.reserve(A.total_num_connections());
+			m_vValue.reserve(A.total_num_connections());
+
+			m_vRowStart[0] = 0;
+			for(size_t i = 0; i < m_numRows; ++i)
+			{
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it)
+				{
+					m_vCol.push_back((int)it.index());
+					m_vValue.push_back(it.value());
+				}
+				m_vRowStart[i+1] = m_vCol.size();
+			}
+		}
+
+	///	frees the memory of the packed copy
+		void clear()
+		{
+			m_numRows = 0;
+			std::vector<size_t>().swap(m_vRowStart);
+			std::vector<int>().swap(m_vCol);
+			std::vector<value_type>().swap(m_vValue);
+		}
+
+	///	calculate dest = alpha1*v1 + beta1*A*w1
+		template<typename vector_t>
+		void axpy(vector_t &dest,
+				const number &alpha1, const vector_t &v1,
+				const number &beta1, const vector_t &w1) const
+		{
+			const size_t nRows = m_numRows;
+			const value_type *pValue = m_vValue.empty() ? NULL : &m_vValue[0];
+			const int *pCol = m_vCol.empty() ? NULL : &m_vCol[0];
+
+			UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(nRows)))
+			for(size_t i = 0; i < nRows; ++i)
+			{
+				const size_t start = m_vRowStart[i];
+				PackedRowKernel<value_type>::axpy_row(dest[i], alpha1, v1[i],
+						beta1, w1, pValue + start, pCol + start,
+						m_vRowStart[i+1] - start);
+			}
+		}
+
+	///	returns the number of rows
+		size_t num_rows() const {return m_numRows;}
+
+	protected:
+		size_t m_numRows;
+		std::vector<size_t> m_vRowStart;
+		std::vector<int> m_vCol;
+		std::vector<value_type> m_vValue;
+};
+
+///	SELL-C-sigma storage for scalar matrices
+/**
+ * The rows are sorted by their length within windows of SIGMA rows and
+ * grouped into chunks of C consecutive (sorted) rows. Each chunk is padded
+ * to its longest row and stored column major, so that the product processes
+ * C rows at once with unit stride access to values and column indices,
+ * which the compiler can vectorize. Padding entries have value zero and
+ * repeat a column used by the chunk.
+ */
+template<>
+class PackedSparseMatrix<double>
+{
+	public:
+		typedef double value_type;
+
+	///	chunk height and sorting window
+		enum {C = 8, SIGMA = 32*C};
+
+	public:
+		PackedSparseMatrix() : m_numRows(0) {}
+
+	///	creates the packed copy of a matrix
+		template<typename TMatrix>
+		void init(const TMatrix &A)
+		{
+			m_numRows = A.num_rows();
+			const size_t numChunks = (m_numRows + C - 1) / C;
+
+		//	sort rows by length (descending) within each window
+			std::vector<std::pair<size_t, int> > vLen(m_numRows);
+			for(size_t i = 0; i < m_numRows; ++i)
+				vLen[i] = std::make_pair(A.num_connections(i), (int)i);
+			for(size_t w = 0; w < m_numRows; w += SIGMA)
+				std::stable_sort(vLen.begin() + w,
+						vLen.begin() + std::min(w + SIGMA, m_numRows),
+						compare_length);
+
+			m_vPerm.assign(numChunks * C, -1);
+			for(size_t i = 0; i < m_numRows; ++i)
+				m_vPerm[i] = vLen[i].second;
+
+		//	chunk offsets
+			m_vChunkStart.resize(numChunks + 1);
+			m_vChunkStart[0] = 0;
+			for(size_t k = 0; k < numChunks; ++k)
+			{
+				size_t width = 0;
+				for(size_t l = k*C; l < std::min((k+1)*C, m_numRows); ++l)
+					width = std::max(width, vLen[l].first);
+				m_vChunkStart[k+1] = m_vChunkStart[k] + width * C;
+			}
+
+		//	fill chunks column major, padding with zeros
+			m_vCol.assign(m_vChunkStart[numChunks], 0);
+			m_vValue.assign(m_vChunkStart[numChunks], 0.0);
+			for(size_t k = 0; k < numChunks; ++k)
+			{
+				const size_t off = m_vChunkStart[k];
+				const size_t width = (m_vChunkStart[k+1] - off) / C;
+				if(width == 0) continue;
+
+			//	lane 0 holds the longest row of the chunk
+				for(size_t lane = 0; lane < C; ++lane)
+				{
+					const int row = m_vPerm[k*C + lane];
+					if(row < 0) continue;
+
+					size_t j = 0;
+					for(typename TMatrix::const_row_iterator it = A.begin_row(row);
+							it != A.end_row(row); ++it, ++j)
+					{
+						m_vCol[off + j*C + lane] = (int)it.index();
+						m_vValue[off + j*C + lane] = it.value();
+					}
+					const int padCol = (j > 0) ? m_vCol[off + (j-1)*C + lane] : m_vCol[off];
+					for(; j < width; ++j)
+						m_vCol[off + j*C + lane] = padCol;
+				}
+			//	lanes without a row
+				for(size_t lane = 0; lane < C; ++lane)
+					if(m_vPerm[k*C + lane] < 0)
+						for(size_t j = 0; j < width; ++j)
+							m_vCol[off + j*C + lane] = m_vCol[off];
+			}
+		}
+
+	///	frees the memory of the packed copy
+		void clear()
+		{
+			m_numRows = 0;
+			std::vector<size_t>().swap(m_vChunkStart);
+			std::vector<int>().swap(m_vPerm);
+			std::vector<int>().swap(m_vCol);
+			std::vector<double>().swap(m_vValue);
+		}
+
+	///	calculate dest = alpha1*v1 + beta1*A*w1
+		template<typename vector_t>
+		void axpy(vector_t &dest,
+				const number &alpha1, const vector_t &v1,
+				const number &beta1, const vector_t &w1) const
+		{
+			const size_t numChunks = m_vChunkStart.size() - 1;
+
+			UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(m_numRows)))
+			for(size_t k = 0; k < numChunks; ++k)
+			{
+				double s[C];
+				for(size_t lane = 0; lane < C; ++lane) s[lane] = 0.0;
+
+				const size_t end = m_vChunkStart[k+1];
+				for(size_t off = m_vChunkStart[k]; off != end; off += C)
+				{
+					const double *pValue = &m_vValue[off];
+					const int *pCol = &m_vCol[off];
+					for(size_t lane = 0; lane < C; ++lane)
+						s[lane] += pValue[lane] * w1[pCol[lane]];
+				}
+
+				for(size_t lane = 0; lane < C; ++lane)
+				{
+					const int row = m_vPerm[k*C + lane];
+					if(row < 0) break;
+					if(alpha1 == 0.0)
+						dest[row] = beta1 * s[lane];
+					else
+						dest[row] = alpha1 * v1[row] + beta1 * s[lane];
+				}
+			}
+		}
+
+	///	returns the number of rows
+		size_t num_rows() const {return m_numRows;}
+
+	protected:
+		static bool compare_length(const std::pair<size_t, int> &a,
+		                           const std::pair<size_t, int> &b)
+		{
+			return a.first > b.first;
+		}
+
+	protected:
+		size_t m_numRows;
+		std::vector<size_t> m_vChunkStart; ///< offset of chunk k in m_vCol, m_vValue
+		std::vector<int> m_vPerm;	///< original row of the packed row, -1 for padding
+		std::vector<int> m_vCol;
+		std::vector<double> m_vValue;
+};
+
+/// \}
+
+} // end namespace ug
+
+#endif /* __H__UG__CPU_ALGEBRA__SPARSEMATRIX_PACKED__ */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__CPU_ALGEBRA__SPARSEMATRIX_SINGLE__
+#define __H__UG__CPU_ALGEBRA__SPARSEMATRIX_SINGLE__
+
+#include <vector>
+#include <algorithm>
+#include "common/types.h"
+#include "common/error.h"
+#include "../small_algebra/small_algebra.h"
+#include "cpu_algebra_threading.h"
+
+namespace ug{
+
+/// \addtogroup cpu_algebra
+/// \{
+
+///	storage type of matrix entries in reduced precision
+/**
+ * Scalar entries are stored as float. Block entries are kept in their type,
+ * since the small algebra does not provide mixed precision block operations.
+ */
+template<typename TValueType>
+struct reduced_precision_traits
+{
+	typedef TValueType value_type;
+	enum { is_reduced = false };
+};
+
+template<>
+struct reduced_precision_traits<double>
+{
+	typedef float value_type;
+	enum { is_reduced = true };
+};
+
+///	read-only copy of a SparseMatrix with entries stored in single precision
+/**
+ * Preconditioners like Gauss-Seidel and the triangular solves of incomplete
+ * factorizations are limited by the memory bandwidth needed to read the
+ * matrix. This class stores a defragmented CRS copy of a matrix with scalar
+ * entries converted to float, which halves the number of bytes of the values.
+ * Vectors stay in double precision and all sums are accumulated in double,
+ * such that the precision is only reduced in the matrix entries.
+ *
+ * The class provides the row access interface of SparseMatrix (begin_row,
+ * end_row, get_connection, operator()), so that the generic smoother kernels
+ * (gs_step_LL, gs_step_UR, sgs_step, invert_L, invert_U) can be used on it.
+ * The entries of each row are sorted by column.
+ *
+ * The copy must be recreated by init() whenever the matrix changes.
+ */
+template<typename TValueType>
+class SinglePrecisionSparseMatrix
+{
+	public:
+		typedef typename reduced_precision_traits<TValueType>::value_type value_type;
+
+	///	iterator over the entries of a row
+		class const_row_iterator
+		{
+			public:
+				const_row_iterator(const int* pCol, const value_type* pValue)
+					: m_pCol(pCol), m_pValue(pValue) {}
+				size_t index() const {return (size_t)*m_pCol;}
+				const value_type& value() const {return *m_pValue;}
+				const_row_iterator& operator++() {++m_pCol; ++m_pValue; return *this;}
+				bool operator==(const const_row_iterator& o) const {return m_pCol == o.m_pCol;}
+				bool operator!=(const const_row_iterator& o) const {return m_pCol != o.m_pCol;}
+
+			protected:
+				const int* m_pCol;
+				const value_type* m_pValue;
+		};
+
+	public:
+		SinglePrecisionSparseMatrix() : m_numRows(0), m_numCols(0) {}
+
+	///	returns if the entries are stored in reduced precision
+		static bool is_reduced() {return reduced_precision_traits<TValueType>::is_reduced;}
+
+	///	creates the copy of a matrix
+		template<typename TMatrix>
+		void init(const TMatrix &A)
+		{
+			typedef std::pair<int, value_type> entry_type;
+
+			m_numRows = A.num_rows();
+			m_numCols = A.num_cols();
+			m_vRowStart.resize(m_numRows + 1);
+			m_vCol.clear(); m_vValue.clear();
+			m_vCol.reserve(A.total_num_connections());
+			m_vValue.reserve(A.total_num_connections());
+
+			std::vector<entry_type> vRow;
+			m_vRowStart[0] = 0;
+			for(size_t i = 0; i < m_numRows; ++i)
+			{
+				vRow.clear();
+				for(typename TMatrix::const_row_iterator it = A.begin_row(i);
+						it != A.end_row(i); ++it)
+					vRow.push_back(entry_type((int)it.index(), value_type(it.value())));
+				std::sort(vRow.begin(), vRow.end(), compare_column);
+
+				for(size_t k = 0; k < vRow.size(); ++k)
+				{
+					m_vCol.push_back(vRow[k].first);
+					m_vValue.push_back(vRow[k].second);
+				}
+				m_vRowStart[i+1] = m_vCol.size();
+			}
+		}
+
+	///	frees the memory of the copy
+		void clear()
+		{
+			m_numRows = m_numCols = 0;
+			std::vector<size_t>().swap(m_vRowStart);
+			std::vector<int>().swap(m_vCol);
+			std::vector<value_type>().swap(m_vValue);
+		}
+
+	///	returns the number of rows
+		size_t num_rows() const {return m_numRows;}
+
+	///	returns the number of columns
+		size_t num_cols() const {return m_numCols;}
+
+	///	returns the number of stored entries
+		size_t total_num_connections() const {return m_vCol.size();}
+
+	///	returns an iterator to the beginning of row r
+		const_row_iterator begin_row(size_t r) const {return entry(m_vRowStart[r]);}
+
+	///	returns an iterator to the end of row r
+		const_row_iterator end_row(size_t r) const {return entry(m_vRowStart[r+1]);}
+
+	///	returns an iterator to entry (r,c) or end_row(r) if not present
+		const_row_iterator get_connection(size_t r, size_t c) const
+		{
+			const int* pBegin = m_vCol.empty() ? NULL : &m_vCol[0];
+			const int* pEnd = pBegin + m_vRowStart[r+1];
+			const int* p = std::lower_bound(pBegin + m_vRowStart[r], pEnd, (int)c);
+			if(p == pEnd || *p != (int)c) return end_row(r);
+			return entry(p - pBegin);
+		}
+
+	///	returns entry (r,c), which must be present
+		const value_type& operator()(size_t r, size_t c) const
+		{
+			const_row_iterator it = get_connection(r, c);
+			UG_COND_THROW(it == end_row(r), "SinglePrecisionSparseMatrix: "
+							"Entry ("<<r<<","<<c<<") not present.");
+			return it.value();
+		}
+
+	///	calculate dest = alpha1*v1 + beta1*A*w1
+		template<typename vector_t>
+		void axpy(vector_t &dest,
+				const number &alpha1, const vector_t &v1,
+				const number &beta1, const vector_t &w1) const
+		{
+			UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(m_numRows)))
+			for(size_t i = 0; i < m_numRows; ++i)
+			{
+				typename vector_t::value_type &d = dest[i];
+				const size_t start = m_vRowStart[i], end = m_vRowStart[i+1];
+				if(alpha1 == 0.0)
+				{
+					if(start == end) {d = 0.0; continue;}
+					MatMult(d, beta1, m_vValue[start], w1[m_vCol[start]]);
+					for(size_t k = start + 1; k < end; ++k)
+						MatMultAdd(d, 1.0, d, beta1, m_vValue[k], w1[m_vCol[k]]);
+				}
+				else
+				{
+					if(&d != &v1[i] || alpha1 != 1.0)
+						VecScaleAssign(d, alpha1, v1[i]);
+					for(size_t k = start; k < end; ++k)
+						MatMultAdd(d, 1.0, d, beta1, m_vValue[k], w1[m_vCol[k]]);
+				}
+			}
+		}
+
+	protected:
+		const_row_iterator entry(size_t k) const
+		{
+			return const_row_iterator(m_vCol.empty() ? NULL : &m_vCol[0] + k,
+			                          m_vValue.empty() ? NULL : &m_vValue[0] + k);
+		}
+
+		static bool compare_column(const std::pair<int, value_type> &a,
+		                           const std::pair<int, value_type> &b)
+		{
+			return a.first < b.first;
+		}
+
+	protected:
+		size_t m_numRows, m_numCols;
+		std::vector<size_t> m_vRowStart;
+		std::vector<int> m_vCol;
+		std::vector<value_type> m_vValue;
+};
+
+/// \}
+
+} // end namespace ug
+
+#endif /* __H__UG__CPU_ALGEBRA__SPARSEMATRIX_SINGLE__ */
@@ -37,6 +37,7 @@
 #include <fstream>
 #include <algorithm>
 #include "algebra_misc.h"
+#include "cpu_algebra_threading.h"
 #include "common/math/ugmath.h"
 #include "vector.h" // for urand
 
@@ -74,6 +75,7 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 	UG_ASSERT(m_size == w.m_size,  *this << " has not same size as " << w);
 
 	double sum=0;
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) reduction(+:sum) num_threads(CPUAlgebraNumThreads(m_size)))
 	for(size_t i=0; i<m_size; i++)	sum += VecProd(values[i], w[i]);
 	return sum;
 }
@@ -82,6 +84,7 @@ inline double Vector<value_type>::dotprod(const Vector &w) //const
 template<typename value_type>
 inline double Vector<value_type>::operator = (double d)
 {
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(m_size)))
 	for(size_t i=0; i<m_size; i++)
 		values[i] = d;
 	return d;
@@ -100,6 +103,7 @@ template<typename value_type>
 inline void Vector<value_type>::operator = (const vector_type &v)
 {
 	resize(v.size());
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(m_size)))
 	for(size_t i=0; i<m_size; i++)
 		values[i] = v[i];
 }
@@ -108,6 +112,7 @@ template<typename value_type>
 inline void Vector<value_type>::operator += (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(m_size)))
 	for(size_t i=0; i<m_size; i++)
 		values[i] += v[i];
 }
@@ -116,6 +121,7 @@ template<typename value_type>
 inline void Vector<value_type>::operator -= (const vector_type &v)
 {
 	UG_ASSERT(v.size() == size(), "vector sizes must match! (" << v.size() << " != " << size() << ")");
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(m_size)))
 	for(size_t i=0; i<m_size; i++)
 		values[i] -= v[i];
 }
@@ -323,11 +329,107 @@ template<typename value_type>
 inline double Vector<value_type>::norm() const
 {
 	double d=0;
-	for(size_t i=0; i<size(); ++i)
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) reduction(+:d) num_threads(CPUAlgebraNumThreads(m_size)))
+	for(size_t i=0; i<m_size; ++i)
 		d+=BlockNorm2(values[i]);
 	return sqrt(d);
 }
 
+
+// BLAS-1 operations for Vector
+//-----------------------------------------------------------------------------
+// these overloads are more specialized than the generic ones of
+// operations_vec.h and split the loops into blocks, one per thread.
+
+//! calculates dest = alpha1*v1
+template<typename T>
+inline void VecScaleAssign(Vector<T> &dest, double alpha1, const Vector<T> &v1)
+{
+	const size_t n = dest.size();
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(n)))
+	for(size_t i=0; i<n; i++)
+		VecScaleAssign(dest[i], alpha1, v1[i]);
+}
+
+//! sets dest = v1 entrywise
+template<typename T>
+inline void VecAssign(Vector<T> &dest, const Vector<T> &v1)
+{
+	const size_t n = dest.size();
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(n)))
+	for(size_t i=0; i<n; i++)
+		dest[i] = v1[i];
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2
+template<typename T>
+inline void VecScaleAdd(Vector<T> &dest, double alpha1, const Vector<T> &v1, double alpha2, const Vector<T> &v2)
+{
+	const size_t n = dest.size();
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(n)))
+	for(size_t i=0; i<n; i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i]);
+}
+
+//! calculates dest = alpha1*v1 + alpha2*v2 + alpha3*v3
+template<typename T>
+inline void VecScaleAdd(Vector<T> &dest, double alpha1, const Vector<T> &v1, double alpha2, const Vector<T> &v2, double alpha3, const Vector<T> &v3)
+{
+	const size_t n = dest.size();
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) num_threads(CPUAlgebraNumThreads(n)))
+	for(size_t i=0; i<n; i++)
+		VecScaleAdd(dest[i], alpha1, v1[i], alpha2, v2[i], alpha3, v3[i]);
+}
+
+//! calculates s += scal<a, b>
+template<typename T>
+inline void VecProd(const Vector<T> &a, const Vector<T> &b, double &sum)
+{
+	const size_t n = a.size();
+	double s = 0;
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) reduction(+:s) num_threads(CPUAlgebraNumThreads(n)))
+	for(size_t i=0; i<n; i++)
+		VecProdAdd(a[i], b[i], s);
+	sum += s;
+}
+
+//! calculates s += scal<a, b>
+template<typename T>
+inline void VecProdAdd(const Vector<T> &a, const Vector<T> &b, double &sum)
+{
+	VecProd(a, b, sum);
+}
+
+//! returns scal<a, b>
+template<typename T>
+inline double VecProd(const Vector<T> &a, const Vector<T> &b)
+{
+	double sum=0;
+	VecProd(a, b, sum);
+	return sum;
+}
+
+//! calculates s += norm_2^2(a)
+template<typename T>
+inline void VecNormSquaredAdd(const Vector<T> &a, double &sum)
+{
+	const size_t n = a.size();
+	double s = 0;
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel for schedule(static) reduction(+:s) num_threads(CPUAlgebraNumThreads(n)))
+	for(size_t i=0; i<n; i++)
+		VecNormSquaredAdd(a[i], s);
+	sum += s;
+}
+
+//! returns norm_2^2(a)
+template<typename T>
+inline double VecNormSquared(const Vector<T> &a)
+{
+	double sum=0;
+	VecNormSquaredAdd(a, sum);
+	return sum;
+}
+
 template<typename TValueType>
 void CloneVector(Vector<TValueType> &dest, const Vector<TValueType>& src)
 {
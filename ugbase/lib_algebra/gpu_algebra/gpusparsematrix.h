@@ -154,6 +154,12 @@ public:
 		return *this;
 	}
 
+	//! packed storage is not supported, products always use the CRS storage
+	void enable_packed_storage(bool bEnable) {}
+
+	//! packed storage is not supported, nothing to update
+	void update_packed_storage() {}
+
 
 public:
 	//! calculate dest = alpha1*v1 + beta1*A*w1 (A = this matrix)
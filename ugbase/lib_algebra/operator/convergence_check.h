@@ -190,6 +190,9 @@ class StdConvCheck : public IConvergenceCheck<TVector>
 		void set_reduction(number relReduction) {m_relReduction = relReduction;}
 		void set_supress_unsuccessful(bool bsupress){ m_supress_unsuccessful = bsupress; }
 
+		number minimum_defect() const {return m_minDefect;}
+		number relative_reduction() const {return m_relReduction;}
+
 		void start_defect(number initialDefect);
 
 		void start(const TVector& d);
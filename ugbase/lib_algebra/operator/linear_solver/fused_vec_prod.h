@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_VEC_PROD__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_VEC_PROD__
+
+#include <vector>
+
+#include "common/common.h"
+#include "common/profiler/profiler.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+	#include "pcl/pcl.h"
+#endif
+
+namespace ug{
+
+///	computes several scalar products with only one global reduction
+/**
+ * Krylov methods usually need several scalar products per iteration. In
+ * parallel, each call to VecProd results in a separate, blocking global
+ * reduction, whose latency dominates the iteration time on large process
+ * counts. This class collects the process-local parts of an arbitrary number
+ * of scalar products and sums them up in one reduction. The reduction is
+ * non-blocking (if supported by the MPI implementation), so that the caller
+ * can apply a preconditioner or an operator while the reduction proceeds:
+ *
+ * \code
+ * FusedVecProd<vector_type> prods;
+ * const size_t iRho = prods.add(r, z);
+ * const size_t iDelta = prods.add(w, z);
+ * prods.start();
+ * // ... do local work ...
+ * prods.wait();
+ * const number rho = prods[iRho];
+ * \endcode
+ *
+ * In parallel, the vectors of each product must have storage types that
+ * allow a local computation, i.e. additive and consistent or unique and
+ * unique.
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class FusedVecProd
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	public:
+	///	constructor
+		FusedVecProd() : m_bRunning(false)
+		{
+			#ifdef UG_PARALLEL
+			m_request = MPI_REQUEST_NULL;
+			#endif
+		}
+
+	///	destructor, waits for a running reduction
+		~FusedVecProd() {wait();}
+
+	///	removes all scheduled products
+		void clear()
+		{
+			wait();
+			m_vLocal.clear();
+			m_vGlobal.clear();
+		}
+
+	///	computes the process-local part of (a,b) and returns the index of the product
+		size_t add(const vector_type& a, const vector_type& b)
+		{
+			UG_COND_THROW(m_bRunning, "FusedVecProd: Cannot add products "
+			              "while a reduction is running.");
+			m_vLocal.push_back(local_prod(a, b));
+			#ifdef UG_PARALLEL
+			m_procComm = a.layouts()->proc_comm();
+			#endif
+			return m_vLocal.size() - 1;
+		}
+
+	///	starts the global summation of all scheduled products
+		void start()
+		{
+			UG_COND_THROW(m_bRunning, "FusedVecProd: Reduction already running.");
+			m_vGlobal.resize(m_vLocal.size());
+			if(m_vLocal.empty()) return;
+
+			#ifdef UG_PARALLEL
+			if(!m_procComm.empty()){
+				PROFILE_BEGIN_GROUP(FusedVecProd_start, "algebra parallelization");
+				m_procComm.iallreduce(&m_vLocal.front(), &m_vGlobal.front(),
+				                      (int)m_vLocal.size(), PCL_DT_DOUBLE,
+				                      PCL_RO_SUM, &m_request);
+				m_bRunning = true;
+				return;
+			}
+			#endif
+
+			m_vGlobal = m_vLocal;
+		}
+
+	///	waits until the global summation has been completed
+		void wait()
+		{
+			if(!m_bRunning) return;
+
+			#ifdef UG_PARALLEL
+			PROFILE_BEGIN_GROUP(FusedVecProd_wait, "algebra parallelization");
+			pcl::MPI_Wait(&m_request);
+			#endif
+			m_bRunning = false;
+		}
+
+	///	returns the global value of a product (only valid after wait)
+		number operator[](size_t i) const
+		{
+			UG_ASSERT(!m_bRunning, "FusedVecProd: Reduction still running.");
+			UG_ASSERT(i < m_vGlobal.size(), "FusedVecProd: Invalid index "<<i);
+			return m_vGlobal[i];
+		}
+
+	///	returns the number of scheduled products
+		size_t size() const {return m_vLocal.size();}
+
+	protected:
+	///	returns the process-local part of the scalar product
+		static double local_prod(const vector_type& a, const vector_type& b)
+		{
+			#ifdef UG_PARALLEL
+			if(!((a.has_storage_type(PST_ADDITIVE) && b.has_storage_type(PST_CONSISTENT))
+				|| (a.has_storage_type(PST_CONSISTENT) && b.has_storage_type(PST_ADDITIVE))
+				|| (a.has_storage_type(PST_UNIQUE) && b.has_storage_type(PST_UNIQUE))))
+				UG_THROW("FusedVecProd: Storage types of vectors do not allow "
+				         "a local scalar product.");
+
+			typedef typename vector_type::vector_type local_vector_type;
+			return const_cast<local_vector_type&>(
+						static_cast<const local_vector_type&>(a)).dotprod(
+								static_cast<const local_vector_type&>(b));
+			#else
+			return const_cast<vector_type&>(a).dotprod(b);
+			#endif
+		}
+
+	protected:
+	///	process-local and global values of the products
+		std::vector<double> m_vLocal, m_vGlobal;
+
+	///	flag indicating a running reduction
+		bool m_bRunning;
+
+		#ifdef UG_PARALLEL
+	///	communicator and request of the reduction
+		pcl::ProcessCommunicator m_procComm;
+		MPI_Request m_request;
+		#endif
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__FUSED_VEC_PROD__ */
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_BICGSTAB__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_BICGSTAB__
+
+#include <cmath>
+#include <string>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "lib_algebra/operator/convergence_check.h"
+#include "common/profiler/profiler.h"
+#include "fused_vec_prod.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined BiCGStab method as a solver for linear operators
+/**
+ * This class implements the pipelined, preconditioned BiCGStab - method,
+ * which is mathematically equivalent to BiCGStab. Instead of four blocking
+ * global reductions per iteration, only two fused, non-blocking reductions
+ * are needed, each of which is overlapped with one application of the
+ * preconditioner and the linear operator. The price are several additional
+ * vectors.
+ *
+ * If a StdConvCheck is used, the defect norm is computed within the second
+ * reduction of each iteration.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Cools, Vanroose, "The communication-hiding pipelined BiCGStab method for
+ *   the parallel solution of large unsymmetric linear systems", Parallel
+ *   Computing 65 (2017), Alg. 5
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipeBiCGStab
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipeBiCGStab() : base_type() {}
+
+		PipeBiCGStab(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond )  {}
+
+		PipeBiCGStab(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipeBiCGStab";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	// 	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(PipeBiCGStab_apply_return_defect, "BiCGStab algebra");
+
+		//	check correct storage type in parallel
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipeBiCGStab: Inadequate storage format of Vectors.");
+			#endif
+
+		// 	build defect:  r := b - A*x
+			linear_operator()->apply_sub(b, x);
+			vector_type& r = b;
+
+		// 	create vectors (hatted vectors are consistent, others unique)
+			SmartPtr<vector_type> spR0 = r.clone_without_values(); vector_type& r0 = *spR0;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spT = r.clone_without_values(); vector_type& t = *spT;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+			SmartPtr<vector_type> spV = r.clone_without_values(); vector_type& v = *spV;
+			SmartPtr<vector_type> spQ = r.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spY = r.clone_without_values(); vector_type& y = *spY;
+			SmartPtr<vector_type> spRh = x.clone_without_values(); vector_type& rh = *spRh;
+			SmartPtr<vector_type> spWh = x.clone_without_values(); vector_type& wh = *spWh;
+			SmartPtr<vector_type> spPh = x.clone_without_values(); vector_type& ph = *spPh;
+			SmartPtr<vector_type> spSh = x.clone_without_values(); vector_type& sh = *spSh;
+			SmartPtr<vector_type> spZh = x.clone_without_values(); vector_type& zh = *spZh;
+			SmartPtr<vector_type> spQh = x.clone_without_values(); vector_type& qh = *spQh;
+
+		//	prepare convergence check
+			prepare_conv_check();
+
+		//	compute start defect norm
+			convergence_check()->start(r);
+			if(convergence_check()->iteration_ended())
+				return convergence_check()->post();
+
+		//	the defect norm can be fused into the reduction for the std check
+			StdConvCheck<vector_type>* pStdConvCheck =
+				dynamic_cast<StdConvCheck<vector_type>*>(convergence_check().get());
+
+		//	make r unique and choose shadow residual r0 := r
+			make_unique(r);
+			r0 = r;
+
+		//	rh := M^-1 r,  w := A rh
+			if(!precondition(rh, r)) return false;
+			apply_operator(w, rh);
+
+		//	start reduction of rho = (r0,r) and (r0,w) ...
+			FusedVecProd<vector_type> prods;
+			size_t iRho = prods.add(r0, r);
+			size_t iR0W = prods.add(r0, w);
+			prods.start();
+
+		//	... overlapped with wh := M^-1 w,  t := A wh
+			if(!precondition(wh, w)) return false;
+			apply_operator(t, wh);
+
+			prods.wait();
+
+			number rho = prods[iRho];
+			number alpha = rho / prods[iR0W], beta = 0.0, omega = 1.0;
+
+		// 	Iteration loop
+			for(size_t iter = 0; ; ++iter)
+			{
+			//	check validity of alpha
+				if(alpha == 0.0 || !std::isfinite(alpha)){
+					UG_LOG("PipeBiCGStab: Method breakdown: alpha = "<<alpha<<
+					       " is an invalid value. Aborting iteration.\n");
+					return false;
+				}
+
+			//	update search directions
+				if(iter == 0)
+				{
+					ph = rh; s = w; sh = wh; z = t;
+				}
+				else
+				{
+					VecScaleAdd(ph, 1.0, rh, beta, ph, -beta*omega, sh);
+					VecScaleAdd(s, 1.0, w, beta, s, -beta*omega, z);
+					VecScaleAdd(sh, 1.0, wh, beta, sh, -beta*omega, zh);
+					VecScaleAdd(z, 1.0, t, beta, z, -beta*omega, v);
+				}
+
+			//	q := r - alpha*s,  qh := rh - alpha*sh,  y := w - alpha*z
+				VecScaleAdd(q, 1.0, r, -alpha, s);
+				VecScaleAdd(qh, 1.0, rh, -alpha, sh);
+				VecScaleAdd(y, 1.0, w, -alpha, z);
+
+			//	start reduction of (q,y) and (y,y) ...
+				prods.clear();
+				const size_t iQY = prods.add(q, y);
+				const size_t iYY = prods.add(y, y);
+				prods.start();
+
+			//	... overlapped with zh := M^-1 z,  v := A zh
+				if(!precondition(zh, z)) return false;
+				apply_operator(v, zh);
+
+				prods.wait();
+
+			//	check validity of (y,y)
+				if(prods[iYY] == 0.0){
+					UG_LOG("PipeBiCGStab: Method breakdown: (y,y) = 0. "
+					       "Aborting iteration.\n");
+					return false;
+				}
+
+			//	omega = (q,y)/(y,y)
+				omega = prods[iQY] / prods[iYY];
+
+			// 	x := x + alpha*ph + omega*qh
+				VecScaleAdd(x, 1.0, x, alpha, ph, omega, qh);
+
+			//	r := q - omega*y
+				VecScaleAdd(r, 1.0, q, -omega, y);
+
+			//	rh := qh - omega*(wh - alpha*zh)
+				VecScaleAdd(rh, 1.0, qh, -omega, wh, omega*alpha, zh);
+
+			//	w := y - omega*(t - alpha*v)
+				VecScaleAdd(w, 1.0, y, -omega, t, omega*alpha, v);
+
+			//	start reduction of (r0,r), (r0,w), (r0,s), (r0,z) and (r,r) ...
+				prods.clear();
+				iRho = prods.add(r0, r);
+				iR0W = prods.add(r0, w);
+				const size_t iR0S = prods.add(r0, s);
+				const size_t iR0Z = prods.add(r0, z);
+				const size_t iNorm = pStdConvCheck ? prods.add(r, r) : 0;
+				prods.start();
+
+			//	... overlapped with wh := M^-1 w,  t := A wh
+				if(!precondition(wh, w)) return false;
+				apply_operator(t, wh);
+
+				prods.wait();
+
+			// 	check convergence
+				if(pStdConvCheck)
+					pStdConvCheck->update_defect(std::sqrt(prods[iNorm]));
+				else
+					convergence_check()->update(r);
+				if(convergence_check()->iteration_ended()) break;
+
+			//	check that rho valid
+				if(rho == 0.0 || omega == 0.0)
+				{
+					UG_LOG("PipeBiCGStab: Method breakdown with rho = "<<rho<<
+						   ", omega = "<<omega<<". Aborting iteration.\n");
+					return false;
+				}
+
+			//	compute new beta and alpha
+				const number rhoNew = prods[iRho];
+				beta = (alpha/omega) * (rhoNew/rho);
+				alpha = rhoNew / (prods[iR0W] + beta*prods[iR0S]
+				                  - beta*omega*prods[iR0Z]);
+				rho = rhoNew;
+			}
+
+		//	post output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	computes the consistent correction c := M^-1 d (or c := d)
+		bool precondition(vector_type& c, const vector_type& d)
+		{
+			if(preconditioner().valid())
+			{
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("PipeBiCGStab: Cannot apply preconditioner. Aborting.\n");
+					return false;
+				}
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipeBiCGStab: Cannot convert correction to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	computes the unique vector f := A*u
+		void apply_operator(vector_type& f, const vector_type& u)
+		{
+			linear_operator()->apply(f, u);
+			make_unique(f);
+		}
+
+	///	converts a vector to unique storage
+		void make_unique(vector_type& v)
+		{
+			#ifdef UG_PARALLEL
+			if(!v.change_storage_type(PST_UNIQUE))
+				UG_THROW("PipeBiCGStab: Cannot convert vector to unique vector.");
+			#endif
+		}
+
+	///	adjust output of convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_BICGSTAB__ */
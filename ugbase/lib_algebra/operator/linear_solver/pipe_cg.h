@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_CG__
+#define __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_CG__
+
+#include <cmath>
+#include <string>
+
+#include "lib_algebra/operator/interface/operator.h"
+#include "lib_algebra/operator/interface/preconditioned_linear_operator_inverse.h"
+#include "lib_algebra/operator/convergence_check.h"
+#include "common/profiler/profiler.h"
+#include "fused_vec_prod.h"
+#ifdef UG_PARALLEL
+	#include "lib_algebra/parallelization/parallelization.h"
+#endif
+
+namespace ug{
+
+///	the pipelined CG method as a solver for linear operators
+/**
+ * This class implements the pipelined, preconditioned CG - method, which is
+ * mathematically equivalent to CG. All scalar products of one iteration are
+ * computed with one single global reduction, which is overlapped with the
+ * application of the preconditioner and the linear operator. On large process
+ * counts, where the latency of the global reductions dominates the costs of
+ * CG, this results in a significant speedup. The price are four additional
+ * vectors and a slightly reduced attainable accuracy.
+ *
+ * If a StdConvCheck is used, the defect norm is computed within the same
+ * reduction. Please note, that the defect is then checked with a delay of one
+ * iteration, i.e. one additional preconditioner and operator application is
+ * performed compared to CG.
+ *
+ * For detailed description of the algorithm, please refer to:
+ *
+ * - Ghysels, Vanroose, "Hiding global synchronization latency in the
+ *   preconditioned Conjugate Gradient algorithm", Parallel Computing 40 (2014),
+ *   Alg. 3
+ *
+ * \tparam 	TVector		vector type
+ */
+template <typename TVector>
+class PipeCG
+	: public IPreconditionedLinearOperatorInverse<TVector>
+{
+	public:
+	///	Vector type
+		typedef TVector vector_type;
+
+	///	Base type
+		typedef IPreconditionedLinearOperatorInverse<vector_type> base_type;
+
+	protected:
+		using base_type::convergence_check;
+		using base_type::linear_operator;
+		using base_type::preconditioner;
+		using base_type::write_debug;
+
+	public:
+	///	constructors
+		PipeCG() : base_type() {}
+
+		PipeCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond)
+			: base_type ( spPrecond )  {}
+
+		PipeCG(SmartPtr<ILinearIterator<vector_type,vector_type> > spPrecond, SmartPtr<IConvergenceCheck<vector_type> > spConvCheck)
+			: base_type ( spPrecond, spConvCheck)  {}
+
+	///	name of solver
+		virtual const char* name() const {return "PipeCG";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const
+		{
+			if(preconditioner().valid())
+				return preconditioner()->supports_parallel();
+			return true;
+		}
+
+	///	Solve J(u)*x = b, such that x = J(u)^{-1} b
+		virtual bool apply_return_defect(vector_type& x, vector_type& b)
+		{
+			PROFILE_BEGIN_GROUP(PipeCG_apply_return_defect, "CG algebra");
+		//	check parallel storage types
+			#ifdef UG_PARALLEL
+			if(!b.has_storage_type(PST_ADDITIVE) || !x.has_storage_type(PST_CONSISTENT))
+				UG_THROW("PipeCG::apply_return_defect:"
+								"Inadequate storage format of Vectors.");
+			#endif
+
+		// 	rename r as b (for convenience)
+			vector_type& r = b;
+
+		// 	Build defect:  r := b - J(u)*x
+			linear_operator()->apply_sub(r, x);
+
+		// 	create help vectors (hatted vectors are consistent, others additive)
+			SmartPtr<vector_type> spU = x.clone_without_values(); vector_type& u = *spU;
+			SmartPtr<vector_type> spW = r.clone_without_values(); vector_type& w = *spW;
+			SmartPtr<vector_type> spM = x.clone_without_values(); vector_type& m = *spM;
+			SmartPtr<vector_type> spN = r.clone_without_values(); vector_type& n = *spN;
+			SmartPtr<vector_type> spP = x.clone_without_values(); vector_type& p = *spP;
+			SmartPtr<vector_type> spQ = x.clone_without_values(); vector_type& q = *spQ;
+			SmartPtr<vector_type> spS = r.clone_without_values(); vector_type& s = *spS;
+			SmartPtr<vector_type> spZ = r.clone_without_values(); vector_type& z = *spZ;
+
+		//	compute start defect
+			prepare_conv_check();
+			convergence_check()->start(r);
+
+		//	the defect norm can be fused into the reduction for the std check
+			StdConvCheck<vector_type>* pStdConvCheck =
+				dynamic_cast<StdConvCheck<vector_type>*>(convergence_check().get());
+
+		// 	u := M^-1 r,  w := A u
+			if(!precondition(u, r)) return false;
+			linear_operator()->apply(w, u);
+
+			number gammaOld = 0.0, alphaOld = 0.0;
+			FusedVecProd<vector_type> prods;
+
+		// 	Iteration loop
+			for(size_t iter = 0; !convergence_check()->iteration_ended(); ++iter)
+			{
+			//	make r unique in order to compute its norm locally
+				#ifdef UG_PARALLEL
+				if(pStdConvCheck && !r.change_storage_type(PST_UNIQUE))
+					UG_THROW("PipeCG::apply_return_defect: "
+									"Cannot convert r to unique vector.");
+				#endif
+
+			//	start reduction of gamma = (r,u), delta = (w,u) and (r,r)
+				prods.clear();
+				const size_t iGamma = prods.add(r, u);
+				const size_t iDelta = prods.add(w, u);
+				const size_t iNorm = pStdConvCheck ? prods.add(r, r) : 0;
+				prods.start();
+
+			//	m := M^-1 w,  n := A m  (overlapped with the reduction)
+				if(!precondition(m, w)) return false;
+				linear_operator()->apply(n, m);
+
+				prods.wait();
+
+			// 	Check convergence of the defect of the last iteration
+				if(iter > 0)
+				{
+					if(pStdConvCheck)
+						pStdConvCheck->update_defect(std::sqrt(prods[iNorm]));
+					else
+						convergence_check()->update(r);
+					if(convergence_check()->iteration_ended()) break;
+				}
+
+				const number gamma = prods[iGamma];
+				const number delta = prods[iDelta];
+
+			//	compute alpha and beta
+				number alpha, beta = 0.0;
+				if(iter == 0) alpha = gamma / delta;
+				else
+				{
+					beta = gamma / gammaOld;
+					alpha = gamma / (delta - beta * gamma / alphaOld);
+				}
+
+			//	check alpha
+				if(alpha == 0.0 || !std::isfinite(alpha))
+				{
+					UG_LOG("ERROR in 'PipeCG::apply_return_defect': alpha=" <<
+					       alpha<< " is not admitted. Aborting solver.\n");
+					return false;
+				}
+
+			//	update directions
+				if(iter == 0)
+				{
+					z = n; q = m; s = w; p = u;
+				}
+				else
+				{
+					VecScaleAdd(z, 1.0, n, beta, z);
+					VecScaleAdd(q, 1.0, m, beta, q);
+					VecScaleAdd(s, 1.0, w, beta, s);
+					VecScaleAdd(p, 1.0, u, beta, p);
+				}
+
+			//	update solution, defect and auxiliary vectors
+				VecScaleAdd(x, 1.0, x, alpha, p);
+				VecScaleAdd(r, 1.0, r, -alpha, s);
+				VecScaleAdd(u, 1.0, u, -alpha, q);
+				VecScaleAdd(w, 1.0, w, -alpha, z);
+
+				gammaOld = gamma; alphaOld = alpha;
+			}
+
+		//	post output
+			return convergence_check()->post();
+		}
+
+	protected:
+	///	computes the consistent correction c := M^-1 d (or c := d)
+		bool precondition(vector_type& c, const vector_type& d)
+		{
+			if(preconditioner().valid())
+			{
+				if(!preconditioner()->apply(c, d))
+				{
+					UG_LOG("ERROR in 'PipeCG::apply_return_defect': "
+							"Cannot apply preconditioner. Aborting.\n");
+					return false;
+				}
+			}
+			else c = d;
+
+			#ifdef UG_PARALLEL
+			if(!c.change_storage_type(PST_CONSISTENT))
+				UG_THROW("PipeCG::apply_return_defect: "
+								"Cannot convert correction to consistent vector.");
+			#endif
+			return true;
+		}
+
+	///	adjust output of convergence check
+		void prepare_conv_check()
+		{
+		//	set iteration symbol and name
+			convergence_check()->set_name(name());
+			convergence_check()->set_symbol('%');
+
+		//	set preconditioner string
+			std::string s;
+			if(preconditioner().valid())
+			  s = std::string(" (Precond: ") + preconditioner()->name() + ")";
+			else
+				s = " (No Preconditioner) ";
+			convergence_check()->set_info(s);
+		}
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_ALGEBRA__OPERATOR__LINEAR_SOLVER__PIPE_CG__ */
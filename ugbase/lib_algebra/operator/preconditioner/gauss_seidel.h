@@ -36,6 +36,7 @@
 #include "lib_algebra/operator/interface/preconditioner.h"
 #include "lib_algebra/algebra_common/core_smoothers.h"
 #include "lib_algebra/algebra_common/sparsematrix_util.h"
+#include "lib_algebra/cpu_algebra/sparsematrix_single.h"
 #ifdef UG_PARALLEL
 	#include "lib_algebra/parallelization/parallelization.h"
 	#include "lib_algebra/parallelization/matrix_overlap.h"
@@ -60,6 +61,9 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 	///	Matrix Operator type
 		typedef typename IPreconditioner<TAlgebra>::matrix_operator_type matrix_operator_type;
 
+	///	Matrix type in single precision
+		typedef SinglePrecisionSparseMatrix<typename matrix_type::value_type> single_matrix_type;
+
 	///	Base type
 		typedef IPreconditioner<TAlgebra> base_type;
 
@@ -73,11 +77,15 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 		GaussSeidelBase() :
 			m_relax(1.0),
 			m_bConsistentInterfaces(false),
-			m_useOverlap(false) {};
+			m_useOverlap(false),
+			m_bMixedPrecision(false),
+			m_bLevelScheduling(false) {};
 
 	/// clone constructor
 		GaussSeidelBase( const GaussSeidelBase<TAlgebra> &parent )
-			: base_type(parent), m_bConsistentInterfaces(parent.m_bConsistentInterfaces)
+			: base_type(parent), m_bConsistentInterfaces(parent.m_bConsistentInterfaces),
+			  m_useOverlap(parent.m_useOverlap), m_bMixedPrecision(parent.m_bMixedPrecision),
+			  m_bLevelScheduling(parent.m_bLevelScheduling)
 		{
 			set_sor_relax(parent.m_relax);
 		}
@@ -90,6 +98,16 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable) {m_useOverlap = enable;}
 
+	///	uses a single precision copy of the matrix for the sweeps
+	/**	Only scalar algebras are reduced, block entries are kept.*/
+		void set_mixed_precision(bool bMixed) {m_bMixedPrecision = bMixed;}
+
+	///	performs the sweeps level by level using several threads
+	/**	Rows which do not depend on each other are grouped into level sets and
+	 * processed in parallel. The result is the same as for the sequential
+	 * sweeps. Requires OpenMP, otherwise the option has no effect.*/
+		void enable_level_scheduling(bool enable) {m_bLevelScheduling = enable;}
+
 		virtual const char* name() const = 0;
 	protected:
 
@@ -135,6 +153,14 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 			THROW_IF_NOT_EQUAL(pA->num_rows(), pA->num_cols());
 //			UG_ASSERT(CheckDiagonalInvertible(A), "GS: A has noninvertible diagonal");
 			UG_COND_THROW(CheckDiagonalInvertible(*pA) == false, name() << ": A has noninvertible diagonal");
+
+		//	single precision copy of the matrix
+			if(m_bMixedPrecision) m_singleA.init(*pA);
+			else m_singleA.clear();
+
+		//	level sets for the threaded sweeps
+			if(m_bLevelScheduling) m_schedule.init(*pA);
+			else m_schedule.clear();
 			return true;
 		}
 
@@ -143,6 +169,19 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax) = 0;
 
+	///	step with the single precision matrix
+		virtual void step(const single_matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			UG_THROW(name() << ": Mixed precision not supported.");
+		}
+
+	///	performs the step with the matrix used for the sweeps
+		void step_mixed(const matrix_type &A, vector_type &c, const vector_type &d)
+		{
+			if(m_bMixedPrecision) step(m_singleA, c, d, m_relax);
+			else step(A, c, d, m_relax);
+		}
+
 	//	Stepping routine
 		virtual bool step(SmartPtr<MatrixOperator<matrix_type, vector_type> > pOp, vector_type& c, const vector_type& d)
 		{
@@ -159,7 +198,7 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 					m_oD.set_storage_type(PST_ADDITIVE);
 					m_oD.change_storage_type(PST_CONSISTENT);
 
-					step(m_A, m_oC, m_oD, m_relax);
+					step_mixed(m_A, m_oC, m_oD);
 
 					for(size_t i = 0; i < c.size(); ++i)
 						c[i] = m_oC[i];
@@ -169,7 +208,7 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 				else if (m_bConsistentInterfaces)
 				{
 					UG_COND_THROW(!d.has_storage_type(PST_ADDITIVE), "Additive or unique defect expected.");
-					step(m_A, c, d, m_relax);
+					step_mixed(m_A, c, d);
 					c.set_storage_type(PST_ADDITIVE);
 				}
 				else
@@ -180,7 +219,7 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 					spDtmp->change_storage_type(PST_UNIQUE);
 
 					THROW_IF_NOT_EQUAL_3(c.size(), spDtmp->size(), m_A.num_rows());
-					step(m_A, c, *spDtmp, m_relax);
+					step_mixed(m_A, c, *spDtmp);
 					c.set_storage_type(PST_UNIQUE);
 				}
 
@@ -194,7 +233,7 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 			{
 				matrix_type &A = *pOp;
 				THROW_IF_NOT_EQUAL_4(c.size(), d.size(), A.num_rows(), A.num_cols());
-				step(A, c, d, m_relax);
+				step_mixed(A, c, d);
 #ifdef UG_PARALLEL
 				c.set_storage_type(PST_CONSISTENT);
 #endif
@@ -217,6 +256,18 @@ class GaussSeidelBase : public IPreconditioner<TAlgebra>
 
 		bool m_bConsistentInterfaces;
 		bool m_useOverlap;
+
+	///	whether the sweeps use the single precision matrix
+		bool m_bMixedPrecision;
+
+	///	matrix in single precision
+		single_matrix_type m_singleA;
+
+	///	whether the sweeps are threaded using level sets
+		bool m_bLevelScheduling;
+
+	///	level sets of the matrix (if level scheduling is used)
+		TriangularLevelSchedule m_schedule;
 };
 
 /// Gauss-Seidel preconditioner for the 'forward' ordering of the dofs
@@ -238,6 +289,7 @@ class GaussSeidel : public GaussSeidelBase<TAlgebra>
 	typedef typename TAlgebra::vector_type vector_type;
 	typedef typename TAlgebra::matrix_type matrix_type;
 	typedef GaussSeidelBase<TAlgebra> base_type;
+	typedef typename base_type::single_matrix_type single_matrix_type;
 
 public:
 	//	Name of preconditioner
@@ -260,7 +312,12 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_LL(A, c, d, relax);
+			gs_step_LL(A, c, d, relax, this->m_schedule);
+		}
+
+		virtual void step(const single_matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			gs_step_LL(A, c, d, relax, this->m_schedule);
 		}
 };
 
@@ -283,6 +340,7 @@ class BackwardGaussSeidel : public GaussSeidelBase<TAlgebra>
 	typedef typename TAlgebra::vector_type vector_type;
 	typedef typename TAlgebra::matrix_type matrix_type;
 	typedef GaussSeidelBase<TAlgebra> base_type;
+	typedef typename base_type::single_matrix_type single_matrix_type;
 
 public:
 	//	Name of preconditioner
@@ -305,7 +363,12 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			gs_step_UR(A, c, d, relax);
+			gs_step_UR(A, c, d, relax, this->m_schedule);
+		}
+
+		virtual void step(const single_matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			gs_step_UR(A, c, d, relax, this->m_schedule);
 		}
 };
 
@@ -317,6 +380,7 @@ class SymmetricGaussSeidel : public GaussSeidelBase<TAlgebra>
 	typedef typename TAlgebra::vector_type vector_type;
 	typedef typename TAlgebra::matrix_type matrix_type;
 	typedef GaussSeidelBase<TAlgebra> base_type;
+	typedef typename base_type::single_matrix_type single_matrix_type;
 
 public:
 	//	Name of preconditioner
@@ -339,7 +403,12 @@ public:
 	//	Stepping routine
 		virtual void step(const matrix_type &A, vector_type &c, const vector_type &d, const number relax)
 		{
-			sgs_step(A, c, d, relax);
+			sgs_step(A, c, d, relax, this->m_schedule);
+		}
+
+		virtual void step(const single_matrix_type &A, vector_type &c, const vector_type &d, const number relax)
+		{
+			sgs_step(A, c, d, relax, this->m_schedule);
 		}
 };
 
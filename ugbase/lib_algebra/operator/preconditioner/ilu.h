@@ -46,6 +46,8 @@
 	#include "lib_algebra/parallelization/overlap_writer.h"
 #endif
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "lib_algebra/cpu_algebra/sparsematrix_single.h"
+#include "lib_algebra/cpu_algebra/level_schedule.h"
 
 namespace ug{
 
@@ -244,6 +246,43 @@ bool invert_L(const Matrix_type &A, Vector_type &x, const Vector_type &b)
 	return true;
 }
 
+// solve x[i] = U(i,i)^-1 b[i] for the last row i of U
+/**	returns true, if the diagonal entry has been found to be near-zero
+ * compared to the rhs. In this case, x[i] is set to zero.*/
+template<typename Matrix_type, typename Vector_type>
+bool invert_U_last_row(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+                       const number eps)
+{
+	const size_t i=x.size()-1;
+	typename Vector_type::value_type s = b[i];
+
+	// check if diag part is significantly smaller than rhs
+	// This may happen when matrix is indefinite with one eigenvalue
+	// zero. In that case, the factorization on the last row is
+	// nearly zero due to round-off errors. In order to allow ill-
+	// scaled matrices (i.e. small matrix entries row-wise) this
+	// is compared to the rhs, that is small in this case as well.
+	if (BlockNorm(A(i,i)) <= eps * BlockNorm(s))
+	{
+		UG_LOG("ILU Warning: Near-zero diagonal entry "
+			"with norm "<<BlockNorm(A(i,i))<<" in last row of U "
+			" with corresponding non-near-zero rhs with norm "
+			<< BlockNorm(s) << ". Setting rhs to zero.\n");
+		UG_LOG("NOTE: Call this method with a smaller 'eps' parameter "
+			   "to avoid this warning. (current eps: " << eps <<
+			   "). If this method is called from the "
+			   "ILU preconditioner class, you may want to call "
+			   "ILU::set_inversion_eps(...) with a smaller threshold.\n")
+		// set correction to zero
+		x[i] = 0;
+		return true;
+	}
+
+	// c[i] = s/uii;
+	InverseMatMult(x[i], 1.0, A(i,i), s);
+	return false;
+}
+
 // solve x = U^-1 * b
 template<typename Matrix_type, typename Vector_type>
 bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
@@ -253,42 +292,11 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 	typedef typename Matrix_type::const_row_iterator const_row_iterator;
 
 	typename Vector_type::value_type s;
-	
-	size_t numNearZero=0;
 
 	// last row diagonal U entry might be close to zero with corresponding close to zero rhs
 	// when solving Navier Stokes system, therefore handle separately
 	if(x.size() > 0)
-	{
-		size_t i=x.size()-1;
-		s = b[i];
-
-		// check if diag part is significantly smaller than rhs
-		// This may happen when matrix is indefinite with one eigenvalue
-		// zero. In that case, the factorization on the last row is
-		// nearly zero due to round-off errors. In order to allow ill-
-		// scaled matrices (i.e. small matrix entries row-wise) this
-		// is compared to the rhs, that is small in this case as well.
-		if (BlockNorm(A(i,i)) <= eps * BlockNorm(s))
-		{
-			if(numNearZero++<5)
-			{	UG_LOG("ILU Warning: Near-zero diagonal entry "
-					"with norm "<<BlockNorm(A(i,i))<<" in last row of U "
-					" with corresponding non-near-zero rhs with norm "
-					<< BlockNorm(s) << ". Setting rhs to zero.\n");
-				UG_LOG("NOTE: Call this method with a smaller 'eps' parameter "
-					   "to avoid this warning. (current eps: " << eps <<
-					   "). If this method is called from the "
-					   "ILU preconditioner class, you may want to call "
-					   "ILU::set_inversion_eps(...) with a smaller threshold.\n")
-			}
-			// set correction to zero
-			x[i] = 0;
-		} else {
-			// c[i] = s/uii;
-			InverseMatMult(x[i], 1.0, A(i,i), s);
-		}
-	}
+		invert_U_last_row(A, x, b, eps);
 	if(x.size() <= 1) return true;
 
 	// handle all other rows
@@ -307,8 +315,87 @@ bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
 		if(i == 0) break;
 	}
 
-	if(numNearZero>=5)
-	{	UG_LOG("...\nILU Warning: " << numNearZero << " ( out of " << x.size() << ") near-zero diagonal entries in last row of U.\n");	}
+	return true;
+}
+
+// solve x = L^-1 b, processing the rows level by level
+/**	The result is identical to invert_L. If the levels of the schedule are too
+ * small for threading, invert_L is used.*/
+template<typename Matrix_type, typename Vector_type>
+bool invert_L(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+              const TriangularLevelSchedule& sched)
+{
+	const int nThreads = sched.num_lower_threads();
+	if(nThreads == 1 || sched.num_rows() != x.size())
+		return invert_L(A, x, b);
+
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+
+	const std::vector<size_t>& vStart = sched.lower_level_start();
+	const std::vector<size_t>& vRow = sched.lower_rows();
+	const size_t numLevels = sched.num_lower_levels();
+
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel num_threads(nThreads))
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		UG_CPU_ALGEBRA_PRAGMA(omp for schedule(static))
+		for(size_t k = vStart[lev]; k < vStart[lev+1]; ++k)
+		{
+			const size_t i = vRow[k];
+			typename Vector_type::value_type s = b[i];
+			for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			{
+				if(it.index() >= i) continue;
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+			}
+			x[i] = s;
+		}
+	}
+
+	return true;
+}
+
+// solve x = U^-1 * b, processing the rows level by level
+/**	The result is identical to invert_U. If the levels of the schedule are too
+ * small for threading, invert_U is used.*/
+template<typename Matrix_type, typename Vector_type>
+bool invert_U(const Matrix_type &A, Vector_type &x, const Vector_type &b,
+			  const number eps, const TriangularLevelSchedule& sched)
+{
+	const int nThreads = sched.num_upper_threads();
+	if(nThreads == 1 || sched.num_rows() != x.size())
+		return invert_U(A, x, b, eps);
+
+	PROFILE_FUNC_GROUP("algebra ILU");
+	typedef typename Matrix_type::const_row_iterator const_row_iterator;
+
+	// the last row has no dependencies and is in the first level
+	const size_t last = x.size()-1;
+	invert_U_last_row(A, x, b, eps);
+
+	const std::vector<size_t>& vStart = sched.upper_level_start();
+	const std::vector<size_t>& vRow = sched.upper_rows();
+	const size_t numLevels = sched.num_upper_levels();
+
+	UG_CPU_ALGEBRA_PRAGMA(omp parallel num_threads(nThreads))
+	for(size_t lev = 0; lev < numLevels; ++lev)
+	{
+		UG_CPU_ALGEBRA_PRAGMA(omp for schedule(static))
+		for(size_t k = vStart[lev]; k < vStart[lev+1]; ++k)
+		{
+			const size_t i = vRow[k];
+			if(i == last) continue;
+
+			typename Vector_type::value_type s = b[i];
+			for(const_row_iterator it = A.begin_row(i); it != A.end_row(i); ++it)
+			{
+				if(it.index() <= i) continue;
+				MatMultAdd(s, 1.0, s, -1.0, it.value(), x[it.index()]);
+			}
+			InverseMatMult(x[i], 1.0, A(i,i), s);
+		}
+	}
 
 	return true;
 }
@@ -383,7 +470,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			m_bSort(false),
 			m_bDisablePreprocessing(false),
 			m_useConsistentInterfaces(false),
-			m_useOverlap(false) {};
+			m_useOverlap(false),
+			m_bMixedPrecision(false),
+			m_bLevelScheduling(false) {};
 
 	/// clone constructor
 		ILU( const ILU<TAlgebra> &parent )
@@ -394,7 +483,9 @@ class ILU : public IPreconditioner<TAlgebra>
 			  m_bSort(parent.m_bSort),
 			  m_bDisablePreprocessing(parent.m_bDisablePreprocessing),
 			  m_useConsistentInterfaces(parent.m_useConsistentInterfaces),
-			  m_useOverlap(parent.m_useOverlap)
+			  m_useOverlap(parent.m_useOverlap),
+			  m_bMixedPrecision(parent.m_bMixedPrecision),
+			  m_bLevelScheduling(parent.m_bLevelScheduling)
 		{	}
 
 	///	Clone
@@ -434,6 +525,17 @@ class ILU : public IPreconditioner<TAlgebra>
 
 		void enable_overlap (bool enable)				{m_useOverlap = enable;}
 
+	///	stores the factors in single precision for the triangular solves
+	/**	The factorization is computed in double precision and converted
+	 * afterwards. Only scalar algebras are reduced, block entries are kept.*/
+		void set_mixed_precision(bool bMixed)			{m_bMixedPrecision = bMixed;}
+
+	///	performs the triangular solves level by level using several threads
+	/**	The rows of the factors are grouped into independent level sets, which
+	 * are processed one after another. The result is the same as for the
+	 * sequential solves. Requires OpenMP, otherwise the option has no effect.*/
+		void enable_level_scheduling(bool enable)		{m_bLevelScheduling = enable;}
+
 	protected:
 	//	Name of preconditioner
 		virtual const char* name() const {return "ILU";}
@@ -535,25 +637,40 @@ class ILU : public IPreconditioner<TAlgebra>
 		//	Debug output of matrices
 			write_debug(m_ILU, "ILU_prep_04_A_AfterFactorize");
 
+		//	single precision copy of the factors
+			if(m_bMixedPrecision) m_singleILU.init(m_ILU);
+			else m_singleILU.clear();
+
+		//	level sets for the threaded triangular solves
+			if(m_bLevelScheduling) m_schedule.init(m_ILU);
+			else m_schedule.clear();
+
 		//	we're done
 			return true;
 		}
 
 
 		void applyLU(vector_type &c, const vector_type &d, vector_type &tmp)
+		{
+			if(m_bMixedPrecision) applyLU(m_singleILU, c, d, tmp);
+			else applyLU(m_ILU, c, d, tmp);
+		}
+
+		template <typename TMatrix>
+		void applyLU(const TMatrix &LU, vector_type &c, const vector_type &d, vector_type &tmp)
 		{	
 			if(!m_bSort || m_bSortIsIdentity)
 			{
 				// 	apply iterator: c = LU^{-1}*d
-				invert_L(m_ILU, tmp, d); // h := L^-1 d
-				invert_U(m_ILU, c, tmp, m_invEps); // c := U^-1 h = (LU)^-1 d
+				invert_L(LU, tmp, d, m_schedule); // h := L^-1 d
+				invert_U(LU, c, tmp, m_invEps, m_schedule); // c := U^-1 h = (LU)^-1 d
 			}
 			else
 			{
 				// we save one vector here by renaming
 				SetVectorAsPermutation(tmp, d, m_newIndex);
-				invert_L(m_ILU, c, tmp); // c = L^{-1} d
-				invert_U(m_ILU, tmp, c, m_invEps); // tmp = (LU)^{-1} d
+				invert_L(LU, c, tmp, m_schedule); // c = L^{-1} d
+				invert_U(LU, tmp, c, m_invEps, m_schedule); // tmp = (LU)^{-1} d
 				SetVectorAsPermutation(c, tmp, m_oldIndex);
 			}
 		}
@@ -642,6 +759,12 @@ class ILU : public IPreconditioner<TAlgebra>
 	///	storage for factorization
 		matrix_type m_ILU;
 
+	///	factorization in single precision (if mixed precision is used)
+		SinglePrecisionSparseMatrix<typename matrix_type::value_type> m_singleILU;
+
+	///	level sets of the factorization (if level scheduling is used)
+		TriangularLevelSchedule m_schedule;
+
 	///	help vector
 		vector_type m_h;
 
@@ -671,6 +794,12 @@ class ILU : public IPreconditioner<TAlgebra>
 
 		bool m_useConsistentInterfaces;
 		bool m_useOverlap;
+
+	///	whether the factors are applied in single precision
+		bool m_bMixedPrecision;
+
+	///	whether the triangular solves are threaded using level sets
+		bool m_bLevelScheduling;
 };
 
 } // end namespace ug
@@ -13,6 +13,7 @@
 
 #include "lib_algebra/algebra_common/vector_util.h"
 #include "lib_algebra/algebra_common/permutation_util.h"
+#include "lib_algebra/cpu_algebra/sparsematrix_single.h"
 
 namespace ug{
 
@@ -50,7 +51,8 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 	public:
 	///	Constructor
 		ILUTPreconditioner(double eps=1e-6)
-			: m_eps(eps), m_info(false), m_bSort(true), m_bSortIsIdentity(false)
+			: m_eps(eps), m_info(false), m_bSort(true), m_bSortIsIdentity(false),
+			  m_bMixedPrecision(false)
 		{};
 
 	/// clone constructor
@@ -61,6 +63,7 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			set_info(parent.m_info);
 			set_sort(parent.m_bSort);
 			m_bSortIsIdentity = parent.m_bSortIsIdentity;
+			m_bMixedPrecision = parent.m_bMixedPrecision;
 		}
 
 	///	Clone
@@ -102,6 +105,12 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			m_bSort = b;
 		}
 
+	///	stores the factors in single precision for the triangular solves
+		void set_mixed_precision(bool bMixed)
+		{
+			m_bMixedPrecision = bMixed;
+		}
+
 
 	protected:
 	//	Name of preconditioner
@@ -314,6 +323,17 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 				m_U.defragment();
 			}
 
+			if(m_bMixedPrecision)
+			{
+				m_singleL.init(m_L);
+				m_singleU.init(m_U);
+			}
+			else
+			{
+				m_singleL.clear();
+				m_singleU.clear();
+			}
+
 			if (m_info==true)
 			{
 				m_L.print("L");
@@ -376,15 +396,22 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 
 
 		virtual bool applyLU(vector_type& c, const vector_type& d)
+		{
+			if(m_bMixedPrecision) return applyLU(m_singleL, m_singleU, c, d);
+			return applyLU(m_L, m_U, c, d);
+		}
+
+		template <typename TMatrixL, typename TMatrixU>
+		bool applyLU(const TMatrixL& L, const TMatrixU& U, vector_type& c, const vector_type& d)
 		{
 			PROFILE_BEGIN_GROUP(ILUT_step, "ilut algebra");
 			// apply iterator: c = LU^{-1}*d (damp is not used)
 			// L
-			for(size_t i=0; i < m_L.num_rows(); i++)
+			for(size_t i=0; i < L.num_rows(); i++)
 			{
 				// c[i] = d[i] - m_L[i]*c;
 				c[i] = d[i];
-				for(matrix_row_iterator it = m_L.begin_row(i); it != m_L.end_row(i); ++it)
+				for(typename TMatrixL::const_row_iterator it = L.begin_row(i); it != L.end_row(i); ++it)
 					MatMultAdd(c[i], 1.0, c[i], -1.0, it.value(), c[it.index()] );
 				// lii = 1.0.
 			}
@@ -393,13 +420,13 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			//
 			// last row diagonal U entry might be close to zero with corresponding zero rhs 
 			// when solving Navier Stokes system, therefore handle separately
-			if(m_U.num_rows() > 0)
+			if(U.num_rows() > 0)
 			{
-				size_t i=m_U.num_rows()-1;
-				matrix_row_iterator it = m_U.begin_row(i);
-				UG_ASSERT(it != m_U.end_row(i), i);
+				size_t i=U.num_rows()-1;
+				typename TMatrixU::const_row_iterator it = U.begin_row(i);
+				UG_ASSERT(it != U.end_row(i), i);
 				UG_ASSERT(it.index() == i, i);
-				block_type &uii = it.value();
+				const typename TMatrixU::value_type &uii = it.value();
 				vector_value s = c[i];
 				// check if diag part is significantly smaller than rhs
 				// This may happen when matrix is indefinite with one eigenvalue
@@ -421,24 +448,26 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 			}
 
 			// handle all other rows
-			if(m_U.num_rows() > 1){
-				for(size_t i=m_U.num_rows()-2; ; i--)
+			if(U.num_rows() > 1){
+				for(size_t i=U.num_rows()-2; ; i--)
 				{
-					matrix_row_iterator it = m_U.begin_row(i);
-					UG_ASSERT(it != m_U.end_row(i), i);
+					typename TMatrixU::const_row_iterator it = U.begin_row(i);
+					UG_ASSERT(it != U.end_row(i), i);
 					UG_ASSERT(it.index() == i, i);
-					block_type &uii = it.value();
+					const typename TMatrixU::value_type &uii = it.value();
 
 					vector_value s = c[i];
 					++it; // skip diag
-					for(; it != m_U.end_row(i); ++it)
+					for(; it != U.end_row(i); ++it)
+					{
 						// s -= it.value() * c[it.index()];
 						MatMultAdd(s, 1.0, s, -1.0, it.value(), c[it.index()] );
+					}
 
-						// c[i] = s/uii;
-						InverseMatMult(c[i], 1.0, uii, s);
+					// c[i] = s/uii;
+					InverseMatMult(c[i], 1.0, uii, s);
 
-						if(i==0) break;
+					if(i==0) break;
 				}
 			}
 			return true;
@@ -534,6 +563,7 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 		vector_type c2;
 		matrix_type m_L;
 		matrix_type m_U;
+		SinglePrecisionSparseMatrix<block_type> m_singleL, m_singleU;
 		double m_eps;
 		bool m_info;
 		static const number m_small;
@@ -541,6 +571,7 @@ class ILUTPreconditioner : public IPreconditioner<TAlgebra>
 		bool m_bSort;
 
 		bool m_bSortIsIdentity;
+		bool m_bMixedPrecision;
 };
 
 // define constant
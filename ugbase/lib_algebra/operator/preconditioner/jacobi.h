@@ -39,6 +39,7 @@
 
 #ifdef UG_PARALLEL
 	#include "lib_algebra/parallelization/parallelization.h"
+	#include "pcl/pcl_layout_util.h"
 #endif
 
 namespace ug{
@@ -188,6 +189,21 @@ class Jacobi : public IPreconditioner<TAlgebra>
 			if(diag.size() > 0)
 				if(CheckVectorInvertible(diag) == false)
 					return false;
+
+		//	split the rows into interface and inner rows for the split-phase step
+			std::vector<bool> vIsInterface(size, false);
+			std::vector<size_t> vIndex;
+			pcl::CollectElements(vIndex, mat.layouts()->master());
+			pcl::CollectElements(vIndex, mat.layouts()->slave(), false);
+			for(size_t k = 0; k < vIndex.size(); ++k)
+				vIsInterface[vIndex[k]] = true;
+
+			m_vInterfaceIndex.clear();
+			m_vInnerIndex.clear();
+			for(size_t i = 0; i < size; ++i){
+				if(vIsInterface[i]) m_vInterfaceIndex.push_back(i);
+				else m_vInnerIndex.push_back(i);
+			}
 //			UG_ASSERT(CheckVectorInvertible(diag), "Jacobi: A has noninvertible diagonal");
 
 #endif
@@ -222,6 +238,31 @@ class Jacobi : public IPreconditioner<TAlgebra>
 		{
 			PROFILE_BEGIN_GROUP(Jacobi_step, "algebra Jacobi");
 
+#ifdef UG_PARALLEL
+		//	split-phase: the interface rows are computed first and sent to the
+		//	masters while the inner rows are computed
+			if(!m_vInterfaceIndex.empty()
+				&& m_vInterfaceIndex.size() + m_vInnerIndex.size() == c.size()
+				&& c.layouts().get() == pOp->layouts().get())
+			{
+				for(size_t k = 0; k < m_vInterfaceIndex.size(); ++k){
+					const size_t i = m_vInterfaceIndex[k];
+					MatMult(c[i], 1.0, m_diagInv[i], d[i]);
+				}
+
+				c.set_storage_type(PST_ADDITIVE);
+				c.begin_additive_to_consistent();
+
+				for(size_t k = 0; k < m_vInnerIndex.size(); ++k){
+					const size_t i = m_vInnerIndex[k];
+					MatMult(c[i], 1.0, m_diagInv[i], d[i]);
+				}
+
+				c.finish_additive_to_consistent();
+				return true;
+			}
+#endif
+
 		// 	multiply defect with diagonal, c = damp * D^{-1} * d
 		//	note, that the damping is already included in the inverse diagonal
 			for(size_t i = 0; i < m_diagInv.size(); ++i)
@@ -306,6 +347,12 @@ class Jacobi : public IPreconditioner<TAlgebra>
 		std::vector<inverse_type> m_diagInv;
 		bool m_bBlock;
 
+#ifdef UG_PARALLEL
+	///	rows contained in the horizontal layouts and all other rows
+		std::vector<size_t> m_vInterfaceIndex;
+		std::vector<size_t> m_vInnerIndex;
+#endif
+
 
 };
 
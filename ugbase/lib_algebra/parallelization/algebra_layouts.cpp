@@ -37,11 +37,37 @@
 #include "algebra_layouts.h"
 
 #include "common/util/string_util.h"
+#include "common/error.h"
 
 
 namespace ug
 {
 
+HaloExchangePlan& HorizontalAlgebraLayouts::
+halo_plan(HaloPlanType type) const
+{
+	UG_ASSERT(type < NUM_HALO_PLAN_TYPES, "Invalid halo plan type: "<<type);
+
+	SmartPtr<HaloExchangePlan>& spPlan = m_spHaloPlan[type];
+	if(spPlan.invalid())
+	{
+		switch(type)
+		{
+			case HPT_SLAVE_TO_MASTER:
+				spPlan = make_sp(new HaloExchangePlan(slaveLayout, masterLayout));
+				break;
+			case HPT_MASTER_TO_SLAVE:
+				spPlan = make_sp(new HaloExchangePlan(masterLayout, slaveLayout));
+				break;
+			case HPT_SLAVE_OVERLAP_TO_MASTER_OVERLAP:
+				spPlan = make_sp(new HaloExchangePlan(slaveOverlapLayout, masterOverlapLayout));
+				break;
+			default: UG_THROW("Invalid halo plan type: "<<type);
+		}
+	}
+	return *spPlan;
+}
+
 
 std::ostream &operator << (std::ostream &out, const HorizontalAlgebraLayouts &layouts)
 {
@@ -36,6 +36,8 @@
 #ifdef UG_PARALLEL
 #include "pcl/pcl_base.h"
 #include "lib_algebra/parallelization/parallel_index_layout.h"
+#include "lib_algebra/parallelization/halo_exchange.h"
+#include "common/util/smart_pointer.h"
 #endif
 
 namespace ug{
@@ -53,6 +55,30 @@ class HorizontalAlgebraLayouts
 		void clear()
 		{
 			masterLayout.clear();			slaveLayout.clear();
+			invalidate_halo_plans();
+		}
+
+	///	types of precompiled halo exchanges
+		enum HaloPlanType
+		{
+			HPT_SLAVE_TO_MASTER = 0,
+			HPT_MASTER_TO_SLAVE,
+			HPT_SLAVE_OVERLAP_TO_MASTER_OVERLAP,
+			NUM_HALO_PLAN_TYPES
+		};
+
+	///	returns the precompiled halo exchange for the layouts (created on demand)
+	/**
+	 * The plans are built on first use and reused by all vectors sharing these
+	 * layouts. Non-const access to one of the layouts discards all plans.
+	 */
+		HaloExchangePlan& halo_plan(HaloPlanType type) const;
+
+	///	discards all precompiled halo exchanges
+		void invalidate_halo_plans() const
+		{
+			for(int i = 0; i < NUM_HALO_PLAN_TYPES; ++i)
+				m_spHaloPlan[i] = SPNULL;
 		}
 
 	public:
@@ -86,10 +112,10 @@ class HorizontalAlgebraLayouts
 	public:
 	/// returns the horizontal slave/master index layout
 	/// \{
-		IndexLayout& master()			{return masterLayout;}
-		IndexLayout& master_overlap() 	{return masterOverlapLayout;}
-		IndexLayout& slave()			{return slaveLayout;}
-		IndexLayout& slave_overlap() 	{return slaveOverlapLayout;}
+		IndexLayout& master()			{invalidate_halo_plans(); return masterLayout;}
+		IndexLayout& master_overlap() 	{invalidate_halo_plans(); return masterOverlapLayout;}
+		IndexLayout& slave()			{invalidate_halo_plans(); return slaveLayout;}
+		IndexLayout& slave_overlap() 	{invalidate_halo_plans(); return slaveOverlapLayout;}
 	/// \}
 
 	///	returns communicator
@@ -114,6 +140,9 @@ class HorizontalAlgebraLayouts
 		pcl::InterfaceCommunicator<IndexLayout> communicator;
 
 		bool m_overlapEnabled;
+
+		///	precompiled halo exchanges
+		mutable SmartPtr<HaloExchangePlan> m_spHaloPlan[NUM_HALO_PLAN_TYPES];
 };
 
 ///	Extends the HorizontalAlgebraLayouts by vertical layouts.
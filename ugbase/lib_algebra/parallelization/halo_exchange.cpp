@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include "halo_exchange.h"
+#include "pcl/pcl_comm_world.h"
+#include "common/error.h"
+
+namespace ug{
+
+///	tag used for all halo exchanges
+static const int HALO_EXCHANGE_TAG = 749346;
+
+///	flattens the interfaces of a layout into procs, offsets and indices
+static void FlattenLayout(const IndexLayout& layout, std::vector<int>& vProc,
+                          std::vector<size_t>& vOffset, std::vector<size_t>& vIndex)
+{
+	vProc.clear(); vIndex.clear();
+	vOffset.assign(1, 0);
+
+	for(IndexLayout::const_iterator iiter = layout.begin();
+		iiter != layout.end(); ++iiter)
+	{
+		const IndexLayout::Interface& interface = layout.interface(iiter);
+		if(interface.size() == 0) continue;
+
+		for(IndexLayout::Interface::const_iterator iter = interface.begin();
+			iter != interface.end(); ++iter)
+			vIndex.push_back(interface.get_element(iter));
+
+		vProc.push_back(layout.proc_id(iiter));
+		vOffset.push_back(vIndex.size());
+	}
+}
+
+HaloExchangePlan::
+HaloExchangePlan(const IndexLayout& sendLayout, const IndexLayout& recvLayout)
+	: m_entrySize(0)
+{
+	FlattenLayout(sendLayout, m_vSendProc, m_vSendOffset, m_vSendIndex);
+	FlattenLayout(recvLayout, m_vRecvProc, m_vRecvOffset, m_vRecvIndex);
+}
+
+HaloExchangePlan::~HaloExchangePlan()
+{
+	free_requests();
+}
+
+void HaloExchangePlan::free_requests()
+{
+//	requests can only be freed as long as mpi is alive
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+
+	if(!finalized)
+		for(size_t i = 0; i < m_vRequest.size(); ++i)
+			if(m_vRequest[i] != MPI_REQUEST_NULL)
+				MPI_Request_free(&m_vRequest[i]);
+
+	m_vRequest.clear();
+	m_entrySize = 0;
+}
+
+void HaloExchangePlan::prepare(size_t entrySize)
+{
+	if(entrySize == m_entrySize) return;
+
+	PROFILE_BEGIN_GROUP(HaloExchangePlan_prepare, "algebra parallelization");
+	free_requests();
+
+//	allocate buffers
+	const size_t numDoublePerEntry = (entrySize + sizeof(double) - 1) / sizeof(double);
+	m_vSendBuffer.resize(m_vSendIndex.size() * numDoublePerEntry);
+	m_vRecvBuffer.resize(m_vRecvIndex.size() * numDoublePerEntry);
+
+//	create persistent requests. Entries are stored densely in the buffers
+	m_vRequest.resize(m_vSendProc.size() + m_vRecvProc.size(), MPI_REQUEST_NULL);
+	char* sendBuf = reinterpret_cast<char*>(m_vSendBuffer.empty() ? NULL : &m_vSendBuffer.front());
+	char* recvBuf = reinterpret_cast<char*>(m_vRecvBuffer.empty() ? NULL : &m_vRecvBuffer.front());
+
+	for(size_t i = 0; i < m_vSendProc.size(); ++i)
+	{
+		const size_t num = m_vSendOffset[i+1] - m_vSendOffset[i];
+		if(MPI_Send_init(sendBuf + m_vSendOffset[i] * entrySize, (int)(num * entrySize),
+		                 MPI_BYTE, m_vSendProc[i], HALO_EXCHANGE_TAG,
+		                 PCL_COMM_WORLD, &m_vRequest[i]) != MPI_SUCCESS)
+			UG_THROW("HaloExchangePlan: Cannot create send request to proc "
+					 << m_vSendProc[i]);
+	}
+
+	const size_t recvStart = m_vSendProc.size();
+	for(size_t i = 0; i < m_vRecvProc.size(); ++i)
+	{
+		const size_t num = m_vRecvOffset[i+1] - m_vRecvOffset[i];
+		if(MPI_Recv_init(recvBuf + m_vRecvOffset[i] * entrySize, (int)(num * entrySize),
+		                 MPI_BYTE, m_vRecvProc[i], HALO_EXCHANGE_TAG,
+		                 PCL_COMM_WORLD, &m_vRequest[recvStart + i]) != MPI_SUCCESS)
+			UG_THROW("HaloExchangePlan: Cannot create receive request from proc "
+					 << m_vRecvProc[i]);
+	}
+
+	m_entrySize = entrySize;
+}
+
+void HaloExchangePlan::start()
+{
+	if(m_vRequest.empty()) return;
+	MPI_Startall((int)m_vRequest.size(), &m_vRequest.front());
+}
+
+void HaloExchangePlan::wait()
+{
+	if(m_vRequest.empty()) return;
+	PROFILE_BEGIN_GROUP(HaloExchangePlan_wait, "algebra parallelization");
+	MPI_Waitall((int)m_vRequest.size(), &m_vRequest.front(), MPI_STATUSES_IGNORE);
+}
+
+} // end namespace ug
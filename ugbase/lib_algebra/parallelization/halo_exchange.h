@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG4__LIB_ALGEBRA__PARALLELIZATION__HALO_EXCHANGE__
+#define __H__UG4__LIB_ALGEBRA__PARALLELIZATION__HALO_EXCHANGE__
+
+#ifdef UG_PARALLEL
+
+#include <vector>
+#include "pcl/pcl_base.h"
+#include "lib_algebra/parallelization/parallel_index_layout.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+///	operation applied to the received values of a halo exchange
+enum HaloExchangeOperation
+{
+	HEO_COPY = 0,		///< receiver := sender
+	HEO_ADD,			///< receiver += sender
+	HEO_ADD_SET_ZERO	///< receiver += sender, sender := 0
+};
+
+///	precompiled exchange of vector values from one index layout to another
+/**
+ * The ComPol_Vec* policies together with an InterfaceCommunicator serialize
+ * the values into BinaryBuffers and post new non-blocking sends and receives
+ * on every call. For the frequent storage type changes of parallel vectors,
+ * this setup costs more than the actual transfer on large process counts.
+ *
+ * A HaloExchangePlan is built once for a pair of layouts. It flattens the
+ * interface indices into contiguous gather and scatter arrays, allocates one
+ * contiguous send and receive buffer and creates persistent MPI requests
+ * (MPI_Send_init / MPI_Recv_init) on these buffers. An exchange then only
+ * consists of a gather loop, MPI_Startall, MPI_Waitall and a scatter loop.
+ *
+ * Since the entries of both interfaces of a process pair are ordered
+ * identically on both processes, no communication is needed to build a plan.
+ *
+ * The plan can be used for all vectors whose entries have a static size
+ * (cf. block_traits::is_static). The persistent requests are recreated if the
+ * size of the entries changes between two calls.
+ */
+class HaloExchangePlan
+{
+	public:
+	///	builds the plan for a transfer from sendLayout to recvLayout
+		HaloExchangePlan(const IndexLayout& sendLayout, const IndexLayout& recvLayout);
+
+	///	frees the persistent requests
+		~HaloExchangePlan();
+
+	///	exchanges the values of a vector with static block size
+	/**
+	 * The values of the vector in the indices of the send layout are
+	 * transferred to the indices of the receive layout, where they are
+	 * processed according to the passed operation.
+	 */
+		template <typename TVector>
+		void exchange(TVector& v, HaloExchangeOperation op);
+
+	///	starts an exchange without waiting for its completion
+	/**
+	 * Gathers the send values and starts the persistent requests. Until
+	 * finish_exchange is called with the same vector and operation, entries
+	 * of the vector that are not contained in the receive layout may be used
+	 * in computations. Only one exchange per plan may be in progress.
+	 */
+		template <typename TVector>
+		void begin_exchange(TVector& v, HaloExchangeOperation op);
+
+	///	waits for an exchange started by begin_exchange and scatters the values
+		template <typename TVector>
+		void finish_exchange(TVector& v, HaloExchangeOperation op);
+
+	///	returns the number of neighbor processes
+		size_t num_neighbors() const {return m_vSendProc.size() + m_vRecvProc.size();}
+
+	protected:
+	///	(re)creates the buffers and persistent requests for an entry size
+		void prepare(size_t entrySize);
+
+	///	starts all persistent requests
+		void start();
+
+	///	waits for all persistent requests
+		void wait();
+
+	///	frees all persistent requests
+		void free_requests();
+
+	protected:
+	///	gather and scatter indices (concatenated for all interfaces)
+		std::vector<size_t> m_vSendIndex, m_vRecvIndex;
+
+	///	neighbor procs and offsets into the index arrays (size: #procs+1)
+		std::vector<int> m_vSendProc, m_vRecvProc;
+		std::vector<size_t> m_vSendOffset, m_vRecvOffset;
+
+	///	contiguous buffers (double in order to ensure alignment)
+		std::vector<double> m_vSendBuffer, m_vRecvBuffer;
+
+	///	persistent requests (sends first, then receives)
+		std::vector<MPI_Request> m_vRequest;
+
+	///	entry size the requests have been created for
+		size_t m_entrySize;
+
+	private:
+	//	plans are not copyable, since requests refer to the own buffers
+		HaloExchangePlan(const HaloExchangePlan&);
+		HaloExchangePlan& operator=(const HaloExchangePlan&);
+};
+
+
+template <typename TVector>
+void HaloExchangePlan::exchange(TVector& v, HaloExchangeOperation op)
+{
+	PROFILE_BEGIN_GROUP(HaloExchangePlan_exchange, "algebra parallelization");
+	begin_exchange(v, op);
+	finish_exchange(v, op);
+}
+
+template <typename TVector>
+void HaloExchangePlan::begin_exchange(TVector& v, HaloExchangeOperation op)
+{
+	typedef typename TVector::value_type value_type;
+
+	prepare(sizeof(value_type));
+
+//	gather send values
+	if(!m_vSendIndex.empty())
+	{
+		value_type* sendBuf = reinterpret_cast<value_type*>(&m_vSendBuffer.front());
+		const size_t* ind = &m_vSendIndex.front();
+		const size_t num = m_vSendIndex.size();
+		for(size_t i = 0; i < num; ++i)
+			sendBuf[i] = v[ind[i]];
+
+		if(op == HEO_ADD_SET_ZERO)
+			for(size_t i = 0; i < num; ++i)
+				v[ind[i]] *= 0;
+	}
+
+	start();
+}
+
+template <typename TVector>
+void HaloExchangePlan::finish_exchange(TVector& v, HaloExchangeOperation op)
+{
+	typedef typename TVector::value_type value_type;
+
+	wait();
+
+//	scatter received values
+	if(!m_vRecvIndex.empty())
+	{
+		const value_type* recvBuf = reinterpret_cast<const value_type*>(&m_vRecvBuffer.front());
+		const size_t* ind = &m_vRecvIndex.front();
+		const size_t num = m_vRecvIndex.size();
+		if(op == HEO_COPY)
+			for(size_t i = 0; i < num; ++i)
+				v[ind[i]] = recvBuf[i];
+		else
+			for(size_t i = 0; i < num; ++i)
+				v[ind[i]] += recvBuf[i];
+	}
+}
+
+} // end namespace ug
+
+#endif /* UG_PARALLEL */
+
+#endif /* __H__UG4__LIB_ALGEBRA__PARALLELIZATION__HALO_EXCHANGE__ */
@@ -113,6 +113,19 @@ class ParallelVector : public TVector
 	/// changes to the requested storage type if possible
 		bool change_storage_type(ParallelStorageType type);
 
+	///	starts changing the storage type from additive to consistent
+	/**
+	 * Only the transfer of the slave values to the masters is started, so that
+	 * computations on the inner entries can overlap with the communication.
+	 * Until finish_additive_to_consistent() is called, entries contained in
+	 * the horizontal layouts must not be accessed and no other storage type
+	 * change may take place on vectors sharing the layouts.
+	 */
+		void begin_additive_to_consistent();
+
+	///	completes the change started by begin_additive_to_consistent
+		void finish_additive_to_consistent();
+
 	/// returns if the current storage type has a given representation
 	/**	type may be any or-combination of constants enumerated in ug::ParallelStorageType.*/
 		bool has_storage_type(uint type) const
@@ -184,6 +197,17 @@ class ParallelVector : public TVector
 		/// virtual clone using covariant return type excluding values
 		virtual this_type* virtual_clone_without_values() const;
 
+	///	halo exchanges used by change_storage_type
+	/**
+	 * For entries of static size the precompiled halo exchanges of the layouts
+	 * are used, otherwise the communication policies.
+	 * \{ */
+		void additive_to_consistent();
+		void unique_to_consistent();
+		void additive_to_unique();
+		void copy_overlap();
+	/// \}
+
 	private:
 	// 	type of storage  (i.e. consistent, additiv, additiv unique)
 	//	holds or-combiation of constants enumerated in ug::ParallelStorageType.
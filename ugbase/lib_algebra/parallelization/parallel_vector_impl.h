@@ -138,15 +138,13 @@ change_storage_type(ParallelStorageType type)
 		case PST_CONSISTENT:
 			if(has_storage_type(PST_UNIQUE)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTUnique2Consistent);
-				UniqueToConsistent(this, layouts()->master(), layouts()->slave(),
-				                   &layouts()->comm());
+				unique_to_consistent();
 				set_storage_type(PST_CONSISTENT);
 				PARVEC_PROFILE_END(); //ParVec_CSTUnique2Consistent
 			}
 			else if(has_storage_type(PST_ADDITIVE)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTAdditive2Consistent);
-				AdditiveToConsistent(this, layouts()->master(), layouts()->slave(),
-				                     &layouts()->comm());
+				additive_to_consistent();
 				set_storage_type(PST_CONSISTENT);
 				PARVEC_PROFILE_END(); //ParVec_CSTAdditive2Consistent
 			}
@@ -154,8 +152,7 @@ change_storage_type(ParallelStorageType type)
 
 			if(layouts()->overlap_enabled()){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTAdditive2Consistent_CopyOverlap);
-				CopyValues(this, layouts()->slave_overlap(),
-				           layouts()->master_overlap(), &layouts()->comm());
+				copy_overlap();
 			}
 
 			break;
@@ -182,15 +179,12 @@ change_storage_type(ParallelStorageType type)
 			if(has_storage_type(PST_ADDITIVE)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTAdditive2Unique);
 				if(layouts()->overlap_enabled()){
-					AdditiveToConsistent(this, layouts()->master(), layouts()->slave(),
-				                     	 &layouts()->comm());
-					CopyValues(this, layouts()->slave_overlap(),
-				           	   layouts()->master_overlap(), &layouts()->comm());
+					additive_to_consistent();
+					copy_overlap();
 					ConsistentToUnique(this, layouts()->slave());
 				}
 				else{
-					AdditiveToUnique(this, layouts()->master(), layouts()->slave(),
-					                 &layouts()->comm());
+					additive_to_unique();
 				}
 				add_storage_type(PST_UNIQUE);
 				PARVEC_PROFILE_END(); //ParVec_CSTAdditive2Unique
@@ -198,8 +192,7 @@ change_storage_type(ParallelStorageType type)
 			else if(has_storage_type(PST_CONSISTENT)){
 				PARVEC_PROFILE_BEGIN(ParVec_CSTConsistent2Unique);
 				if(layouts()->overlap_enabled()){
-					CopyValues(this, layouts()->slave_overlap(),
-				           	   layouts()->master_overlap(), &layouts()->comm());
+					copy_overlap();
 				}
 				ConsistentToUnique(this, layouts()->slave());
 				set_storage_type(PST_ADDITIVE);
@@ -217,6 +210,104 @@ change_storage_type(ParallelStorageType type)
 	return true;
 }
 
+template <typename TVector>
+void
+ParallelVector<TVector>::
+begin_additive_to_consistent()
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+
+	if(has_storage_type(PST_CONSISTENT) || has_storage_type(PST_UNIQUE))
+		return;
+
+	if(!has_storage_type(PST_ADDITIVE))
+		UG_THROW("ParallelVector::begin_additive_to_consistent: Vector "
+				 "must be additive.");
+
+	if(layouts().invalid())
+		UG_THROW("ParallelVector::begin_additive_to_consistent: No "
+					"layouts given but trying to change type.")
+
+//	variable sized entries are communicated at once in the finish step
+	if(block_traits<value_type>::is_static)
+		layouts()->halo_plan(AlgebraLayouts::HPT_SLAVE_TO_MASTER).begin_exchange(*this, HEO_ADD);
+}
+
+template <typename TVector>
+void
+ParallelVector<TVector>::
+finish_additive_to_consistent()
+{
+	PROFILE_FUNC_GROUP("algebra parallelization");
+
+	if(has_storage_type(PST_CONSISTENT))
+		return;
+
+	if(has_storage_type(PST_UNIQUE))
+		unique_to_consistent();
+	else if(block_traits<value_type>::is_static){
+		layouts()->halo_plan(AlgebraLayouts::HPT_SLAVE_TO_MASTER).finish_exchange(*this, HEO_ADD);
+		layouts()->halo_plan(AlgebraLayouts::HPT_MASTER_TO_SLAVE).exchange(*this, HEO_COPY);
+	}
+	else
+		AdditiveToConsistent(this, layouts()->master(), layouts()->slave(),
+		                     &layouts()->comm());
+	set_storage_type(PST_CONSISTENT);
+
+	if(layouts()->overlap_enabled())
+		copy_overlap();
+}
+
+template <typename TVector>
+void
+ParallelVector<TVector>::
+additive_to_consistent()
+{
+	if(block_traits<value_type>::is_static){
+		layouts()->halo_plan(AlgebraLayouts::HPT_SLAVE_TO_MASTER).exchange(*this, HEO_ADD);
+		layouts()->halo_plan(AlgebraLayouts::HPT_MASTER_TO_SLAVE).exchange(*this, HEO_COPY);
+	}
+	else
+		AdditiveToConsistent(this, layouts()->master(), layouts()->slave(),
+		                     &layouts()->comm());
+}
+
+template <typename TVector>
+void
+ParallelVector<TVector>::
+unique_to_consistent()
+{
+	if(block_traits<value_type>::is_static)
+		layouts()->halo_plan(AlgebraLayouts::HPT_MASTER_TO_SLAVE).exchange(*this, HEO_COPY);
+	else
+		UniqueToConsistent(this, layouts()->master(), layouts()->slave(),
+		                   &layouts()->comm());
+}
+
+template <typename TVector>
+void
+ParallelVector<TVector>::
+additive_to_unique()
+{
+	if(block_traits<value_type>::is_static)
+		layouts()->halo_plan(AlgebraLayouts::HPT_SLAVE_TO_MASTER).exchange(*this, HEO_ADD_SET_ZERO);
+	else
+		AdditiveToUnique(this, layouts()->master(), layouts()->slave(),
+		                 &layouts()->comm());
+}
+
+template <typename TVector>
+void
+ParallelVector<TVector>::
+copy_overlap()
+{
+	if(block_traits<value_type>::is_static)
+		layouts()->halo_plan(AlgebraLayouts::HPT_SLAVE_OVERLAP_TO_MASTER_OVERLAP).exchange(*this, HEO_COPY);
+	else
+		CopyValues(this, layouts()->slave_overlap(),
+		           layouts()->master_overlap(), &layouts()->comm());
+}
+
 template <typename TVector>
 void
 ParallelVector<TVector>::
@@ -429,6 +520,7 @@ inline void VecScaleAssign(ParallelVector<T> &dest,
 {
 	PROFILE_FUNC_GROUP("algebra");
 	dest.set_storage_type(v1.get_storage_mask());
+//	resolves to the (threaded) overload of the local vector type T
 	VecScaleAssign(*dynamic_cast<T*>(&dest), alpha1, *dynamic_cast<const T*>(&v1));
 }
 
@@ -440,6 +532,7 @@ inline void VecAssign(ParallelVector<T> &dest,
 {
 	PROFILE_FUNC_GROUP("algebra");
 	dest.set_storage_type(v1.get_storage_mask());
+//	resolves to the (threaded) overload of the local vector type T
 	VecAssign(*dynamic_cast<T*>(&dest), *dynamic_cast<const T*>(&v1));
 }
 
@@ -59,6 +59,12 @@ inline number BlockNorm(const number &a)
 	return a>0 ? a : -a;
 }
 
+template <>
+inline number BlockNorm(const float &a)
+{
+	return a>0 ? a : -a;
+}
+
 template<typename T> number BlockNorm2(const T &t);
 template <>
 inline number BlockNorm2(const number &a)
@@ -66,6 +72,12 @@ inline number BlockNorm2(const number &a)
 	return a*a;
 }
 
+template <>
+inline number BlockNorm2(const float &a)
+{
+	return (number)a*a;
+}
+
 //////////////////////////////////////////////////////
 // get/set specialization for numbers
 
@@ -57,26 +57,35 @@ class LocalIndices
 
 	public:
 	///	Default Constructor
-		LocalIndices() {};
+		LocalIndices() : m_numFct(0) {};
 
 	///	sets the number of functions
+	/**
+	 * The per-function index arrays are never released, such that refilling
+	 * the indices for the next element reuses the memory of the previous one.
+	 */
 		void resize_fct(size_t numFct)
 		{
-			m_vvIndex.resize(numFct);
-			m_vLFEID.resize(numFct);
+			if(numFct > m_vvIndex.size()){
+				m_vvIndex.resize(numFct);
+				m_vLFEID.resize(numFct);
+			}
+			for(size_t fct = m_numFct; fct < numFct; ++fct)
+				m_vvIndex[fct].clear();
+			m_numFct = numFct;
 		}
 
 	///	sets the local finite element id for a function
 		void set_lfeID(size_t fct, const LFEID& lfeID)
 		{
-			UG_ASSERT(fct < m_vLFEID.size(), "Invalid index: "<<fct);
+			UG_ASSERT(fct < num_fct(), "Invalid index: "<<fct);
 			m_vLFEID[fct] = lfeID;
 		}
 
 	///	returns the local finite element id of a function
 		const LFEID& local_finite_element_id(size_t fct) const
 		{
-			UG_ASSERT(fct < m_vLFEID.size(), "Invalid index: "<<fct);
+			UG_ASSERT(fct < num_fct(), "Invalid index: "<<fct);
 			return m_vLFEID[fct];
 		}
 
@@ -108,10 +117,10 @@ class LocalIndices
 		}
 
 	///	clears all fct
-		void clear() {m_vvIndex.clear();}
+		void clear() {m_numFct = 0;}
 
 	///	number of functions
-		size_t num_fct() const {return m_vvIndex.size();}
+		size_t num_fct() const {return m_numFct;}
 
 	/// number of dofs for accessible function
 		size_t num_dof(size_t fct) const
@@ -177,13 +186,23 @@ class LocalIndices
 		}
 
 	protected:
-	// 	Mapping (fct, dof) -> local index
+	//	number of functions currently in use
+		size_t m_numFct;
+
+	// 	Mapping (fct, dof) -> local index (only first m_numFct used)
 		std::vector<std::vector<DoFIndex> > m_vvIndex;
 
 	//	Local finite element ids
 		std::vector<LFEID> m_vLFEID;
 };
 
+/// local vector of dof values for the currently considered element
+/**
+ * The values of all functions are stored in one plain array, the dofs of
+ * function fct starting at m_vOffset[fct]. Resizing only grows the
+ * underlying storage, so that an element loop reusing the same LocalVector
+ * performs no heap operations once the largest element has been visited.
+ */
 class LocalVector
 {
 	public:
@@ -195,19 +214,24 @@ class LocalVector
 
 	public:
 	///	default Constructor
-		LocalVector() : m_pIndex(NULL) {m_vvValue.clear();}
+		LocalVector() : m_pIndex(NULL), m_pFuncMap(NULL), m_vOffset(1, 0) {}
 
 	///	Constructor
-		LocalVector(const LocalIndices& ind) {resize(ind);}
+		LocalVector(const LocalIndices& ind)
+			: m_pIndex(NULL), m_pFuncMap(NULL), m_vOffset(1, 0)
+		{
+			resize(ind);
+		}
 
 	///	resize for current local indices
 		void resize(const LocalIndices& ind)
 		{
 			m_pIndex = &ind;
-			m_vvValue.resize(ind.num_fct());
-			m_vvValueAcc.resize(m_vvValue.size());
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				m_vvValue[fct].resize(ind.num_dof(fct));
+			const size_t numFct = ind.num_fct();
+			m_vOffset.resize(numFct + 1);
+			for(size_t fct = 0; fct < numFct; ++fct)
+				m_vOffset[fct+1] = m_vOffset[fct] + ind.num_dof(fct);
+			m_vValue.resize(m_vOffset[numFct]);
 			access_all();
 		}
 
@@ -221,9 +245,8 @@ class LocalVector
 	/// set all components of the vector
 		this_type& operator=(number val)
 		{
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] = val;
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] = val;
 			return *this;
 		}
 
@@ -236,39 +259,35 @@ class LocalVector
 	/// multiply all components of the vector
 		this_type& operator*=(number val)
 		{
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] *= val;
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] *= val;
 			return *this;
 		}
 
 	/// add a local vector
 		this_type& operator+=(const this_type& rhs)
 		{
-			UG_LOCALALGEBRA_ASSERT(m_pIndex==rhs.m_pIndex, "Not same indices.");
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] += rhs.m_vvValue[fct][dof];
+			check_same_layout(rhs);
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] += rhs.m_vValue[i];
 			return *this;
 		}
 
 	/// subtract a local vector
 		this_type& operator-=(const this_type& rhs)
 		{
-			UG_LOCALALGEBRA_ASSERT(m_pIndex==rhs.m_pIndex, "Not same indices.");
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] -= rhs.m_vvValue[fct][dof];
+			check_same_layout(rhs);
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] -= rhs.m_vValue[i];
 			return *this;
 		}
 
 	///	add a scaled vector
 		this_type& scale_append(number s, const this_type& rhs)
 		{
-			UG_LOCALALGEBRA_ASSERT(m_pIndex==rhs.m_pIndex, "Not same indices.");
-			for(size_t fct = 0; fct < m_vvValue.size(); ++fct)
-				for(size_t dof = 0; dof < m_vvValue[fct].size(); ++dof)
-					m_vvValue[fct][dof] += s * rhs.m_vvValue[fct][dof];
+			check_same_layout(rhs);
+			for(size_t i = 0; i < m_vValue.size(); ++i)
+				m_vValue[i] += s * rhs.m_vValue[i];
 			return *this;
 		}
 
@@ -280,28 +299,22 @@ class LocalVector
 		void access_by_map(const FunctionIndexMapping& funcMap)
 		{
 			m_pFuncMap = &funcMap;
+			m_vAccOffset.resize(funcMap.num_fct());
 			for(size_t i = 0; i < funcMap.num_fct(); ++i)
-			{
-				const size_t mapFct = funcMap[i];
-				m_vvValueAcc[i] = &(m_vvValue[mapFct][0]);
-			}
+				m_vAccOffset[i] = m_vOffset[funcMap[i]];
 		}
 
 	///	access all functions
 		void access_all()
 		{
 			m_pFuncMap = NULL;
-
-			if(m_pIndex==NULL) {m_vvValueAcc.clear(); return;}
-
-			for(size_t i = 0; i < m_pIndex->num_fct(); ++i)
-				m_vvValueAcc[i] = &(m_vvValue[i][0]);
+			m_vAccOffset.assign(m_vOffset.begin(), m_vOffset.end() - 1);
 		}
 
 	///	returns the number of currently accessible functions
 		size_t num_fct() const
 		{
-			if(m_pFuncMap == NULL) return m_vvValue.size();
+			if(m_pFuncMap == NULL) return num_all_fct();
 			return m_pFuncMap->num_fct();
 		}
 
@@ -318,22 +331,22 @@ class LocalVector
 		size_t num_dof(size_t fct) const
 		{
 			check_fct(fct);
-			if(m_pFuncMap == NULL) return m_vvValue[fct].size();
-			else return m_vvValue[ (*m_pFuncMap)[fct] ].size();
+			if(m_pFuncMap == NULL) return num_all_dof(fct);
+			else return num_all_dof((*m_pFuncMap)[fct]);
 		}
 
 	/// access to dof of currently accessible function fct
 		number& operator()(size_t fct, size_t dof)
 		{
 			check_dof(fct,dof);
-			return m_vvValueAcc[fct][dof];
+			return m_vValue[m_vAccOffset[fct] + dof];
 		}
 
 	/// const access to dof of currently accessible function fct
 		number operator()(size_t fct, size_t dof) const
 		{
 			check_dof(fct,dof);
-			return m_vvValueAcc[fct][dof];
+			return m_vValue[m_vAccOffset[fct] + dof];
 		}
 
 		///////////////////////////
@@ -341,16 +354,28 @@ class LocalVector
 		///////////////////////////
 
 	///	returns the number of all functions
-		size_t num_all_fct() const {return m_vvValue.size();}
+		size_t num_all_fct() const {return m_vOffset.size() - 1;}
 
 	///	returns the number of dofs for a function (unrestricted functions)
-		size_t num_all_dof(size_t fct) const {check_all_fct(fct); return m_vvValue[fct].size();}
+		size_t num_all_dof(size_t fct) const
+		{
+			check_all_fct(fct);
+			return m_vOffset[fct+1] - m_vOffset[fct];
+		}
 
 	/// access to dof of a fct (unrestricted functions)
-		number& value(size_t fct, size_t dof){check_all_dof(fct,dof);return m_vvValue[fct][dof];}
+		number& value(size_t fct, size_t dof)
+		{
+			check_all_dof(fct,dof);
+			return m_vValue[m_vOffset[fct] + dof];
+		}
 
 	/// const access to dof of a fct (unrestricted functions)
-		const number& value(size_t fct, size_t dof) const{check_all_dof(fct,dof);return m_vvValue[fct][dof];}
+		const number& value(size_t fct, size_t dof) const
+		{
+			check_all_dof(fct,dof);
+			return m_vValue[m_vOffset[fct] + dof];
+		}
 
 	protected:
 	///	checks correct fct index in debug mode
@@ -377,6 +402,13 @@ class LocalVector
 			check_all_fct(fct);
 			UG_LOCALALGEBRA_ASSERT(dof < num_all_dof(fct), "Wrong index.");
 		}
+	///	checks that both vectors have the same layout in debug mode
+		inline void check_same_layout(const this_type& rhs) const
+		{
+			UG_LOCALALGEBRA_ASSERT(m_pIndex==rhs.m_pIndex, "Not same indices.");
+			UG_LOCALALGEBRA_ASSERT(m_vValue.size()==rhs.m_vValue.size(),
+			                       "Not same size.");
+		}
 
 	protected:
 	/// Indices
@@ -385,13 +417,24 @@ class LocalVector
 	/// Access Mapping
 		const FunctionIndexMapping* m_pFuncMap;
 
-	/// Entries (fct, dof)
-		std::vector<value_type*> m_vvValueAcc;
+	///	Offset of first dof of each function (size num_all_fct()+1)
+		std::vector<size_t> m_vOffset;
+
+	///	Offset of first dof of each currently accessible function
+		std::vector<size_t> m_vAccOffset;
 
-	/// Entries (fct, dof)
-		std::vector<std::vector<value_type> > m_vvValue;
+	/// Entries (fct, dof), stored contiguously
+		std::vector<value_type> m_vValue;
 };
 
+/// local matrix of couplings for the currently considered element
+/**
+ * All couplings (rowFct, rowDoF) x (colFct, colDoF) are stored as one dense,
+ * row-major block in a plain array. The row (column) of a dof is given by the
+ * row (column) offset of its function plus the dof number. As for the
+ * LocalVector, resizing only grows the storage, so that the element loop is
+ * free of heap operations once the largest element has been visited.
+ */
 class LocalMatrix
 {
 	public:
@@ -405,12 +448,15 @@ class LocalMatrix
 	///	Constructor
 		LocalMatrix() :
 			m_pRowIndex(NULL), m_pColIndex(NULL) ,
-			m_pRowFuncMap(NULL), m_pColFuncMap(NULL)
+			m_pRowFuncMap(NULL), m_pColFuncMap(NULL),
+			m_vRowOffset(1, 0), m_vColOffset(1, 0)
 		{}
 
 	///	Constructor
 		LocalMatrix(const LocalIndices& rowInd, const LocalIndices& colInd)
-			: m_pRowFuncMap(NULL), m_pColFuncMap(NULL)
+			: m_pRowIndex(NULL), m_pColIndex(NULL),
+			  m_pRowFuncMap(NULL), m_pColFuncMap(NULL),
+			  m_vRowOffset(1, 0), m_vColOffset(1, 0)
 		{
 			resize(rowInd, colInd);
 		}
@@ -424,15 +470,17 @@ class LocalMatrix
 			m_pRowIndex = &rowInd;
 			m_pColIndex = &colInd;
 
-			m_CplMat.resize(rowInd.num_fct(), colInd.num_fct());
-			m_CplMatAcc.resize(rowInd.num_fct(), colInd.num_fct());
+			const size_t numRowFct = rowInd.num_fct();
+			m_vRowOffset.resize(numRowFct + 1);
+			for(size_t fct = 0; fct < numRowFct; ++fct)
+				m_vRowOffset[fct+1] = m_vRowOffset[fct] + rowInd.num_dof(fct);
 
-			for(size_t fct1 = 0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2 = 0; fct2 < m_CplMat.num_cols(); ++fct2)
-				{
-					m_CplMat(fct1, fct2).resize(colInd.num_dof(fct1),
-												rowInd.num_dof(fct2));
-				}
+			const size_t numColFct = colInd.num_fct();
+			m_vColOffset.resize(numColFct + 1);
+			for(size_t fct = 0; fct < numColFct; ++fct)
+				m_vColOffset[fct+1] = m_vColOffset[fct] + colInd.num_dof(fct);
+
+			m_vEntry.resize(m_vRowOffset[numRowFct] * m_vColOffset[numColFct]);
 
 			access_all();
 		}
@@ -450,9 +498,8 @@ class LocalMatrix
 	/// set all entries
 		this_type& operator=(number val)
 		{
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					m_CplMat(fct1,fct2) = val;
+			for(size_t i = 0; i < m_vEntry.size(); ++i)
+				m_vEntry[i] = val;
 			return *this;
 		}
 
@@ -465,42 +512,35 @@ class LocalMatrix
 	/// multiply matrix
 		this_type& operator*=(number val)
 		{
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					m_CplMat(fct1,fct2) *= val;
+			for(size_t i = 0; i < m_vEntry.size(); ++i)
+				m_vEntry[i] *= val;
 			return *this;
 		}
 
 	/// add matrix
 		this_type& operator+=(const this_type& rhs)
 		{
-			UG_LOCALALGEBRA_ASSERT(m_pRowIndex==rhs.m_pRowIndex &&
-			          m_pColIndex==rhs.m_pColIndex, "Not same indices.");
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					m_CplMat(fct1,fct2) += rhs.m_CplMat(fct1,fct2);
+			check_same_layout(rhs);
+			for(size_t i = 0; i < m_vEntry.size(); ++i)
+				m_vEntry[i] += rhs.m_vEntry[i];
 			return *this;
 		}
 
 	/// subtract matrix
 		this_type& operator-=(const this_type& rhs)
 		{
-			UG_LOCALALGEBRA_ASSERT(m_pRowIndex==rhs.m_pRowIndex &&
-			          m_pColIndex==rhs.m_pColIndex, "Not same indices.");
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					m_CplMat(fct1,fct2) -= rhs.m_CplMat(fct1,fct2);
+			check_same_layout(rhs);
+			for(size_t i = 0; i < m_vEntry.size(); ++i)
+				m_vEntry[i] -= rhs.m_vEntry[i];
 			return *this;
 		}
 
 	/// add scaled matrix
 		this_type& scale_append(number s, const this_type& rhs)
 		{
-			UG_LOCALALGEBRA_ASSERT(m_pRowIndex==rhs.m_pRowIndex &&
-					  m_pColIndex==rhs.m_pColIndex, "Not same indices.");
-			for(size_t fct1=0; fct1 < m_CplMat.num_rows(); ++fct1)
-				for(size_t fct2=0; fct2 < m_CplMat.num_cols(); ++fct2)
-					MatScaleAppend(m_CplMat(fct1,fct2), s, rhs.m_CplMat(fct1,fct2));
+			check_same_layout(rhs);
+			for(size_t i = 0; i < m_vEntry.size(); ++i)
+				m_vEntry[i] += s * rhs.m_vEntry[i];
 			return *this;
 		}
 
@@ -521,14 +561,13 @@ class LocalMatrix
 			m_pRowFuncMap = &rowFuncMap;
 			m_pColFuncMap = &colFuncMap;
 
-			for(size_t i = 0; i < m_pRowFuncMap->num_fct(); ++i)
-				for(size_t j = 0; j < m_pColFuncMap->num_fct(); ++j)
-				{
-					const size_t rowMapFct = rowFuncMap[i];
-					const size_t colMapFct = colFuncMap[j];
+			m_vRowAccOffset.resize(rowFuncMap.num_fct());
+			for(size_t i = 0; i < rowFuncMap.num_fct(); ++i)
+				m_vRowAccOffset[i] = m_vRowOffset[rowFuncMap[i]];
 
-					m_CplMatAcc(i,j) = &(m_CplMat(rowMapFct, colMapFct));
-				}
+			m_vColAccOffset.resize(colFuncMap.num_fct());
+			for(size_t j = 0; j < colFuncMap.num_fct(); ++j)
+				m_vColAccOffset[j] = m_vColOffset[colFuncMap[j]];
 		}
 
 	///	access all functions
@@ -537,41 +576,36 @@ class LocalMatrix
 			m_pRowFuncMap = NULL;
 			m_pColFuncMap = NULL;
 
-			if(m_pRowIndex==NULL) {m_CplMatAcc.resize(0,0); return;}
-
-			for(size_t i = 0; i < m_pRowIndex->num_fct(); ++i)
-				for(size_t j = 0; j < m_pColIndex->num_fct(); ++j)
-					m_CplMatAcc(i,j) = &(m_CplMat(i,j));
+			m_vRowAccOffset.assign(m_vRowOffset.begin(), m_vRowOffset.end() - 1);
+			m_vColAccOffset.assign(m_vColOffset.begin(), m_vColOffset.end() - 1);
 		}
 
 	///	returns the number of currently accessible (restricted) functions
 		size_t num_row_fct() const
 		{
 			if(m_pRowFuncMap != NULL) return m_pRowFuncMap->num_fct();
-			return m_CplMatAcc.num_rows();
+			return num_all_row_fct();
 		}
 
 	///	returns the number of currently accessible (restricted) functions
 		size_t num_col_fct() const
 		{
 			if(m_pColFuncMap != NULL) return m_pColFuncMap->num_fct();
-			return m_CplMatAcc.num_cols();
+			return num_all_col_fct();
 		}
 
 	///	returns the number of dofs for the currently accessible (restricted) function
 		size_t num_row_dof(size_t fct) const
 		{
-			if(m_CplMat.num_rows()==0) return 0;
-			if(m_pRowFuncMap == NULL) return m_CplMat(fct, 0).num_rows();
-			else return m_CplMat( (*m_pRowFuncMap)[fct], 0).num_rows();
+			if(m_pRowFuncMap == NULL) return num_all_row_dof(fct);
+			else return num_all_row_dof((*m_pRowFuncMap)[fct]);
 		}
 
 	///	returns the number of dofs for the currently accessible (restricted) function
 		size_t num_col_dof(size_t fct) const
 		{
-			if(m_CplMat.num_cols()==0) return 0;
-			if(m_pRowFuncMap == NULL) return m_CplMat(0, fct).num_cols();
-			else return m_CplMat( 0, (*m_pColFuncMap)[fct]).num_cols();
+			if(m_pColFuncMap == NULL) return num_all_col_dof(fct);
+			else return num_all_col_dof((*m_pColFuncMap)[fct]);
 		}
 
 	/// access to (restricted) coupling (rowFct, rowDoF) x (colFct, colDoF)
@@ -579,7 +613,8 @@ class LocalMatrix
 		                   size_t colFct, size_t colDoF)
 		{
 			check_dof(rowFct, rowDoF, colFct, colDoF);
-			return (*m_CplMatAcc(rowFct,colFct))(rowDoF, colDoF);
+			return m_vEntry[(m_vRowAccOffset[rowFct] + rowDoF) * m_vColOffset.back()
+			                + m_vColAccOffset[colFct] + colDoF];
 		}
 
 	/// const access to (restricted) coupling (rowFct, rowDoF) x (colFct, colDoF)
@@ -587,7 +622,8 @@ class LocalMatrix
 		                        size_t colFct, size_t colDoF) const
 		{
 			check_dof(rowFct, rowDoF, colFct, colDoF);
-			return (*m_CplMatAcc(rowFct,colFct))(rowDoF, colDoF);
+			return m_vEntry[(m_vRowAccOffset[rowFct] + rowDoF) * m_vColOffset.back()
+			                + m_vColAccOffset[colFct] + colDoF];
 		}
 
 		///////////////////////////
@@ -595,23 +631,32 @@ class LocalMatrix
 		///////////////////////////
 
 	///	returns the number of all functions
-		size_t num_all_row_fct() const{	return m_CplMat.num_rows();}
+		size_t num_all_row_fct() const {return m_vRowOffset.size() - 1;}
 
 	///	returns the number of all functions
-		size_t num_all_col_fct() const{return m_CplMat.num_cols();}
+		size_t num_all_col_fct() const {return m_vColOffset.size() - 1;}
 
 	///	returns the number of dofs for a function
-		size_t num_all_row_dof(size_t fct) const {return m_CplMat(fct, 0).num_rows();}
+		size_t num_all_row_dof(size_t fct) const
+		{
+			UG_LOCALALGEBRA_ASSERT(fct < num_all_row_fct(), "Wrong index.");
+			return m_vRowOffset[fct+1] - m_vRowOffset[fct];
+		}
 
 	///	returns the number of dofs for a function
-		size_t num_all_col_dof(size_t fct) const {return m_CplMat(0, fct).num_cols();}
+		size_t num_all_col_dof(size_t fct) const
+		{
+			UG_LOCALALGEBRA_ASSERT(fct < num_all_col_fct(), "Wrong index.");
+			return m_vColOffset[fct+1] - m_vColOffset[fct];
+		}
 
 	/// access to coupling (rowFct, rowDoF) x (colFct, colDoF)
 		number& value(size_t rowFct, size_t rowDoF,
 		              size_t colFct, size_t colDoF)
 		{
 			check_all_dof(rowFct, rowDoF, colFct, colDoF);
-			return (m_CplMat(rowFct,colFct))(rowDoF, colDoF);
+			return m_vEntry[(m_vRowOffset[rowFct] + rowDoF) * m_vColOffset.back()
+			                + m_vColOffset[colFct] + colDoF];
 		}
 
 	/// const access to coupling (rowFct, rowDoF) x (colFct, colDoF)
@@ -619,7 +664,8 @@ class LocalMatrix
 		                   size_t colFct, size_t colDoF) const
 		{
 			check_all_dof(rowFct, rowDoF, colFct, colDoF);
-			return (m_CplMat(rowFct,colFct))(rowDoF, colDoF);
+			return m_vEntry[(m_vRowOffset[rowFct] + rowDoF) * m_vColOffset.back()
+			                + m_vColOffset[colFct] + colDoF];
 		}
 
 	protected:
@@ -651,6 +697,14 @@ class LocalMatrix
 			UG_LOCALALGEBRA_ASSERT(rowDoF < num_all_row_dof(rowFct), "Wrong index.");
 			UG_LOCALALGEBRA_ASSERT(colDoF < num_all_col_dof(colFct), "Wrong index.");
 		}
+	///	checks that both matrices have the same layout in debug mode
+		inline void check_same_layout(const this_type& rhs) const
+		{
+			UG_LOCALALGEBRA_ASSERT(m_pRowIndex==rhs.m_pRowIndex &&
+			          m_pColIndex==rhs.m_pColIndex, "Not same indices.");
+			UG_LOCALALGEBRA_ASSERT(m_vEntry.size()==rhs.m_vEntry.size(),
+			                       "Not same size.");
+		}
 
 	protected:
 	// 	Row indices
@@ -665,22 +719,20 @@ class LocalMatrix
 	/// Column Access Mapping
 		const FunctionIndexMapping* m_pColFuncMap;
 
-	//	\todo: Think of a better (faster) storage (one plain array?)
-
-	//	type of cpl matrices between two functions
-		typedef DenseMatrix<VariableArray2<value_type> > LocalCplMatrix;
+	///	Offset of first row of each function (size num_all_row_fct()+1)
+		std::vector<size_t> m_vRowOffset;
 
-	//	type of Func-Coupling matrices
-		typedef DenseMatrix<VariableArray2<LocalCplMatrix> > FctCplMatrix;
+	///	Offset of first column of each function (size num_all_col_fct()+1)
+		std::vector<size_t> m_vColOffset;
 
-	//	type of Func-Coupling pointer matrices
-		typedef DenseMatrix<VariableArray2<LocalCplMatrix*> > FctCplAccMatrix;
+	///	Offset of first row of each currently accessible function
+		std::vector<size_t> m_vRowAccOffset;
 
-	// 	Entries (fct1, fct2, dof1, dof2)
-		FctCplMatrix m_CplMat;
+	///	Offset of first column of each currently accessible function
+		std::vector<size_t> m_vColAccOffset;
 
-	// 	Entries (fct1, fct2, dof1, dof2)
-		FctCplAccMatrix m_CplMatAcc;
+	// 	Entries (fct1, dof1) x (fct2, dof2), dense and row-major
+		std::vector<value_type> m_vEntry;
 };
 
 inline
@@ -71,7 +71,8 @@ DoFDistribution(SmartPtr<MultiGrid> spMG,
 	  m_spSurfView(spSurfView),
 	  m_gridLevel(level),
 	  m_spDoFIndexStorage(spDoFIndexStorage),
-	  m_numIndex(0)
+	  m_numIndex(0),
+	  m_RevCnt(this)
 {
 	if(m_spDoFIndexStorage.invalid())
 		m_spDoFIndexStorage = SmartPtr<DoFIndexStorage>(new DoFIndexStorage(spMG, spDDInfo));
@@ -1431,6 +1432,9 @@ void DoFDistribution::reinit()
 #ifdef UG_PARALLEL
 	reinit_layouts_and_communicator();
 #endif
+
+//	increase revision counter
+	++m_RevCnt;
 }
 
 
@@ -1754,6 +1758,9 @@ void DoFDistribution::permute_indices(const std::vector<size_t>& vNewInd)
 
 //	permute indices in associated vectors
 	permute_values(vNewInd);
+
+//	increase revision counter
+	++m_RevCnt;
 }
 
 } // end namespace ug
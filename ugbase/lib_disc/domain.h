@@ -35,6 +35,7 @@
 
 #include "lib_grid/algorithms/subset_util.h"
 #include "lib_grid/refinement/projectors/refinement_projector.h"
+#include "lib_disc/common/revision_counter.h"
 
 #include <map>
 
@@ -224,6 +225,17 @@ class IDomain
 	///	returns the geometry of the domain
 		virtual SPIGeometry3d geometry3d() const = 0;
 
+	///	returns the revision of the vertex positions
+	/**	The revision is increased by positions_changed(). Caches depending on
+	 * vertex coordinates (e.g. point locators) compare it instead of the
+	 * coordinates themselves.*/
+		const RevisionCounter& position_revision() const	{return m_posRevision;}
+
+	///	marks the vertex positions as changed
+	/**	Has to be called by everyone moving vertices of the domain (e.g. for
+	 * moving meshes), so that caches depending on positions are rebuilt.*/
+		void positions_changed()							{++m_posRevision;}
+
 	protected:
 		#ifdef UG_PARALLEL
 		/// helper method to broadcast ug::RefinementProjectors to different processes
@@ -256,6 +268,8 @@ class IDomain
 		bool	m_isAdaptive;
 		bool	m_adaptionIsActive;
 
+		RevisionCounter	m_posRevision;	///< revision of the vertex positions
+
 	/**	this callback is called by the message hub, when a grid adaption has been
 	 * performed. It will call all necessary actions in order to keep the grid
 	 * correct for computations. */
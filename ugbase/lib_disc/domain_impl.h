@@ -63,7 +63,8 @@ IDomain<TGrid,TSubsetHandler>::IDomain(bool isAdaptive)
 	m_spGrid(new TGrid(GRIDOPT_NONE)),	// Note: actual options are set by the derived class (dimension dependent).
 	m_spSH(new TSubsetHandler(*m_spGrid)),
 	m_isAdaptive(isAdaptive),
-	m_adaptionIsActive(false)
+	m_adaptionIsActive(false),
+	m_posRevision(this)
 {
 	#ifdef UG_PARALLEL
 	//	the grid has to be prepared for parallelism
@@ -94,6 +94,8 @@ void AddFunctionValuesToGridCoordinatesP1(
 			}
 		}
 	}
+
+	spGridFct->domain()->positions_changed();
 }
 
 template <typename TGridFunction>
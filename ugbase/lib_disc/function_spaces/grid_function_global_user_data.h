@@ -45,6 +45,7 @@
 #include "lib_disc/spatial_disc/user_data/std_glob_pos_data.h"
 #include "lib_disc/reference_element/reference_mapping_provider.h"
 #include "lib_grid/algorithms/space_partitioning/lg_ntree.h"
+#include "lib_grid/lib_grid_messages.h"
 
 #include <math.h>       /* fabs */
 
@@ -72,13 +73,22 @@ class GlobalGridFunctionNumberData
 		LFEID m_lfeID;
 
 		typedef lg_ntree<dim, dim, element_t>	tree_t;
-		tree_t	m_tree;
+		mutable tree_t	m_tree;
+
+	///	flag if the tree is up to date with the grid
+		mutable bool m_bTreeValid;
+
+	///	callbacks invalidating the tree on grid changes
+		MessageHub::SPCallbackId m_spAdaptionCallbackID;
+		MessageHub::SPCallbackId m_spCreationCallbackID;
+		MessageHub::SPCallbackId m_spDistributionCallbackID;
 
 	public:
 	/// constructor
 		GlobalGridFunctionNumberData(SmartPtr<TGridFunction> spGridFct, const char* cmp)
 		: m_spGridFct(spGridFct),
-		  m_tree(*spGridFct->domain()->grid(), spGridFct->domain()->position_attachment())
+		  m_tree(*spGridFct->domain()->grid(), spGridFct->domain()->position_attachment()),
+		  m_bTreeValid(false)
 		{
 			//this->set_functions(cmp);
 
@@ -93,10 +103,22 @@ class GlobalGridFunctionNumberData
 			//	local finite element id
 			m_lfeID = spGridFct->local_finite_element_id(m_fct);
 
+			//	recreate the tree after the grid has changed
+			MessageHub* msgHub = spGridFct->domain()->grid()->message_hub().get();
+			m_spAdaptionCallbackID = msgHub->register_class_callback(this,
+						&GlobalGridFunctionNumberData<TGridFunction, elemDim>::grid_adaption_callback);
+			m_spCreationCallbackID = msgHub->register_class_callback(this,
+						&GlobalGridFunctionNumberData<TGridFunction, elemDim>::grid_creation_callback);
+			m_spDistributionCallbackID = msgHub->register_class_callback(this,
+						&GlobalGridFunctionNumberData<TGridFunction, elemDim>::grid_distribution_callback);
 
+			create_tree();
+		};
 
-//			const MGSubsetHandler& ssh = *m_spGridFct->domain()->subset_handler();
-
+	protected:
+		///	creates the tree of the elements on which the function is defined
+		void create_tree() const
+		{
 			SubsetGroup ssGrp(m_spGridFct->domain()->subset_handler());
 			ssGrp.add_all();
 
@@ -107,15 +129,15 @@ class GlobalGridFunctionNumberData
 
 
 			for(size_t si = 0; si < ssGrp.size(); si++){
-				if( spGridFct->is_def_in_subset(m_fct, si) )
+				if( m_spGridFct->is_def_in_subset(m_fct, si) )
 					subsetsOfGridFunction.push_back(si);
 			}
 
 
 			for(size_t i = 0; i<subsetsOfGridFunction.size(); i++){
 				size_t si = subsetsOfGridFunction[i];
-				iter = spGridFct->template begin<element_t>(si);
-				iterEnd = spGridFct->template end<element_t>(si);
+				iter = m_spGridFct->template begin<element_t>(si);
+				iterEnd = m_spGridFct->template end<element_t>(si);
 
 				for(;iter!=iterEnd; ++iter){
 					element_t *elem = *iter;
@@ -123,12 +145,33 @@ class GlobalGridFunctionNumberData
 				}
 			}
 
-//			m_tree.create_tree(spGridFct->template begin<element_t>(si),
-//														spGridFct->template end<element_t>(si));
-
 			m_tree.create_tree(elemsWithGridFunctions.begin(), elemsWithGridFunctions.end());
+			m_bTreeValid = true;
+		}
 
-		};
+		///	returns the tree, recreated if the grid has changed
+		const tree_t& tree() const
+		{
+			if(!m_bTreeValid) create_tree();
+			return m_tree;
+		}
+
+		void grid_adaption_callback(const GridMessage_Adaption& msg)
+		{
+			if(msg.adaption_ends()) m_bTreeValid = false;
+		}
+
+		void grid_creation_callback(const GridMessage_Creation& msg)
+		{
+			if(msg.msg() == GMCT_CREATION_STOPS) m_bTreeValid = false;
+		}
+
+		void grid_distribution_callback(const GridMessage_Distribution& msg)
+		{
+			if(msg.msg() == GMDT_DISTRIBUTION_STOPS) m_bTreeValid = false;
+		}
+
+	public:
 
 		virtual ~GlobalGridFunctionNumberData() {}
 
@@ -150,7 +193,7 @@ class GlobalGridFunctionNumberData
 			element_t* elem = NULL;
 			//try{
 
-				if(!FindContainingElement(elem, m_tree, x)){
+				if(!FindContainingElement(elem, tree(), x)){
 					return false;
 				}
 
@@ -270,13 +313,22 @@ class GlobalGridFunctionGradientData
 		LFEID m_lfeID;
 
 		typedef lg_ntree<dim, dim, element_t>	tree_t;
-		tree_t	m_tree;
+		mutable tree_t	m_tree;
+
+	///	flag if the tree is up to date with the grid
+		mutable bool m_bTreeValid;
+
+	///	callbacks invalidating the tree on grid changes
+		MessageHub::SPCallbackId m_spAdaptionCallbackID;
+		MessageHub::SPCallbackId m_spCreationCallbackID;
+		MessageHub::SPCallbackId m_spDistributionCallbackID;
 
 	public:
 	/// constructor
 		GlobalGridFunctionGradientData(SmartPtr<TGridFunction> spGridFct, const char* cmp)
 		: m_spGridFct(spGridFct),
-		  m_tree(*spGridFct->domain()->grid(), spGridFct->domain()->position_attachment())
+		  m_tree(*spGridFct->domain()->grid(), spGridFct->domain()->position_attachment()),
+		  m_bTreeValid(false)
 		{
 			//this->set_functions(cmp);
 
@@ -291,10 +343,22 @@ class GlobalGridFunctionGradientData
 			//	local finite element id
 			m_lfeID = spGridFct->local_finite_element_id(m_fct);
 
+			//	recreate the tree after the grid has changed
+			MessageHub* msgHub = spGridFct->domain()->grid()->message_hub().get();
+			m_spAdaptionCallbackID = msgHub->register_class_callback(this,
+						&GlobalGridFunctionGradientData<TGridFunction>::grid_adaption_callback);
+			m_spCreationCallbackID = msgHub->register_class_callback(this,
+						&GlobalGridFunctionGradientData<TGridFunction>::grid_creation_callback);
+			m_spDistributionCallbackID = msgHub->register_class_callback(this,
+						&GlobalGridFunctionGradientData<TGridFunction>::grid_distribution_callback);
 
+			create_tree();
+		};
 
-//			const MGSubsetHandler& ssh = *m_spGridFct->domain()->subset_handler();
-
+	protected:
+		///	creates the tree of the elements on which the function is defined
+		void create_tree() const
+		{
 			SubsetGroup ssGrp(m_spGridFct->domain()->subset_handler());
 			ssGrp.add_all();
 
@@ -305,15 +369,15 @@ class GlobalGridFunctionGradientData
 
 
 			for(size_t si = 0; si < ssGrp.size(); si++){
-				if( spGridFct->is_def_in_subset(m_fct, si) )
+				if( m_spGridFct->is_def_in_subset(m_fct, si) )
 					subsetsOfGridFunction.push_back(si);
 			}
 
 
 			for(size_t i = 0; i<subsetsOfGridFunction.size(); i++){
 				size_t si = subsetsOfGridFunction[i];
-				iter = spGridFct->template begin<element_t>(si);
-				iterEnd = spGridFct->template end<element_t>(si);
+				iter = m_spGridFct->template begin<element_t>(si);
+				iterEnd = m_spGridFct->template end<element_t>(si);
 
 				for(;iter!=iterEnd; ++iter){
 					element_t *elem = *iter;
@@ -321,12 +385,33 @@ class GlobalGridFunctionGradientData
 				}
 			}
 
-//			m_tree.create_tree(spGridFct->template begin<element_t>(si),
-//														spGridFct->template end<element_t>(si));
-
 			m_tree.create_tree(elemsWithGridFunctions.begin(), elemsWithGridFunctions.end());
+			m_bTreeValid = true;
+		}
 
-		};
+		///	returns the tree, recreated if the grid has changed
+		const tree_t& tree() const
+		{
+			if(!m_bTreeValid) create_tree();
+			return m_tree;
+		}
+
+		void grid_adaption_callback(const GridMessage_Adaption& msg)
+		{
+			if(msg.adaption_ends()) m_bTreeValid = false;
+		}
+
+		void grid_creation_callback(const GridMessage_Creation& msg)
+		{
+			if(msg.msg() == GMCT_CREATION_STOPS) m_bTreeValid = false;
+		}
+
+		void grid_distribution_callback(const GridMessage_Distribution& msg)
+		{
+			if(msg.msg() == GMDT_DISTRIBUTION_STOPS) m_bTreeValid = false;
+		}
+
+	public:
 
 		virtual ~GlobalGridFunctionGradientData() {}
 
@@ -350,7 +435,7 @@ class GlobalGridFunctionGradientData
 			element_t* elem = NULL;
 			try{
 
-				if(!FindContainingElement(elem, m_tree, x)){
+				if(!FindContainingElement(elem, tree(), x)){
 					return false;
 				}
 
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#include <vector>
+#include <algorithm>
+#include "vtk_file_writer.h"
+#include "common/log.h"
+#include "common/error.h"
+#include "common/types.h"
+#include "common/profiler/profiler.h"
+
+#ifdef UG_ZLIB
+	#include <zlib.h>
+#endif
+
+namespace ug{
+
+VTKFileWriter::
+VTKFileWriter(const char* filename, bool bAppended, bool bCompressed,
+              SmartPtr<AsyncFileWriter> spAsync)
+	: m_filename(filename), m_bAppended(bAppended),
+	  m_bCompressed(bAppended && bCompressed), m_bClosed(false),
+	  m_currFormat(normal), m_spAsync(spAsync)
+{
+	if(m_bCompressed && !compression_available())
+		UG_THROW("VTKFileWriter: Compression requested, but ug has been "
+				"compiled without zlib.");
+
+	if(!m_bAppended)
+		m_base64.open(filename, std::ios_base::out | std::ios_base::trunc);
+}
+
+VTKFileWriter::~VTKFileWriter()
+{
+	try{
+		close();
+	}
+	catch(UGError& err){
+		UG_LOG("VTKFileWriter: Could not write '" << m_filename << "': "
+		       << err.get_msg() << "\n");
+	}
+}
+
+bool VTKFileWriter::compression_available()
+{
+#ifdef UG_ZLIB
+	return true;
+#else
+	return false;
+#endif
+}
+
+void VTKFileWriter::close()
+{
+	if(m_bClosed) return;
+	m_bClosed = true;
+
+	if(!m_bAppended) {m_base64.close(); return;}
+
+	PROFILE_FUNC();
+	finish_block();
+
+	std::string content = m_xml.str();
+	m_xml.str("");
+	if(m_spAsync.valid())
+		m_spAsync->write(m_filename, content);
+	else
+		AsyncFileWriter::write_file(m_filename, content);
+}
+
+std::string VTKFileWriter::format_attribute(bool binary) const
+{
+	if(!binary) return "\"ascii\"";
+	if(!m_bAppended) return "\"binary\"";
+
+	std::stringstream ss;
+	ss << "\"appended\" offset=\"" << m_appended.size() << "\"";
+	return ss.str();
+}
+
+void VTKFileWriter::write_appended_data()
+{
+	if(!m_bAppended) return;
+
+	finish_block();
+	m_currFormat = normal;
+	m_xml << "  <AppendedData encoding=\"raw\">\n   _";
+	m_xml.write(m_appended.data(), m_appended.size());
+	m_xml << "\n  </AppendedData>\n";
+	std::string().swap(m_appended);
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const fmtflag format)
+{
+	if(!m_bAppended) {m_base64 << (Base64FileWriter::fmtflag) format; return *this;}
+
+	if(format == base64_ascii)
+		UG_THROW("VTKFileWriter: base64 ascii output not supported in appended mode.");
+
+	if(format != m_currFormat && m_currFormat == base64_binary)
+		finish_block();
+
+	m_currFormat = format;
+	return *this;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const char* cstr)
+{
+	if(!m_bAppended) {m_base64 << cstr; return *this;}
+
+	if(m_currFormat == base64_binary) m_block.append(cstr);
+	else m_xml << cstr;
+	return *this;
+}
+
+VTKFileWriter& VTKFileWriter::operator<<(const std::string& str)
+{
+	return (*this) << str.c_str();
+}
+
+void VTKFileWriter::finish_block()
+{
+	if(m_block.empty()) return;
+
+	if(!m_bCompressed){
+		m_appended.append(m_block);
+		m_block.clear();
+		return;
+	}
+
+#ifdef UG_ZLIB
+//	the data array starts with its size, which is replaced by the
+//	header of the compressed data:
+//	[#blocks][#u-size][#p-size][#c-size-1]...[#c-size-#blocks]
+	UG_COND_THROW(m_block.size() < sizeof(int),
+				"VTKFileWriter: Data array without size.");
+	const char* data = m_block.data() + sizeof(int);
+	const size_t size = m_block.size() - sizeof(int);
+
+	const size_t blockSize = 32768;
+	const size_t numBlocks = (size + blockSize - 1) / blockSize;
+	std::vector<uint32> vHeader(3 + numBlocks);
+	vHeader[0] = (uint32) numBlocks;
+	vHeader[1] = (uint32) blockSize;
+	vHeader[2] = (uint32) (size % blockSize);
+
+	std::string compressed;
+	std::vector<Bytef> vBuffer(compressBound(blockSize));
+	for(size_t b = 0; b < numBlocks; ++b)
+	{
+		const size_t begin = b * blockSize;
+		const size_t len = std::min(blockSize, size - begin);
+		uLongf compLen = vBuffer.size();
+		if(compress2(&vBuffer[0], &compLen, (const Bytef*) (data + begin),
+		             len, Z_DEFAULT_COMPRESSION) != Z_OK)
+			UG_THROW("VTKFileWriter: zlib compression failed.");
+
+		vHeader[3 + b] = (uint32) compLen;
+		compressed.append((const char*) &vBuffer[0], compLen);
+	}
+
+	m_appended.append((const char*) &vHeader[0], vHeader.size() * sizeof(uint32));
+	m_appended.append(compressed);
+	m_block.clear();
+#endif
+}
+
+VTKFileWriter::Position VTKFileWriter::position() const
+{
+	UG_COND_THROW(!m_bAppended, "VTKFileWriter: Position only available in appended mode.");
+	UG_COND_THROW(!m_block.empty(), "VTKFileWriter: Position requested within a data array.");
+
+	Position pos;
+	pos.xml = m_xml.str().size();
+	pos.appended = m_appended.size();
+	return pos;
+}
+
+void VTKFileWriter::
+copy_since(const Position& pos, std::string& xml, std::string& appended) const
+{
+	UG_COND_THROW(!m_bAppended, "VTKFileWriter: Copy only available in appended mode.");
+	UG_COND_THROW(!m_block.empty(), "VTKFileWriter: Copy requested within a data array.");
+
+	xml = m_xml.str().substr(pos.xml);
+	appended = m_appended.substr(pos.appended);
+}
+
+void VTKFileWriter::insert(const std::string& xml, const std::string& appended)
+{
+	UG_COND_THROW(!m_bAppended, "VTKFileWriter: Insert only available in appended mode.");
+	finish_block();
+
+	m_xml.write(xml.data(), xml.size());
+	m_appended.append(appended);
+}
+
+} // namespace ug
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__
+#define __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__
+
+#include <string>
+#include <sstream>
+#include "common/util/base64_file_writer.h"
+#include "common/util/async_file_writer.h"
+#include "common/util/smart_pointer.h"
+
+namespace ug{
+
+///	File writer for the vtk xml formats
+/**
+ * This writer is used like the Base64FileWriter: xml text is written in the
+ * format VTKFileWriter::normal, binary data in the format
+ * VTKFileWriter::base64_binary, where each binary data array is started
+ * with the number of bytes (as int) and ended by switching back to normal.
+ *
+ * By default, binary data arrays are written inline and base64 encoded. In
+ * appended mode, the binary data arrays are collected as raw bytes and
+ * written into the AppendedData section of the file, which is smaller and
+ * much faster to write. In this mode, the data arrays must be tagged with
+ * the offset of the data (see format_attribute) and write_appended_data
+ * must be called before the closing VTKFile tag. Optionally, the appended
+ * data arrays are zlib compressed (if ug is compiled with zlib).
+ *
+ * In appended mode, the whole file is assembled in memory and written on
+ * close. If an AsyncFileWriter is passed, the file is written in the
+ * background.
+ */
+class VTKFileWriter
+{
+	public:
+	///	format flags
+		enum fmtflag {
+			base64_ascii = Base64FileWriter::base64_ascii,
+			base64_binary = Base64FileWriter::base64_binary,
+			normal = Base64FileWriter::normal
+		};
+
+	///	position in the output of the appended mode
+		struct Position
+		{
+			size_t xml;
+			size_t appended;
+		};
+
+	public:
+	///	opens the file
+	/**
+	 * \param[in]	filename	name of the output file
+	 * \param[in]	bAppended	write binary data raw in an appended section
+	 * \param[in]	bCompressed	compress the appended data with zlib
+	 * \param[in]	spAsync		writer used to write the file in the background
+	 */
+		VTKFileWriter(const char* filename, bool bAppended = false,
+		              bool bCompressed = false,
+		              SmartPtr<AsyncFileWriter> spAsync = SPNULL);
+
+	///	destructor, closes the file
+		~VTKFileWriter();
+
+	///	closes the file
+		void close();
+
+	///	returns if the binary data is appended
+		bool appended() const {return m_bAppended;}
+
+	///	returns if the appended data is compressed
+		bool compressed() const {return m_bCompressed;}
+
+	///	returns if compression is available
+		static bool compression_available();
+
+	///	returns the format attribute of a data array
+	/**	Returns the 'format' attribute (including quotes) of a data array,
+	 * that is written next and the 'offset' attribute in appended mode.*/
+		std::string format_attribute(bool binary) const;
+
+	///	writes the AppendedData section (does nothing if not appended)
+		void write_appended_data();
+
+	///	switches the format
+		VTKFileWriter& operator<<(const fmtflag format);
+
+	// insert plain standard types to this filewriter
+		VTKFileWriter& operator<<(int i)				{dispatch(i); return *this;}
+		VTKFileWriter& operator<<(char c)				{dispatch(c); return *this;}
+		VTKFileWriter& operator<<(const char* cstr);
+		VTKFileWriter& operator<<(const std::string& str);
+		VTKFileWriter& operator<<(float f)				{dispatch(f); return *this;}
+		VTKFileWriter& operator<<(double d)				{dispatch(d); return *this;}
+		VTKFileWriter& operator<<(long l)				{dispatch(l); return *this;}
+		VTKFileWriter& operator<<(size_t s)				{dispatch(s); return *this;}
+
+	///	returns the current position (appended mode only)
+		Position position() const;
+
+	///	copies the output since a position (appended mode only)
+	/**	The xml text contains the offsets of the data arrays, so the copy can
+	 * only be inserted at a position with the same appended offset.*/
+		void copy_since(const Position& pos, std::string& xml, std::string& appended) const;
+
+	///	inserts output copied by copy_since (appended mode only)
+		void insert(const std::string& xml, const std::string& appended);
+
+	private:
+	//	disallow copy
+		VTKFileWriter(const VTKFileWriter&);
+		VTKFileWriter& operator=(const VTKFileWriter&);
+
+		template <typename T>
+		void dispatch(const T& value)
+		{
+			if(!m_bAppended) {m_base64 << value; return;}
+
+			if(m_currFormat == base64_binary)
+				m_block.append(reinterpret_cast<const char*>(&value), sizeof(T));
+			else
+				m_xml << value;
+		}
+
+	///	moves the current binary data array to the appended data
+		void finish_block();
+
+	private:
+	///	name of the file
+		std::string m_filename;
+
+	///	flags
+		bool m_bAppended;
+		bool m_bCompressed;
+		bool m_bClosed;
+
+	///	writer used if not in appended mode
+		Base64FileWriter m_base64;
+
+	///	current format
+		fmtflag m_currFormat;
+
+	///	xml part of the file (appended mode)
+		std::ostringstream m_xml;
+
+	///	appended data (appended mode)
+		std::string m_appended;
+
+	///	current data array (appended mode)
+		std::string m_block;
+
+	///	background writer
+		SmartPtr<AsyncFileWriter> m_spAsync;
+};
+
+} // namespace ug
+
+#endif /* __H__UG__LIB_DISC__IO__VTK_FILE_WRITER__ */
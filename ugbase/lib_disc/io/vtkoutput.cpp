@@ -72,7 +72,7 @@ print(const char* filename, Domain<TDim>& domain)
 //	open the file
 	try
 	{
-	VTKFileWriter File(name.c_str());
+	VTKFileWriter File(name.c_str(), m_bBinary && m_bAppended, m_bCompressed, m_spAsyncWriter);
 
 //	header
 	File << VTKFileWriter::normal;
@@ -80,7 +80,9 @@ print(const char* filename, Domain<TDim>& domain)
 	File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 	if(IsLittleEndian()) File << "LittleEndian";
 	else File << "BigEndian";
-	File << "\">\n";
+	File << "\"";
+	if(File.compressed()) File << " compressor=\"vtkZLibDataCompressor\"";
+	File << ">\n";
 
 //	opening the grid
 	File << "  <UnstructuredGrid>\n";
@@ -113,6 +115,7 @@ print(const char* filename, Domain<TDim>& domain)
 
 //	write closing xml tags
 	File << "  </UnstructuredGrid>\n";
+	File.write_appended_data();
 	File << "</VTKFile>\n";
 
 // 	detach help indices
@@ -135,7 +138,7 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "    <Piece NumberOfPoints=\"0\" NumberOfCells=\"0\">\n";
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(binary) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
@@ -144,18 +147,18 @@ write_empty_grid_piece(VTKFileWriter& File, bool binary)
 	File << "      </Points>\n";
 	File << "      <Cells>\n";
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(binary) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
 		File << n;
 	File << "\n        </DataArray>\n";
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(binary) << ">\n";
 	File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	File << "\n        </DataArray>\n";
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(binary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(binary) << ">\n";
 	if(binary)
 		File << VTKFileWriter::base64_binary << n << VTKFileWriter::normal;
 	else
@@ -590,6 +593,54 @@ set_binary(bool b) {
 	m_bBinary = b;
 }
 
+template <int TDim>
+void VTKOutput<TDim>::
+set_compression(bool b) {
+	if(b && !VTKFileWriter::compression_available())
+		UG_THROW("VTKOutput::set_compression: ug has been compiled without zlib.");
+	m_bCompressed = b;
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+set_background_writing(bool b) {
+	if(b && m_spAsyncWriter.invalid())
+		m_spAsyncWriter = make_sp(new AsyncFileWriter());
+	else if(!b && m_spAsyncWriter.valid()){
+		m_spAsyncWriter->wait();
+		m_spAsyncWriter = SPNULL;
+	}
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+flush() {
+	if(m_spAsyncWriter.valid())
+		m_spAsyncWriter->wait();
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+set_cache_topology(bool b) {
+	m_bCacheTopology = b;
+	if(!b) m_mTopologyCache.clear();
+}
+
+template <int TDim>
+void VTKOutput<TDim>::
+set_time_series_mode(bool b) {
+	set_appended(b);
+	set_cache_topology(b);
+	set_background_writing(b);
+}
+
+template <int TDim>
+typename VTKOutput<TDim>::TopologyCache* VTKOutput<TDim>::
+topology_cache(VTKFileWriter& File, const std::string& key) {
+	if(!m_bCacheTopology || !File.appended()) return NULL;
+	return &m_mTopologyCache[key];
+}
+
 template <int TDim>
 bool VTKOutput<TDim>::
 vtk_name_used(const char* name) const
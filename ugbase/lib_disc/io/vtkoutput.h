@@ -39,14 +39,13 @@
 
 // other ug modules
 #include "common/util/string_util.h"
-#include "common/util/base64_file_writer.h"
+#include "lib_disc/io/vtk_file_writer.h"
+#include "lib_disc/common/revision_counter.h"
 #include "lib_disc/common/function_group.h"
 #include "lib_disc/domain.h"
 #include "lib_disc/spatial_disc/user_data/user_data.h"
 
 namespace ug{
-// todo this should avoid refactoring all the signatures of VTKOutput, remove it later
-typedef Base64FileWriter VTKFileWriter;
 
 template <typename T>
 struct IteratorProvider
@@ -686,6 +685,23 @@ protected:
 		                 int numElem);
 
 	protected:
+	///	encoded grid of a piece, used for all outputs with unchanged grid
+		struct TopologyCache
+		{
+			RevisionCounter revision;
+			size_t posChecksum;
+			size_t appendedOffset;
+			int numVert, numElem;
+			std::string xml, appended;
+		};
+
+	///	returns the topology cache for a file and subset (NULL if unused)
+		TopologyCache* topology_cache(VTKFileWriter& File, const std::string& key);
+
+	///	returns a checksum of the vertex positions of the domain of a function
+		template <typename TFunction>
+		static size_t position_checksum(TFunction& u);
+
 	/**
 	 * This function writes a piece of the grid to the vtk file. First the
 	 * geometric data is written (points, cells, connectivity). Then the data
@@ -695,13 +711,15 @@ protected:
 	 * \param[in]		u			discrete function
 	 * \param[in]		si			subset
 	 * \param[in]		dim			dimension of subset
+	 * \param[in]		pCache		encoded grid to reuse (or NULL)
 	 */
 		template <typename TFunction>
 		void
 		write_grid_solution_piece(VTKFileWriter& File,
 								  Grid::VertexAttachmentAccessor<Attachment<int> >& aaVrtIndex,
 								  Grid& grid,
-								  TFunction& u, number time, int si, int dim);
+								  TFunction& u, number time, int si, int dim,
+								  TopologyCache* pCache = NULL);
 
 	/**
 	 * This function writes a piece of the grid to the vtk file. First the
@@ -712,13 +730,15 @@ protected:
 	 * \param[in]		u			discrete function
 	 * \param[in]		ssGrp		subsets
 	 * \param[in]		dim			dimension of subset
+	 * \param[in]		pCache		encoded grid to reuse (or NULL)
 	 */
 		template <typename TFunction>
 		void
 		write_grid_solution_piece(VTKFileWriter& File,
 								  Grid::VertexAttachmentAccessor<Attachment<int> >& aaVrtIndex,
 								  Grid& grid,
-								  TFunction& u, number time, SubsetGroup& ssGrp, int dim);
+								  TFunction& u, number time, SubsetGroup& ssGrp, int dim,
+								  TopologyCache* pCache = NULL);
 
 	///////////////////////////////////////////////////////////////////////////
 	// nodal data
@@ -922,11 +942,39 @@ protected:
 
 	public:
 	///	default constructor
-		VTKOutput()	: m_bSelectAll(true), m_bBinary(true) {}
+		VTKOutput()	: m_bSelectAll(true), m_bBinary(true), m_bAppended(false),
+					  m_bCompressed(false), m_bCacheTopology(false) {}
 
 	/// should values be printed in binary (base64 encoded way ) or plain ascii
 		void set_binary(bool b);
 
+	///	writes binary values raw in an appended section instead of base64 encoded
+		void set_appended(bool b) {m_bAppended = b;}
+
+	///	compresses the appended binary values using zlib
+	/**	Only available, if ug has been compiled with zlib.*/
+		void set_compression(bool b);
+
+	///	writes the files in a background thread
+	/**	The files are assembled in memory and written while the computation
+	 * continues. Only applies to the appended output.*/
+		void set_background_writing(bool b);
+
+	///	waits until all files queued for background writing are written
+		void flush();
+
+	///	encodes the grid only once per grid revision
+	/**	If enabled, the encoded points and cells of a piece are stored and
+	 * reused for all further outputs of the same file name, as long as the
+	 * dof distribution of the grid function (e.g. by adaption or
+	 * redistribution) and the vertex positions have not changed. Only applies
+	 * to the appended output.*/
+		void set_cache_topology(bool b);
+
+	///	enables the appended output with topology caching and background writing
+	/**	This is the recommended setting for the output of time series.*/
+		void set_time_series_mode(bool b);
+
 	protected:
 	///	returns true if name for vtk-component is already used
 		bool vtk_name_used(const char* name) const;
@@ -951,12 +999,21 @@ protected:
 		inline void write_item_to_file(VTKFileWriter& File, const ug::MathVector<3>& data);
 	/// \}
 
-
 	protected:
 	///	scheduled components to be printed
 		bool m_bSelectAll;
 	/// print values in binary (base64 encoded way) or plain ascii
 		bool m_bBinary;
+	///	write binary values raw in an appended section
+		bool m_bAppended;
+	///	compress the appended values
+		bool m_bCompressed;
+	///	reuse the encoded grid
+		bool m_bCacheTopology;
+	///	encoded grids (key: file name and subsets)
+		std::map<std::string, TopologyCache> m_mTopologyCache;
+	///	writer for the background writing
+		SmartPtr<AsyncFileWriter> m_spAsyncWriter;
 		std::map<std::string, std::vector<std::string> > m_vSymbFct;
 		std::map<std::string, std::vector<std::string> > m_vSymbFctNodal;
 		std::map<std::string, std::vector<std::string> > m_vSymbFctElem;
@@ -35,6 +35,7 @@
 #include <iostream>
 #include <cstring>
 #include <string>
+#include <sstream>
 #include <algorithm>
 
 // ug4 libraries
@@ -224,7 +225,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 //	open the file
 	try
 	{
-	VTKFileWriter File(name.c_str());
+	VTKFileWriter File(name.c_str(), m_bBinary && m_bAppended, m_bCompressed, m_spAsyncWriter);
 
 //	bool if time point should be written to *.vtu file
 //	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -239,7 +240,9 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 	File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 	if(IsLittleEndian()) File << "LittleEndian";
 	else File << "BigEndian";
-	File << "\">\n";
+	File << "\"";
+	if(File.compressed()) File << " compressor=\"vtkZLibDataCompressor\"";
+	File << ">\n";
 
 //	writing time point
 	if(bTimeDep)
@@ -259,7 +262,9 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 	if(dim >= 0)
 	{
 		try{
-			write_grid_solution_piece(File, aaVrtIndex, grid, u, time, si, dim);
+			std::stringstream key; key << filename << "#" << si;
+			write_grid_solution_piece(File, aaVrtIndex, grid, u, time, si, dim,
+			                          topology_cache(File, key.str()));
 		}
 		UG_CATCH_THROW("VTK::print_subset: Can not write Subset: "<<si);
 	}
@@ -279,6 +284,7 @@ print_subset(const char* filename, TFunction& u, int si, int step, number time,
 //	write closing xml tags
 	File << VTKFileWriter::normal;
 	File << "  </UnstructuredGrid>\n";
+	File.write_appended_data();
 	File << "</VTKFile>\n";
 
 // 	detach help indices
@@ -353,7 +359,7 @@ print_subsets(const char* filename, TFunction& u, SubsetGroup& ssGrp, int step,
 //	open the file
 	try
 	{
-	VTKFileWriter File(name.c_str());
+	VTKFileWriter File(name.c_str(), m_bBinary && m_bAppended, m_bCompressed, m_spAsyncWriter);
 
 //	bool if time point should be written to *.vtu file
 //	in parallel we must not (!) write it to the *.vtu file, but to the *.pvtu
@@ -368,7 +374,9 @@ print_subsets(const char* filename, TFunction& u, SubsetGroup& ssGrp, int step,
 	File << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"";
 	if(IsLittleEndian()) File << "LittleEndian";
 	else File << "BigEndian";
-	File << "\">\n";
+	File << "\"";
+	if(File.compressed()) File << " compressor=\"vtkZLibDataCompressor\"";
+	File << ">\n";
 
 //	writing time point
 	if(bTimeDep)
@@ -392,7 +400,10 @@ print_subsets(const char* filename, TFunction& u, SubsetGroup& ssGrp, int step,
 	if(dim >= 0)
 	{
 		try{
-			write_grid_solution_piece(File, aaVrtIndex, grid, u, time, ssGrp, dim);
+			std::stringstream key; key << filename << "#";
+			for(size_t i = 0; i < ssGrp.size(); i++) key << ssGrp[i] << ",";
+			write_grid_solution_piece(File, aaVrtIndex, grid, u, time, ssGrp, dim,
+			                          topology_cache(File, key.str()));
 		}
 		UG_CATCH_THROW("VTK::print_subsets: Can not write the subsets");
 	}
@@ -405,6 +416,7 @@ print_subsets(const char* filename, TFunction& u, SubsetGroup& ssGrp, int step,
 //	write closing xml tags
 	File << VTKFileWriter::normal;
 	File << "  </UnstructuredGrid>\n";
+	File.write_appended_data();
 	File << "</VTKFile>\n";
 
 // 	detach help indices
@@ -533,22 +545,57 @@ write_grid_piece(VTKFileWriter& File,
 	File << "    </Piece>\n";
 }
 
+template <int TDim>
+template <typename TFunction>
+size_t VTKOutput<TDim>::
+position_checksum(TFunction& u)
+{
+	const typename TFunction::domain_type::position_accessor_type& aaPos
+		= u.domain()->position_accessor();
+	Grid& grid = *u.domain()->grid();
+
+//	FNV-1a hash of the bytes of all vertex positions
+	size_t hash = 2166136261u;
+	for(VertexIterator iter = grid.begin<Vertex>(); iter != grid.end<Vertex>(); ++iter)
+	{
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(&aaPos[*iter]);
+		for(size_t i = 0; i < sizeof(aaPos[*iter]); ++i)
+			hash = (hash ^ p[i]) * 16777619u;
+	}
+	return hash;
+}
+
 template <int TDim>
 template <typename TFunction>
 void VTKOutput<TDim>::
 write_grid_solution_piece(VTKFileWriter& File,
                           Grid::VertexAttachmentAccessor<Attachment<int> >& aaVrtIndex,
                           Grid& grid,
-                          TFunction& u, number time, int si, int dim)
+                          TFunction& u, number time, int si, int dim,
+                          TopologyCache* pCache)
 {
 //	counters
 	int numVert = 0, numElem = 0, numConn = 0;
 
+//	check if the encoded grid can be reused
+	File << VTKFileWriter::normal;
+	const size_t posChecksum = (pCache != NULL) ? position_checksum(u) : 0;
+	const bool bCached = (pCache != NULL)
+						&& pCache->revision == u.dd()->revision()
+						&& pCache->posChecksum == posChecksum
+						&& pCache->appendedOffset == File.position().appended;
+
 // 	Count needed sizes for vertices, elements and connections
-	try{
-		count_piece_sizes(grid, u, si, dim, numVert, numElem, numConn);
+	if(bCached){
+		numVert = pCache->numVert;
+		numElem = pCache->numElem;
+	}
+	else{
+		try{
+			count_piece_sizes(grid, u, si, dim, numVert, numElem, numConn);
+		}
+		UG_CATCH_THROW("VTK::write_piece: Can not count piece sizes.");
 	}
-	UG_CATCH_THROW("VTK::write_piece: Can not count piece sizes.");
 
 //	write the beginning of the piece, indicating the number of vertices
 //	and the number of elements for this piece of the grid.
@@ -557,8 +604,27 @@ write_grid_solution_piece(VTKFileWriter& File,
 	"\" NumberOfCells=\""<<numElem<<"\">\n";
 
 //	write grid
-	write_points_cells_piece<TFunction>
-	(File, aaVrtIndex, u.domain()->position_accessor(), grid, u, si, dim, numVert, numElem, numConn);
+	if(bCached)
+		File.insert(pCache->xml, pCache->appended);
+	else
+	{
+		VTKFileWriter::Position pos;
+		if(pCache != NULL) pos = File.position();
+
+		write_points_cells_piece<TFunction>
+		(File, aaVrtIndex, u.domain()->position_accessor(), grid, u, si, dim, numVert, numElem, numConn);
+
+	//	remember encoded grid
+		if(pCache != NULL){
+			File << VTKFileWriter::normal;
+			pCache->revision = u.dd()->revision();
+			pCache->posChecksum = posChecksum;
+			pCache->appendedOffset = pos.appended;
+			pCache->numVert = numVert;
+			pCache->numElem = numElem;
+			File.copy_since(pos, pCache->xml, pCache->appended);
+		}
+	}
 
 //	add all components if 'selectAll' chosen
 	if(m_bSelectAll){
@@ -590,17 +656,32 @@ void VTKOutput<TDim>::
 write_grid_solution_piece(VTKFileWriter& File,
                           Grid::VertexAttachmentAccessor<Attachment<int> >& aaVrtIndex,
                           Grid& grid,
-                          TFunction& u, number time, SubsetGroup& ssGrp, int dim)
+                          TFunction& u, number time, SubsetGroup& ssGrp, int dim,
+                          TopologyCache* pCache)
 {
 //	counters
 	int numVert = 0, numElem = 0, numConn = 0;
 
+//	check if the encoded grid can be reused
+	File << VTKFileWriter::normal;
+	const size_t posChecksum = (pCache != NULL) ? position_checksum(u) : 0;
+	const bool bCached = (pCache != NULL)
+						&& pCache->revision == u.dd()->revision()
+						&& pCache->posChecksum == posChecksum
+						&& pCache->appendedOffset == File.position().appended;
+
 // 	Count needed sizes for vertices, elements and connections
-	try{
-		for(size_t i = 0; i < ssGrp.size(); i++)
-			count_piece_sizes(grid, u, ssGrp[i], dim, numVert, numElem, numConn);
+	if(bCached){
+		numVert = pCache->numVert;
+		numElem = pCache->numElem;
+	}
+	else{
+		try{
+			for(size_t i = 0; i < ssGrp.size(); i++)
+				count_piece_sizes(grid, u, ssGrp[i], dim, numVert, numElem, numConn);
+		}
+		UG_CATCH_THROW("VTK::write_piece: Can not count piece sizes.");
 	}
-	UG_CATCH_THROW("VTK::write_piece: Can not count piece sizes.");
 
 //	write the beginning of the piece, indicating the number of vertices
 //	and the number of elements for this piece of the grid.
@@ -609,8 +690,27 @@ write_grid_solution_piece(VTKFileWriter& File,
 	"\" NumberOfCells=\""<<numElem<<"\">\n";
 
 //	write grid
-	write_points_cells_piece<TFunction>
-	(File, aaVrtIndex, u.domain()->position_accessor(), grid, u, ssGrp, dim, numVert, numElem, numConn);
+	if(bCached)
+		File.insert(pCache->xml, pCache->appended);
+	else
+	{
+		VTKFileWriter::Position pos;
+		if(pCache != NULL) pos = File.position();
+
+		write_points_cells_piece<TFunction>
+		(File, aaVrtIndex, u.domain()->position_accessor(), grid, u, ssGrp, dim, numVert, numElem, numConn);
+
+	//	remember encoded grid
+		if(pCache != NULL){
+			File << VTKFileWriter::normal;
+			pCache->revision = u.dd()->revision();
+			pCache->posChecksum = posChecksum;
+			pCache->appendedOffset = pos.appended;
+			pCache->numVert = numVert;
+			pCache->numElem = numElem;
+			File.copy_since(pos, pCache->xml, pCache->appended);
+		}
+	}
 
 //	add all components if 'selectAll' chosen
 	if(m_bSelectAll){
@@ -790,7 +890,7 @@ write_points(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(m_bBinary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 	int n = 3*sizeof(float) * numVert;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -840,7 +940,7 @@ write_points(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 	File << "      <Points>\n";
 	File << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format="
-		 <<	(m_bBinary ? "\"binary\"" : "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 	int n = 3*sizeof(float) * numVert;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1041,7 +1141,7 @@ write_cell_connectivity(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that connections will be written
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 	int n = sizeof(int) * numConn;
 
 	if(m_bBinary)
@@ -1080,7 +1180,7 @@ write_cell_connectivity(VTKFileWriter& File,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that connections will be written
 	File << "        <DataArray type=\"Int32\" Name=\"connectivity\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 	int n = sizeof(int) * numConn;
 
 	if(m_bBinary)
@@ -1178,7 +1278,7 @@ write_cell_offsets(VTKFileWriter& File, const T& iterContainer, int si, int dim,
 	File << VTKFileWriter::normal;
 //	write opening tag indicating that offsets are going to be written
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 	int n = sizeof(int) * numElem;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1216,7 +1316,7 @@ write_cell_offsets(VTKFileWriter& File, const T& iterContainer, SubsetGroup& ssG
 	File << VTKFileWriter::normal;
 //	write opening tag indicating that offsets are going to be written
 	File << "        <DataArray type=\"Int32\" Name=\"offsets\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 	int n = sizeof(int) * numElem;
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << n;
@@ -1325,7 +1425,7 @@ write_cell_types(VTKFileWriter& File, const T& iterContainer, int si, int dim,
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1362,7 +1462,7 @@ write_cell_types(VTKFileWriter& File, const T& iterContainer, SubsetGroup& ssGrp
 	File << VTKFileWriter::normal;
 //	write opening tag to indicate that types will be written
 	File << "        <DataArray type=\"Int8\" Name=\"types\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 	if(m_bBinary)
 		File << VTKFileWriter::base64_binary << numElem;
 
@@ -1509,7 +1609,7 @@ write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numVert * numCmp;
 	if(m_bBinary)
@@ -1561,7 +1661,7 @@ write_nodal_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numVert * numCmp;
 	if(m_bBinary)
@@ -1678,7 +1778,7 @@ write_nodal_values(VTKFileWriter& File, TFunction& u,
 //	write opening tag
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numVert * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -1722,7 +1822,7 @@ write_nodal_values(VTKFileWriter& File, TFunction& u,
 //	write opening tag
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numVert * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -2071,7 +2171,7 @@ write_cell_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numElem * numCmp;
 	if(m_bBinary)
@@ -2112,7 +2212,7 @@ write_cell_data(VTKFileWriter& File, TFunction& u, number time,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<numCmp<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numElem * numCmp;
 	if(m_bBinary)
@@ -2248,7 +2348,7 @@ write_cell_values(VTKFileWriter& File, TFunction& u,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numElem * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -2285,7 +2385,7 @@ write_cell_values(VTKFileWriter& File, TFunction& u,
 	File << VTKFileWriter::normal;
 	File << "        <DataArray type=\"Float32\" Name=\""<<name<<"\" "
 	"NumberOfComponents=\""<<(vFct.size() == 1 ? 1 : 3)<<"\" format="
-		 <<	(m_bBinary ? "\"binary\"": "\"ascii\"") << ">\n";
+		 <<	File.format_attribute(m_bBinary) << ">\n";
 
 	int n = sizeof(float) * numElem * (vFct.size() == 1 ? 1 : 3);
 	if(m_bBinary)
@@ -61,6 +61,9 @@ AssembledLinearOperator<TAlgebra>::init(const vector_type& u)
 		m_spAss->assemble_jacobian(*this, u, m_gridLevel);
 	}
 	UG_CATCH_THROW("AssembledLinearOperator: Cannot assemble Jacobi matrix.");
+
+//	rebuild the packed copy used for products (if enabled)
+	this->update_packed_storage();
 }
 
 //	Initialize the operator
@@ -79,6 +82,9 @@ AssembledLinearOperator<TAlgebra>::init()
 		m_spAss->assemble_linear(*this, dummy, m_gridLevel);
 	}
 	UG_CATCH_THROW("AssembledLinearOperator::init: Cannot assemble Matrix.");
+
+//	rebuild the packed copy used for products (if enabled)
+	this->update_packed_storage();
 }
 
 //	Initialize the operator
@@ -97,6 +103,9 @@ AssembledLinearOperator<TAlgebra>::init_op_and_rhs(vector_type& b)
 	}
 	UG_CATCH_THROW("AssembledLinearOperator::init_op_and_rhs:"
 						" Cannot assemble Matrix and Rhs.");
+
+//	rebuild the packed copy used for products (if enabled)
+	this->update_packed_storage();
 }
 
 template <typename TAlgebra>
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR__
+
+#include <vector>
+
+#include "assembled_linear_operator.h"
+
+namespace ug{
+
+///	matrix-free Jacobian based on finite differences of the defect
+/**
+ * This operator applies the Jacobian J(u) of a discretization without
+ * assembling it, using a directional finite difference of the defect
+ *
+ * 		J(u)*v ~ (d(u + eps*v) - d(u)) / eps,
+ *
+ * with eps = sqrt(eps_mach) * (1 + |u|) / |v| (unless set explicitly). Thus,
+ * a Krylov method (e.g. GMRES or BiCGStab) using this operator solves with the
+ * exact Jacobian, at the cost of one defect assembling per application.
+ *
+ * The matrix of the operator is only used for preconditioning. It is assembled
+ * in init(u), either as the Jacobian of the discretization (which is then
+ * typically lagged, i.e. reused over several Newton steps) or of a second,
+ * cheaper discretization (e.g. a Picard linearization or a decoupled system)
+ * set via set_preconditioner_discretization. Preconditioners accessing the
+ * MatrixOperator interface use this matrix.
+ *
+ * Rows of dofs whose values are prescribed by constraints (e.g. Dirichlet
+ * dofs) have a vanishing defect derivative. For these, the assembled matrix
+ * rows are applied instead.
+ *
+ * When used with the NewtonSolver (set_jacobian_operator), the point of
+ * linearization and its defect are passed in every Newton step, while the
+ * matrix is reassembled according to the reuse policy of the NewtonSolver.
+ *
+ * \tparam	TAlgebra			algebra type
+ */
+template <typename TAlgebra>
+class JacobianFreeOperator : public AssembledLinearOperator<TAlgebra>
+{
+	public:
+	///	Type of Algebra
+		typedef TAlgebra algebra_type;
+
+	///	Type of Vector
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Type of Matrix
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Type of base class
+		typedef AssembledLinearOperator<TAlgebra> base_type;
+
+	protected:
+		using base_type::m_spAss;
+		using base_type::m_gridLevel;
+
+	public:
+	///	Constructor
+		JacobianFreeOperator(SmartPtr<IAssemble<TAlgebra> > ass)
+			: base_type(ass), m_eps(0.0), m_uNorm(0.0), m_bValidDefect(false) {};
+
+	///	sets a discretization used to assemble the preconditioning matrix
+		void set_preconditioner_discretization(SmartPtr<IAssemble<TAlgebra> > ass) {m_spPrecondAss = ass;}
+
+	///	sets a fixed finite difference step size (0 = automatic)
+		void set_step_size(number eps) {m_eps = eps;}
+
+	///	assembles the preconditioning matrix and sets the point of linearization
+		virtual void init(const vector_type& u);
+
+	///	sets the point of linearization and its (already computed) defect
+		void set_linearization_point(const vector_type& u, const vector_type& d);
+
+	///	compute d = J(u)*c by finite differences
+		virtual void apply(vector_type& d, const vector_type& c);
+
+	///	Compute d := d - J(u)*c by finite differences
+		virtual void apply_sub(vector_type& d, const vector_type& c);
+
+	///	Destructor
+		virtual ~JacobianFreeOperator() {};
+
+	protected:
+	///	sets the point of linearization (defect computed on demand)
+		void set_point(const vector_type& u);
+
+	///	determines the components prescribed by constraints
+		void update_constrained_components(const vector_type& u);
+
+	protected:
+	///	discretization for the preconditioning matrix
+		SmartPtr<IAssemble<TAlgebra> > m_spPrecondAss;
+
+	///	point of linearization, its defect and help vectors
+		SmartPtr<vector_type> m_spU, m_spD, m_spUPert, m_spDPert;
+
+	///	fixed step size (0 = automatic) and norm of linearization point
+		number m_eps, m_uNorm;
+
+	///	flag if the defect of the linearization point is computed
+		bool m_bValidDefect;
+
+	///	constrained (index, component) pairs
+		std::vector<size_t> m_vConstrainedIndex;
+		std::vector<size_t> m_vConstrainedComp;
+};
+
+} // end namespace ug
+
+#include "jacobian_free_operator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR__ */
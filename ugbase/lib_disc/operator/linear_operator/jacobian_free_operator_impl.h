@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR_IMPL__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR_IMPL__
+
+#include <cfloat>
+#include <cmath>
+
+#include "jacobian_free_operator.h"
+#include "common/profiler/profiler.h"
+
+namespace ug{
+
+template <typename TAlgebra>
+void
+JacobianFreeOperator<TAlgebra>::init(const vector_type& u)
+{
+	PROFILE_BEGIN_GROUP(JacobianFreeOperator_init, "discretization");
+	if(m_spAss.invalid())
+		UG_THROW("JacobianFreeOperator: Assembling routine not set.");
+
+//	assemble preconditioning matrix
+	SmartPtr<IAssemble<TAlgebra> > spAss = m_spPrecondAss.valid() ? m_spPrecondAss : m_spAss;
+	try{
+		spAss->assemble_jacobian(*this, u, m_gridLevel);
+	}
+	UG_CATCH_THROW("JacobianFreeOperator: Cannot assemble preconditioning matrix.");
+
+	update_constrained_components(u);
+	set_point(u);
+	m_bValidDefect = false;
+}
+
+template <typename TAlgebra>
+void
+JacobianFreeOperator<TAlgebra>::
+set_linearization_point(const vector_type& u, const vector_type& d)
+{
+	if(m_spU.invalid() || m_spU->size() != u.size())
+		update_constrained_components(u);
+
+	set_point(u);
+	if(m_spD.invalid() || m_spD->size() != d.size()) m_spD = d.clone();
+	else *m_spD = d;
+	m_bValidDefect = true;
+}
+
+template <typename TAlgebra>
+void
+JacobianFreeOperator<TAlgebra>::set_point(const vector_type& u)
+{
+	if(m_spU.invalid() || m_spU->size() != u.size())
+	{
+		m_spU = u.clone();
+		m_spUPert = u.clone_without_values();
+		m_spDPert = u.clone_without_values();
+		m_spD = u.clone_without_values();
+	}
+	else *m_spU = u;
+
+//	norm is computed on a copy, since it may change the storage type
+	*m_spUPert = u;
+	m_uNorm = m_spUPert->norm();
+}
+
+template <typename TAlgebra>
+void
+JacobianFreeOperator<TAlgebra>::
+update_constrained_components(const vector_type& u)
+{
+//	constrained components are those changed by adjust_solution when
+//	applied to an arbitrary (pseudo-random) vector
+	SmartPtr<vector_type> spW = u.clone_without_values();
+	vector_type& w = *spW;
+	size_t seed = 12345;
+	for(size_t i = 0; i < w.size(); ++i)
+		for(size_t k = 0; k < GetSize(w[i]); ++k)
+		{
+			seed = (seed * 1103515245 + 12345) % 2147483648UL;
+			BlockRef(w[i], k) = 1.0 + (number)seed / 2147483648.0;
+		}
+	#ifdef UG_PARALLEL
+	w.set_storage_type(PST_CONSISTENT);
+	#endif
+
+	SmartPtr<vector_type> spWAdj = w.clone();
+	m_spAss->adjust_solution(*spWAdj, m_gridLevel);
+
+	m_vConstrainedIndex.clear();
+	m_vConstrainedComp.clear();
+	for(size_t i = 0; i < w.size(); ++i)
+		for(size_t k = 0; k < GetSize(w[i]); ++k)
+			if(BlockRef(w[i], k) != BlockRef((*spWAdj)[i], k))
+			{
+				m_vConstrainedIndex.push_back(i);
+				m_vConstrainedComp.push_back(k);
+			}
+}
+
+template <typename TAlgebra>
+void
+JacobianFreeOperator<TAlgebra>::apply(vector_type& d, const vector_type& c)
+{
+	PROFILE_BEGIN_GROUP(JacobianFreeOperator_apply, "discretization");
+#ifdef UG_PARALLEL
+	if(!c.has_storage_type(PST_CONSISTENT))
+		UG_THROW("Inadequate storage format of Vector c.");
+#endif
+
+	if(m_spU.invalid() || c.size() != m_spU->size() || d.size() != m_spU->size())
+		UG_THROW("JacobianFreeOperator::apply: Size of linearization point ["
+				<< (m_spU.valid() ? m_spU->size() : 0) << "] must match the "
+				"sizes of vectors x ["<<c.size()<<"], b ["<<d.size()<<"] for the "
+				" operation b = J*x. Maybe the operator is not initialized ?");
+
+//	defect of linearization point
+	if(!m_bValidDefect)
+	{
+		m_spAss->assemble_defect(*m_spD, *m_spU, m_gridLevel);
+		m_bValidDefect = true;
+	}
+
+//	norm of direction (computed on a copy, since it may change the storage type)
+	*m_spUPert = c;
+	const number cNorm = m_spUPert->norm();
+	if(cNorm == 0.0) {d.set(0.0); return;}
+
+//	step size
+	const number eps = (m_eps > 0.0) ? m_eps
+						: std::sqrt(DBL_EPSILON) * (1.0 + m_uNorm) / cNorm;
+
+//	d := (d(u + eps*c) - d(u)) / eps
+	VecScaleAdd(*m_spUPert, 1.0, *m_spU, eps, c);
+	m_spAss->assemble_defect(*m_spDPert, *m_spUPert, m_gridLevel);
+	VecScaleAdd(d, 1.0/eps, *m_spDPert, -1.0/eps, *m_spD);
+
+//	constrained rows are taken from the assembled matrix
+	const matrix_type& A = *this;
+	for(size_t k = 0; k < m_vConstrainedIndex.size(); ++k)
+	{
+		const size_t i = m_vConstrainedIndex[k];
+		const size_t alpha = m_vConstrainedComp[k];
+		number val = 0.0;
+		for(typename matrix_type::const_row_iterator it = A.begin_row(i);
+			it != A.end_row(i); ++it)
+		{
+			const size_t j = it.index();
+			for(size_t beta = 0; beta < GetSize(c[j]); ++beta)
+				val += BlockRef(it.value(), alpha, beta) * BlockRef(c[j], beta);
+		}
+		BlockRef(d[i], alpha) = val;
+	}
+}
+
+template <typename TAlgebra>
+void
+JacobianFreeOperator<TAlgebra>::apply_sub(vector_type& d, const vector_type& c)
+{
+#ifdef UG_PARALLEL
+	if(!d.has_storage_type(PST_ADDITIVE))
+		UG_THROW("Inadequate storage format of Vector d.");
+#endif
+
+	SmartPtr<vector_type> spJc = d.clone_without_values();
+	apply(*spJc, c);
+	VecScaleAdd(d, 1.0, d, -1.0, *spJc);
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__JACOBIAN_FREE_OPERATOR_IMPL__ */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__LEVEL_OPERATOR_INTERFACE__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__LEVEL_OPERATOR_INTERFACE__
+
+#include "lib_algebra/operator/interface/linear_operator.h"
+#include "lib_grid/tools/grid_level.h"
+
+namespace ug{
+
+///	A linear operator for the multi-grid context which is aware of the grid level it operates on.
+/**
+ * Operators of this type can be used by the geometric multigrid on the
+ * smoothing levels instead of assembled level matrices. The multigrid clones
+ * the operator once per level, sets the grid level and calls init().
+ */
+template <typename TAlgebra>
+class ILevelOperator : public ILinearOperator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Vector type
+		typedef typename TAlgebra::vector_type vector_type;
+
+	public:
+	/// constructor
+		ILevelOperator() : m_gl() {}
+
+	/// constructor with grid level
+		ILevelOperator(const GridLevel& gl) : m_gl(gl) {}
+
+	/// set the grid level
+		void set_grid_level(const GridLevel& gl)
+		{
+			if (gl != m_gl)
+			{
+				m_gl = gl;
+				grid_level_has_changed();
+			}
+		}
+
+	///	returns the grid level
+		const GridLevel& grid_level() const {return m_gl;}
+
+	/// response to change in grid level
+		virtual void grid_level_has_changed() {};
+
+	///	returns a new, not initialized operator with the same settings
+		virtual SmartPtr<ILevelOperator<TAlgebra> > clone() = 0;
+
+	///	virtual destructor
+		virtual ~ILevelOperator() {}
+
+	protected:
+		GridLevel m_gl;
+};
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__LEVEL_OPERATOR_INTERFACE__ */
@@ -48,8 +48,10 @@
 #include "lib_algebra/operator/interface/operator.h"
 #include "lib_algebra/operator/preconditioner/jacobi.h"
 #include "lib_algebra/operator/linear_solver/lu.h"
+#include "lib_algebra/cpu_algebra/sparsematrix_single.h"
 #include "lib_disc/dof_manager/dof_distribution.h"
 #include "lib_disc/operator/linear_operator/transfer_interface.h"
+#include "lib_disc/operator/linear_operator/level_operator_interface.h"
 //only for debugging!!!
 #include "lib_grid/algorithms/debug_util.h"
 
@@ -75,6 +77,15 @@ namespace ug{
  * that is set from outside. In addition an Assembling routine must be
  * specified that is used to assemble the coarse grid matrices.
  *
+ * If a level operator is set (set_level_operator), the level matrices are
+ * only assembled on the base level. On all smoothing levels, a copy of the
+ * level operator is used for the smoothers and the defect updates instead,
+ * such that matrix-free operators (e.g. SumFactorizationOperator) can be
+ * used within the multigrid cycle. In this case, the operator passed to init
+ * need not be a matrix. The level operators require a fully refined
+ * hierarchy (no rim couplings) and cannot be combined with RAP or mixed
+ * precision.
+ *
  * \tparam		TApproximationSpace		Type of Approximation Space
  * \tparam		TAlgebra				Type of Algebra
  */
@@ -165,6 +176,18 @@ class AssembledMultiGridCycle :
 	///	sets if communication and computation should be overlaped
 		void set_comm_comp_overlap(bool bOverlap) {m_bCommCompOverlap = bOverlap;}
 
+	///	sets if the defect updates of the smoothing use single precision level matrices
+	/**	The level matrices are assembled in double precision and converted.
+	 * The base solver and the smoothers are not affected, mixed precision for
+	 * the smoothers is chosen on the smoother itself.*/
+		void set_mixed_precision(bool bMixed) {m_bMixedPrecision = bMixed;}
+
+	///	sets the operator used on the smoothing levels instead of the level matrices
+	/**	The operator is cloned for every level above the base level. Passing
+	 * SPNULL switches back to assembled level matrices.*/
+		void set_level_operator(SmartPtr<ILevelOperator<TAlgebra> > op)
+			{m_spLevelOperatorPrototype = op;}
+
 	///	sets the number of pre-smoothing steps to be performed
 		void set_num_presmooth(int num) {m_numPreSmooth = num;}
 
@@ -274,6 +297,12 @@ class AssembledMultiGridCycle :
 
 	///	compute base solver
 		void base_solve(int lev);
+
+	///	updates the defect sd -= A*st on a smoothing level
+		void update_smoothing_defect(int lev);
+
+	///	adds the coarse correction to the surface and updates the rim defect
+		void add_correction_and_update_rim_defect(int lev);
 	//	end of section
 	////////////////////////////////////////////////////////////////
 
@@ -305,10 +334,20 @@ class AssembledMultiGridCycle :
 		void assemble_rim_cpl(const vector_type* u);
 		void init_rap_rim_cpl();
 
+	///	returns if the given level uses a level operator instead of a matrix
+		bool use_level_operator(int lev) const
+			{return m_spLevelOperatorPrototype.valid() && lev > m_baseLev;}
+
 	protected:
 	/// operator to invert (surface grid)
 		ConstSmartPtr<matrix_type> m_spSurfaceMat;
 
+	///	operator to invert (surface grid), if not a matrix
+		SmartPtr<ILinearOperator<vector_type> > m_spSurfaceOp;
+
+	///	prototype for the operator on the smoothing levels
+		SmartPtr<ILevelOperator<TAlgebra> > m_spLevelOperatorPrototype;
+
 	///	Solution on surface grid
 		const vector_type* m_pSurfaceSol;
 
@@ -353,6 +392,9 @@ class AssembledMultiGridCycle :
 	///	flag if overlapping communication and computation
 		bool m_bCommCompOverlap;
 
+	///	flag if the smoothing defect updates use single precision matrices
+		bool m_bMixedPrecision;
+
 	///	approximation space revision of cached values
 		RevisionCounter m_ApproxSpaceRevision;
 
@@ -411,6 +453,12 @@ class AssembledMultiGridCycle :
 		///	Level matrix operator
 			SmartPtr<MatrixOperator<matrix_type, vector_type> > A;
 
+		///	Level matrix in single precision (if mixed precision is used)
+			SinglePrecisionSparseMatrix<typename matrix_type::value_type> singleA;
+
+		///	Level operator used instead of A (if a level operator is set)
+			SmartPtr<ILevelOperator<TAlgebra> > LevOp;
+
 		///	Smoother
 			SmartPtr<ILinearIterator<vector_type> > PreSmoother;
 			SmartPtr<ILinearIterator<vector_type> > PostSmoother;
@@ -83,7 +83,7 @@ AssembledMultiGridCycle() :
 	m_numPreSmooth(2), m_numPostSmooth(2),
 	m_LocalFullRefLevel(0), m_GridLevelType(GridLevel::LEVEL),
 	m_bUseRAP(false), m_bSmoothOnSurfaceRim(false),
-	m_bCommCompOverlap(false),
+	m_bCommCompOverlap(false), m_bMixedPrecision(false),
 	m_spPreSmootherPrototype(new Jacobi<TAlgebra>()),
 	m_spPostSmootherPrototype(m_spPreSmootherPrototype),
 	m_spProjectionPrototype(SPNULL),
@@ -105,7 +105,7 @@ AssembledMultiGridCycle(SmartPtr<ApproximationSpace<TDomain> > approxSpace) :
 	m_numPreSmooth(2), m_numPostSmooth(2),
 	m_LocalFullRefLevel(0), m_GridLevelType(GridLevel::LEVEL),
 	m_bUseRAP(false), m_bSmoothOnSurfaceRim(false),
-	m_bCommCompOverlap(false),
+	m_bCommCompOverlap(false), m_bMixedPrecision(false),
 	m_spPreSmootherPrototype(new Jacobi<TAlgebra>()),
 	m_spPostSmootherPrototype(m_spPreSmootherPrototype),
 	m_spProjectionPrototype(new StdInjection<TDomain,TAlgebra>(m_spApproxSpace)),
@@ -146,6 +146,8 @@ clone()
 	clone->set_presmoother(m_spPreSmootherPrototype);
 	clone->set_postsmoother(m_spPostSmootherPrototype);
 	clone->set_surface_level(m_surfaceLev);
+	clone->set_mixed_precision(m_bMixedPrecision);
+	clone->set_level_operator(m_spLevelOperatorPrototype);
 
 	for(size_t i = 0; i < m_vspProlongationPostProcess.size(); ++i)
 		clone->add_prolongation_post_process(m_vspProlongationPostProcess[i]);
@@ -191,7 +193,8 @@ apply(vector_type& rC, const vector_type& rD)
 
 //	debug output
 	write_debug(d, "Defect_In");
-	write_debug(*m_spSurfaceMat, "SurfaceStiffness", c, c);
+	if(m_spSurfaceMat.valid())
+		write_debug(*m_spSurfaceMat, "SurfaceStiffness", c, c);
 
 //	project defect from surface to level
 	GMG_PROFILE_BEGIN(GMG_Apply_CopyDefectFromSurface);
@@ -244,7 +247,7 @@ apply(vector_type& rC, const vector_type& rD)
 //	apply scaling
 	GMG_PROFILE_BEGIN(GMG_Apply_Scaling);
 	try{
-		const number kappa = this->damping()->damping(c, d, m_spSurfaceMat.template cast_dynamic<ILinearOperator<vector_type> >());
+		const number kappa = this->damping()->damping(c, d, m_spSurfaceOp);
 		if(kappa != 1.0) c *= kappa;
 	}
 	UG_CATCH_THROW("GMG: Damping failed.")
@@ -296,7 +299,8 @@ apply_update_defect(vector_type &c, vector_type& rD)
 	if(!apply(c, rD)) return false;
 
 //	update defect: d = d - A*c
-	m_spSurfaceMat->matmul_minus(rD, c);
+	if(m_spSurfaceMat.valid()) m_spSurfaceMat->matmul_minus(rD, c);
+	else m_spSurfaceOp->apply_sub(rD, c);
 
 //	write for debugging
 	const GF* pD = dynamic_cast<const GF*>(&rD);
@@ -323,6 +327,7 @@ init(SmartPtr<ILinearOperator<vector_type> > J, const vector_type& u)
 
 	// Store Surface Matrix
 	m_spSurfaceMat = J.template cast_dynamic<matrix_type>();
+	m_spSurfaceOp = J;
 
 	// Store Surface Solution
 	m_pSurfaceSol = &u;
@@ -350,6 +355,7 @@ init(SmartPtr<ILinearOperator<vector_type> > L)
 
 	// Store Surface Matrix
 	m_spSurfaceMat = L.template cast_dynamic<matrix_type>();
+	m_spSurfaceOp = L;
 
 	// Store Surface Solution
 	m_pSurfaceSol = NULL;
@@ -372,10 +378,17 @@ init()
 
 	try{
 
-// 	Cast Operator
-	if(m_spSurfaceMat.invalid())
+// 	Cast Operator (not needed if level operators are used)
+	if(m_spSurfaceMat.invalid() && m_spLevelOperatorPrototype.invalid())
 		UG_THROW("GMG:init: Can not cast Operator to Matrix.");
 
+	if(m_spLevelOperatorPrototype.valid()){
+		if(m_bUseRAP)
+			UG_THROW("GMG::init: Level operators cannot be used with RAP.");
+		if(m_bMixedPrecision)
+			UG_THROW("GMG::init: Level operators cannot be used with mixed precision.");
+	}
+
 //	Check Approx Space
 	if(m_spApproxSpace.invalid())
 		UG_THROW("GMG::init: Approximation Space not set.");
@@ -517,6 +530,11 @@ assemble_level_operator()
 				" elem-disc loop (only top-lev or level-view poosible). It is "
 				"necessary to rework that part of the assembing procedure.")
 
+	if(m_spLevelOperatorPrototype.valid() && m_LocalFullRefLevel < m_topLev)
+		UG_THROW("GMG: Level operators are only supported for fully refined "
+				"grids, since the missing coarse grid couplings are taken "
+				"from the assembled level matrices.");
+
 //	Create Projection
 	try{
 		if(m_pSurfaceSol) {
@@ -583,8 +601,23 @@ assemble_level_operator()
 		#endif
 
 	//	In Full-Ref case we can copy the Matrix from the surface
-		bool bCpyFromSurface = ((lev == m_topLev) && (lev <= m_LocalFullRefLevel));
-		if(!bCpyFromSurface)
+		bool bCpyFromSurface = ((lev == m_topLev) && (lev <= m_LocalFullRefLevel)
+								&& m_spSurfaceMat.valid());
+		if(use_level_operator(lev))
+		{
+		//	the level operator replaces the level matrix
+			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start assemble_level_operator: init level operator on lev "<<lev<<"\n");
+			GMG_PROFILE_BEGIN(GMG_AssembleLevelMat_InitLevelOperator);
+			try{
+				ld.A->resize_and_clear(0, 0);
+				if(m_pSurfaceSol) ld.LevOp->init(*ld.st);
+				else ld.LevOp->init();
+			}
+			UG_CATCH_THROW("GMG:init: Cannot init level operator for level "<<lev);
+			GMG_PROFILE_END();
+			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  end   assemble_level_operator: init level operator on lev "<<lev<<"\n");
+		}
+		else if(!bCpyFromSurface)
 		{
 			UG_DLOG(LIB_DISC_MULTIGRID, 4, "  start assemble_level_operator: assemble on lev "<<lev<<"\n");
 			GMG_PROFILE_BEGIN(GMG_AssembleLevelMat_AssembleOnLevel);
@@ -667,6 +700,7 @@ assemble_level_operator()
 
 //	write computed level matrices for debug purpose
 	for(int lev = m_baseLev; lev <= m_topLev; ++lev){
+		if(use_level_operator(lev)) continue;
 		LevData& ld = *m_vLevData[lev];
 		write_debug(*ld.A, "LevelMatrix", *ld.st, *ld.st);
 	}
@@ -1111,9 +1145,17 @@ init_smoother()
 	{
 		LevData& ld = *m_vLevData[lev];
 
+	//	single precision copy of the level matrix
+		if(m_bMixedPrecision) ld.singleA.init(*ld.A);
+		else ld.singleA.clear();
+
+	//	operator the smoothers work on
+		SmartPtr<ILinearOperator<vector_type> > spOp = ld.A;
+		if(use_level_operator(lev)) spOp = ld.LevOp;
+
 		UG_DLOG(LIB_DISC_MULTIGRID, 4, "  init_smoother: initializing pre-smoother on lev "<<lev<<"\n");
 		bool success;
-		try {success = ld.PreSmoother->init(ld.A, *ld.sc);}
+		try {success = ld.PreSmoother->init(spOp, *ld.sc);}
 		UG_CATCH_THROW("GMG::init: Cannot init pre-smoother for level "<<lev);
 		if (!success)
 			UG_THROW("GMG::init: Cannot init pre-smoother for level "<<lev);
@@ -1121,7 +1163,7 @@ init_smoother()
 		UG_DLOG(LIB_DISC_MULTIGRID, 4, "  init_smoother: initializing post-smoother on lev "<<lev<<"\n");
 		if(ld.PreSmoother != ld.PostSmoother)
 		{
-			try {success = ld.PostSmoother->init(ld.A, *ld.sc);}
+			try {success = ld.PostSmoother->init(spOp, *ld.sc);}
 			UG_CATCH_THROW("GMG::init: Cannot init post-smoother for level "<<lev);
 			if (!success)
 				UG_THROW("GMG::init: Cannot init post-smoother for level "<<lev);
@@ -1516,6 +1558,12 @@ init_level_memory(int baseLev, int topLev)
 		ld.A = SmartPtr<MatrixOperator<matrix_type, vector_type> >(
 				new MatrixOperator<matrix_type, vector_type>);
 
+		if(use_level_operator(lev)){
+			ld.LevOp = m_spLevelOperatorPrototype->clone();
+			ld.LevOp->set_grid_level(gl);
+		}
+		else ld.LevOp = SPNULL;
+
 		ld.PreSmoother = m_spPreSmootherPrototype->clone();
 		if(m_spPreSmootherPrototype == m_spPostSmootherPrototype)
 			ld.PostSmoother = ld.PreSmoother;
@@ -1679,7 +1727,7 @@ presmooth_and_restriction(int lev)
 			}
 
 		//	c) update the defect with this correction ...
-			lf.A->apply_sub(*lf.sd, *lf.st);
+			update_smoothing_defect(lev);
 
 		//	d) ... and add the correction to the overall correction
 			if(nu < m_numPreSmooth-1)
@@ -1778,35 +1826,27 @@ prolongation_and_postsmooth(int lev)
 	UG_DLOG(LIB_DISC_MULTIGRID, 3, "gmg-start - prolongation on level "<<lev<<"\n");
 	log_debug_data(lev, "BeforeProlong");
 
+//	check if the prolongated correction must be sent to v-slaves
+	bool bVertCom = false;
+	#ifdef UG_PARALLEL
+	bVertCom = !lf.t->layouts()->vertical_slave().empty() ||
+				!lf.t->layouts()->vertical_master().empty();
+	#endif
+
 //	ADAPTIVE CASE:
-	if(lev > m_LocalFullRefLevel)
+//	the surface correction and the rim defect only depend on the coarse
+//	correction. If overlapping, they are updated during the communication.
+	if(!(m_bCommCompOverlap && bVertCom))
 	{
-		//	write computed correction to surface
-		GMG_PROFILE_BEGIN(GMG_AddCorrectionToSurface);
-		try{
-			const std::vector<SurfLevelMap>& vMap = lc.vSurfLevelMap;
-			for(size_t i = 0; i < vMap.size(); ++i){
-				(*m_pC)[vMap[i].surfIndex] += (*lc.sc)[vMap[i].levIndex];
-			}
-		}
-		UG_CATCH_THROW("GMG::lmgc: Cannot add to surface.");
-		GMG_PROFILE_END();
-
-		//	in the adaptive case there is a small part of the coarse coupling that
-		//	has not been used to update the defect. In order to ensure, that the
-		//	defect on this level still corresponds to the updated defect, we need
-		//	to add it here.
-		GMG_PROFILE_BEGIN(GMG_UpdateRimDefect);
-		lc.RimCpl_Fine_Coarse.matmul_minus(*lf.sd, *lc.sc);
-		GMG_PROFILE_END();
+		if(lev > m_LocalFullRefLevel)
+			add_correction_and_update_rim_defect(lev);
+		log_debug_data(lev, "AfterCoarseGridDefect");
 	}
-	log_debug_data(lev, "AfterCoarseGridDefect");
 
 //	PROLONGATE:
 	SmartPtr<GF> spT = lf.st;
 	#ifdef UG_PARALLEL
-	if( !lf.t->layouts()->vertical_slave().empty() ||
-		!lf.t->layouts()->vertical_master().empty())
+	if(bVertCom)
 	{
 		spT = lf.t;
 	}
@@ -1820,8 +1860,7 @@ prolongation_and_postsmooth(int lev)
 
 //	PARALLEL CASE:
 #ifdef UG_PARALLEL
-	if( !lf.t->layouts()->vertical_slave().empty() ||
-		!lf.t->layouts()->vertical_master().empty())
+	if(bVertCom)
 	{
 		UG_DLOG(LIB_DISC_MULTIGRID, 3, "gmg-start - copy_to_vertical_slaves\n");
 
@@ -1832,8 +1871,22 @@ prolongation_and_postsmooth(int lev)
 		ComPol_VecCopy<vector_type> cpVecCopy(lf.t.get());
 		m_Com.receive_data(lf.t->layouts()->vertical_slave(), cpVecCopy);
 		m_Com.send_data(lf.t->layouts()->vertical_master(), cpVecCopy);
-		m_Com.communicate();
+		m_Com.communicate_and_resume();
 		GMG_PROFILE_END();
+		if(!m_bCommCompOverlap){
+			GMG_PROFILE_BEGIN(GMG_Prolongate_RecieveAndExtract_NoOverlap);
+			m_Com.wait();
+			GMG_PROFILE_END();
+		}
+		else{
+			if(lev > m_LocalFullRefLevel)
+				add_correction_and_update_rim_defect(lev);
+
+			GMG_PROFILE_BEGIN(GMG_Prolongate_RecieveAndExtract_WithOverlap);
+			m_Com.wait();
+			GMG_PROFILE_END();
+			log_debug_data(lev, "AfterCoarseGridDefect");
+		}
 
 		GMG_PROFILE_BEGIN(GMG_Prolongate_GhostToNoghost);
 		copy_ghost_to_noghost(lf.st, lf.t, lf.vMapPatchToGlobal);
@@ -1865,7 +1918,7 @@ prolongation_and_postsmooth(int lev)
 		for(int nu = 0; nu < m_numPostSmooth; ++nu)
 		{
 		//	update defect
-			lf.A->apply_sub(*lf.sd, *lf.st);
+			update_smoothing_defect(lev);
 
 			if(nu == 0){
 				log_debug_data(lev, "BeforePostSmooth");
@@ -1899,7 +1952,7 @@ prolongation_and_postsmooth(int lev)
 //	We also need it if we want to write stats or debug data
 	if(lev >= m_LocalFullRefLevel || m_mgstats.valid() || m_spDebugWriter.valid()){
 		GMG_PROFILE_BEGIN(GMG_UpdateDefectAfterPostSmooth);
-		lf.A->apply_sub(*lf.sd, *lf.st);
+		update_smoothing_defect(lev);
 		GMG_PROFILE_END();
 	}
 
@@ -1908,6 +1961,33 @@ prolongation_and_postsmooth(int lev)
 	UG_DLOG(LIB_DISC_MULTIGRID, 3, "gmg-stop - postsmooth on level "<<lev<<"\n");
 }
 
+template <typename TDomain, typename TAlgebra>
+void AssembledMultiGridCycle<TDomain, TAlgebra>::
+add_correction_and_update_rim_defect(int lev)
+{
+	LevData& lf = *m_vLevData[lev];
+	LevData& lc = *m_vLevData[lev-1];
+
+	//	write computed correction to surface
+	GMG_PROFILE_BEGIN(GMG_AddCorrectionToSurface);
+	try{
+		const std::vector<SurfLevelMap>& vMap = lc.vSurfLevelMap;
+		for(size_t i = 0; i < vMap.size(); ++i){
+			(*m_pC)[vMap[i].surfIndex] += (*lc.sc)[vMap[i].levIndex];
+		}
+	}
+	UG_CATCH_THROW("GMG::lmgc: Cannot add to surface.");
+	GMG_PROFILE_END();
+
+	//	in the adaptive case there is a small part of the coarse coupling that
+	//	has not been used to update the defect. In order to ensure, that the
+	//	defect on this level still corresponds to the updated defect, we need
+	//	to add it here.
+	GMG_PROFILE_BEGIN(GMG_UpdateRimDefect);
+	lc.RimCpl_Fine_Coarse.matmul_minus(*lf.sd, *lc.sc);
+	GMG_PROFILE_END();
+}
+
 // performs the base solving
 template <typename TDomain, typename TAlgebra>
 void AssembledMultiGridCycle<TDomain, TAlgebra>::
@@ -2024,6 +2104,32 @@ base_solve(int lev)
 	UG_CATCH_THROW("GMG: Base Solver failed.");
 }
 
+template <typename TDomain, typename TAlgebra>
+void AssembledMultiGridCycle<TDomain, TAlgebra>::
+update_smoothing_defect(int lev)
+{
+	LevData& ld = *m_vLevData[lev];
+	if(use_level_operator(lev)){
+		ld.LevOp->apply_sub(*ld.sd, *ld.st);
+		return;
+	}
+	if(!m_bMixedPrecision){
+		ld.A->apply_sub(*ld.sd, *ld.st);
+		return;
+	}
+
+//	sd -= A*st (same storage types as for the parallel matrix)
+	#ifdef UG_PARALLEL
+	if(!ld.st->has_storage_type(PST_CONSISTENT) || !ld.sd->has_storage_type(PST_ADDITIVE))
+		UG_THROW("GMG: Defect update on level "<<lev<<" requires consistent "
+				"correction and additive defect.");
+	#endif
+	ld.singleA.axpy(*ld.sd, 1.0, *ld.sd, -1.0, *ld.st);
+	#ifdef UG_PARALLEL
+	ld.sd->set_storage_type(PST_ADDITIVE);
+	#endif
+}
+
 // performs a  multi grid cycle on the level
 template <typename TDomain, typename TAlgebra>
 void AssembledMultiGridCycle<TDomain, TAlgebra>::
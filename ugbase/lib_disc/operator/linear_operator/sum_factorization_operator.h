@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__SUM_FACTORIZATION_OPERATOR__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__SUM_FACTORIZATION_OPERATOR__
+
+#include <vector>
+
+#include "lib_algebra/operator/interface/linear_operator.h"
+#include "lib_algebra/operator/interface/linear_iterator.h"
+#include "lib_algebra/operator/interface/matrix_operator.h"
+#include "lib_disc/function_spaces/approximation_space.h"
+#include "lib_grid/tools/grid_level.h"
+#include "level_operator_interface.h"
+
+namespace ug{
+
+///	matrix-free operator for high order Lagrange elements on tensor product meshes
+/**
+ * This operator applies the matrix of the bilinear form
+ *
+ * 		a(u,v) = \int_\Omega  k * grad u * grad v  +  c * u * v  dx
+ *
+ * for a scalar Lagrange function of arbitrary order p on a mesh consisting of
+ * edges (1d), quadrilaterals (2d) or hexahedra (3d) without assembling it.
+ * Shape functions and quadrature (Gauss-Legendre with p+1 points per
+ * direction) are tensor products of one dimensional rules, such that the
+ * element contribution is evaluated by sum factorization: the values and
+ * reference gradients at the quadrature points are computed by a sequence of
+ * 1d contractions, the geometric factors are applied pointwise and the result
+ * is tested by the transposed contractions. This reduces the work per element
+ * from O(p^(2d)) to O(d*p^(d+1)) and avoids storing the O(p^(2d)) element
+ * matrices.
+ *
+ * The geometric factors (k * w_q * |det J| * J^{-1} J^{-T} and c * w_q * |det J|)
+ * are precomputed in init(). Elements are processed in batches of
+ * sm_batchSize elements, stored such that the element index is the innermost
+ * (contiguous) index. Thus, all kernels run over the batch lanes in their
+ * innermost loop and are vectorized by the compiler.
+ *
+ * Rows of dofs on the subsets passed to add_dirichlet_subsets are replaced by
+ * the identity, as done for the assembled matrix by the dirichlet constraints.
+ *
+ * In parallel, u must be consistent and f is computed additive.
+ *
+ * The operator is an ILevelOperator and can thus be passed to the geometric
+ * multigrid (set_level_operator), which then uses a copy of it on every
+ * smoothing level instead of an assembled level matrix.
+ *
+ * \tparam	TDomain		domain type
+ * \tparam	TAlgebra	algebra type
+ */
+template <typename TDomain, typename TAlgebra>
+class SumFactorizationOperator
+	: public ILevelOperator<TAlgebra>
+{
+	public:
+	///	Type of Algebra
+		typedef TAlgebra algebra_type;
+
+	///	Type of Vector
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	world dimension
+		static const int dim = TDomain::dim;
+
+	///	number of elements processed simultaneously
+		static const size_t sm_batchSize = 4;
+
+	public:
+	///	Constructor
+		SumFactorizationOperator(SmartPtr<ApproximationSpace<TDomain> > spApproxSpace,
+		                         const char* fct);
+
+	///	sets the diffusion coefficient k
+		void set_diffusion(number k) {m_diffusion = k; m_bInit = false;}
+
+	///	sets the reaction coefficient c
+		void set_reaction(number c) {m_reaction = c; m_bInit = false;}
+
+	///	adds subsets, on which the rows are replaced by the identity
+		void add_dirichlet_subsets(const char* subsets);
+
+	///	sets the grid level the operator works on
+		void set_level(const GridLevel& gl) {this->set_grid_level(gl);}
+
+	///	returns the grid level
+		const GridLevel& level() const {return this->grid_level();}
+
+	///	invalidates the precomputed data
+		virtual void grid_level_has_changed() {m_bInit = false;}
+
+	///	returns a copy with the same settings (not initialized)
+		virtual SmartPtr<ILevelOperator<TAlgebra> > clone();
+
+	///	precomputes the geometric factors
+		virtual void init();
+
+	///	precomputes the geometric factors (the operator is linear)
+		virtual void init(const vector_type& u) {init();}
+
+	///	f := A*u
+		virtual void apply(vector_type& f, const vector_type& u);
+
+	///	f := f - A*u
+		virtual void apply_sub(vector_type& f, const vector_type& u);
+
+	///	returns the (consistent) diagonal of the operator
+		const vector_type& diagonal();
+
+	///	returns the polynomial order
+		size_t order() const {return m_order;}
+
+	///	returns the number of elements
+		size_t num_elements() const {return m_numElem;}
+
+	///	Destructor
+		virtual ~SumFactorizationOperator() {};
+
+	protected:
+	///	collects elements, indices and geometric factors
+		void init_elements();
+
+	///	collects the dirichlet indices
+		void init_dirichlet();
+
+	///	computes the diagonal
+		void init_diagonal();
+
+	///	applies the element operators of a batch to the lane data in m_vU
+		void apply_batch(size_t b);
+
+	///	contracts direction d of a lane tensor by a nrow x ncol matrix
+		void contract(number* out, const number* in, const number* M,
+		              size_t nrow, size_t ncol, int d, const size_t* shape,
+		              bool bAdd) const;
+
+	///	number of geometric factors per quadrature point
+		static const size_t numGeom = dim*(dim+1)/2 + 1;
+
+	protected:
+	///	approximation space and function
+		SmartPtr<ApproximationSpace<TDomain> > m_spApproxSpace;
+		std::string m_fctName;
+
+	///	coefficients
+		number m_diffusion, m_reaction;
+
+	///	dirichlet subsets and dofs
+		std::vector<std::string> m_vDirichletSubset;
+		std::vector<DoFIndex> m_vDirichletInd;
+
+	///	flag if initialized
+		bool m_bInit;
+
+	///	order, 1d dofs and 1d quadrature points
+		size_t m_order, m_n, m_nq;
+
+	///	1d shape values B(q,i) and derivatives D(q,i) at quadrature points
+		std::vector<number> m_vB, m_vD;
+
+	///	transposed 1d shape values and derivatives
+		std::vector<number> m_vBt, m_vDt;
+
+	///	number of elements and batches
+		size_t m_numElem, m_numBatch;
+
+	///	indices per batch, dof (lexicographic) and lane
+		std::vector<DoFIndex> m_vInd;
+
+	///	geometric factors per batch, quadrature point, factor and lane
+		std::vector<number> m_vGeom;
+
+	///	lane buffers for the sum factorization
+		std::vector<number> m_vU, m_vT[2*(dim+1)];
+
+	///	diagonal
+		SmartPtr<vector_type> m_spDiag;
+
+	///	temporary for apply_sub
+		SmartPtr<vector_type> m_spTmp;
+};
+
+
+///	Jacobi smoother for the SumFactorizationOperator
+/**
+ * This smoother computes c = damp * D^{-1} d, where D is the diagonal of a
+ * SumFactorizationOperator, computed without assembling the matrix. It is
+ * intended as the smoother for matrix-free (e.g. Chebyshev or Krylov
+ * accelerated) iterations and for the geometric multigrid with level
+ * operators. If initialized with an assembled matrix operator, the diagonal
+ * is taken from the matrix, such that the same smoother can be used on
+ * levels with and without assembled matrices.
+ *
+ * \tparam	TDomain		domain type
+ * \tparam	TAlgebra	algebra type
+ */
+template <typename TDomain, typename TAlgebra>
+class MatrixFreeJacobi
+	: public ILinearIterator<typename TAlgebra::vector_type>
+{
+	public:
+	///	Type of Vector
+		typedef typename TAlgebra::vector_type vector_type;
+
+	///	Type of Matrix
+		typedef typename TAlgebra::matrix_type matrix_type;
+
+	///	Type of operator
+		typedef SumFactorizationOperator<TDomain, TAlgebra> op_type;
+
+	///	Type of assembled operator
+		typedef MatrixOperator<matrix_type, vector_type> matrix_op_type;
+
+	///	Base type
+		typedef ILinearIterator<vector_type> base_type;
+
+	protected:
+		using base_type::damping;
+
+	public:
+	///	Constructor
+		MatrixFreeJacobi() {}
+
+	///	Constructor setting the damping
+		MatrixFreeJacobi(number damp) {this->set_damp(damp);}
+
+	///	name
+		virtual const char* name() const {return "MatrixFreeJacobi";}
+
+	///	returns if parallel solving is supported
+		virtual bool supports_parallel() const {return true;}
+
+	///	initializes the smoother for an operator
+		virtual bool init(SmartPtr<ILinearOperator<vector_type> > J, const vector_type& u)
+		{return init(J);}
+
+	///	initializes the smoother for an operator
+		virtual bool init(SmartPtr<ILinearOperator<vector_type> > L);
+
+	///	computes the correction c = damp * D^{-1} d
+		virtual bool apply(vector_type& c, const vector_type& d);
+
+	///	computes the correction and updates the defect d := d - A*c
+		virtual bool apply_update_defect(vector_type& c, vector_type& d);
+
+	///	clone
+		virtual SmartPtr<ILinearIterator<vector_type> > clone()
+		{
+			SmartPtr<MatrixFreeJacobi> clone(new MatrixFreeJacobi());
+			clone->set_damp(damping());
+			return clone;
+		}
+
+	protected:
+	///	operator
+		SmartPtr<ILinearOperator<vector_type> > m_spOp;
+
+	///	matrix-free operator (if used)
+		SmartPtr<op_type> m_spSumFactOp;
+
+	///	(consistent) diagonal of an assembled operator
+		SmartPtr<vector_type> m_spMatDiag;
+};
+
+} // end namespace ug
+
+#include "sum_factorization_operator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__SUM_FACTORIZATION_OPERATOR__ */
@@ -0,0 +1,581 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__SUM_FACTORIZATION_OPERATOR_IMPL__
+#define __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__SUM_FACTORIZATION_OPERATOR_IMPL__
+
+#include <algorithm>
+#include <cmath>
+
+#include "sum_factorization_operator.h"
+#include "common/profiler/profiler.h"
+#include "common/util/string_util.h"
+#include "lib_disc/domain_util.h"
+#include "lib_disc/domain_traits.h"
+#include "lib_disc/quadrature/gauss_legendre/gauss_legendre.h"
+#include "lib_disc/local_finite_element/local_finite_element_provider.h"
+#include "lib_disc/local_finite_element/common/lagrange1d.h"
+#include "lib_disc/reference_element/reference_mapping_provider.h"
+
+namespace ug{
+
+////////////////////////////////////////////////////////////////////////////////
+// SumFactorizationOperator
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TDomain, typename TAlgebra>
+SumFactorizationOperator<TDomain, TAlgebra>::
+SumFactorizationOperator(SmartPtr<ApproximationSpace<TDomain> > spApproxSpace,
+                         const char* fct)
+	: m_spApproxSpace(spApproxSpace), m_fctName(fct),
+	  m_diffusion(1.0), m_reaction(0.0), m_bInit(false),
+	  m_order(0), m_n(0), m_nq(0), m_numElem(0), m_numBatch(0)
+{
+	if(m_spApproxSpace.invalid())
+		UG_THROW("SumFactorizationOperator: Approximation space not set.");
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::
+add_dirichlet_subsets(const char* subsets)
+{
+	std::vector<std::string> vSubset = TokenizeTrimString(std::string(subsets));
+	m_vDirichletSubset.insert(m_vDirichletSubset.end(), vSubset.begin(), vSubset.end());
+	m_bInit = false;
+}
+
+template <typename TDomain, typename TAlgebra>
+SmartPtr<ILevelOperator<TAlgebra> >
+SumFactorizationOperator<TDomain, TAlgebra>::clone()
+{
+	SmartPtr<SumFactorizationOperator> op(
+			new SumFactorizationOperator(m_spApproxSpace, m_fctName.c_str()));
+	op->set_diffusion(m_diffusion);
+	op->set_reaction(m_reaction);
+	op->m_vDirichletSubset = m_vDirichletSubset;
+	op->set_grid_level(this->m_gl);
+	return op;
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::init()
+{
+	PROFILE_BEGIN_GROUP(SumFactorizationOperator_init, "discretization");
+
+	init_elements();
+	init_dirichlet();
+	init_diagonal();
+	m_bInit = true;
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::init_elements()
+{
+	typedef typename domain_traits<dim>::grid_base_object TElem;
+	typedef typename DoFDistribution::traits<TElem>::const_iterator TIter;
+
+	ConstSmartPtr<DoFDistribution> dd = m_spApproxSpace->dof_distribution(this->m_gl);
+	const size_t fct = dd->fct_id_by_name(m_fctName.c_str());
+	const LFEID& lfeid = dd->lfeid(fct);
+
+	if(lfeid.type() != LFEID::LAGRANGE)
+		UG_THROW("SumFactorizationOperator: Function '"<<m_fctName<<
+		         "' must be a Lagrange function, but is "<<lfeid);
+	if(dd->num_fct() != 1)
+		UG_THROW("SumFactorizationOperator: Only a single function per "
+				"approximation space supported, but "<<dd->num_fct()<<" given.");
+
+//	tensor product reference element
+	ReferenceObjectID roid = ROID_UNKNOWN;
+	switch(dim){
+		case 1: roid = ROID_EDGE; break;
+		case 2: roid = ROID_QUADRILATERAL; break;
+		case 3: roid = ROID_HEXAHEDRON; break;
+	}
+
+//	1d shape functions at the 1d quadrature points
+	m_order = lfeid.order();
+	m_n = m_order + 1;
+	GaussLegendre quad(2*m_order+1);
+	m_nq = quad.size();
+
+	m_vB.resize(m_nq*m_n); m_vD.resize(m_nq*m_n);
+	m_vBt.resize(m_nq*m_n); m_vDt.resize(m_nq*m_n);
+	for(size_t i = 0; i < m_n; ++i){
+		EquidistantLagrange1D phi(i, m_order);
+		Polynomial1D dphi = phi.derivative();
+		for(size_t q = 0; q < m_nq; ++q){
+			const number x = quad.point(q)[0];
+			m_vB[q*m_n + i] = m_vBt[i*m_nq + q] = phi.value(x);
+			m_vD[q*m_n + i] = m_vDt[i*m_nq + q] = dphi.value(x);
+		}
+	}
+
+//	lexicographic numbering of the local dofs
+	const DimLocalDoFSet<dim>& dofSet
+		= LocalFiniteElementProvider::get_dofs<dim>(roid, lfeid);
+	size_t nDoF = 1, nQP = 1;
+	for(int d = 0; d < dim; ++d) {nDoF *= m_n; nQP *= m_nq;}
+	if(dofSet.num_dof() != nDoF)
+		UG_THROW("SumFactorizationOperator: Expected "<<nDoF<<" dofs per "
+				"element, but local dof set has "<<dofSet.num_dof());
+
+	std::vector<size_t> vLex(nDoF);
+	for(size_t i = 0; i < nDoF; ++i){
+		MathVector<dim> pos;
+		if(!dofSet.position(i, pos))
+			UG_THROW("SumFactorizationOperator: No dof position available.");
+		size_t lex = 0, stride = 1;
+		for(int d = 0; d < dim; ++d, stride *= m_n)
+			lex += stride * (size_t)std::floor(pos[d] * m_order + 0.5);
+		vLex[i] = lex;
+	}
+
+//	count elements
+	const static size_t VL = sm_batchSize;
+	m_numElem = 0;
+	for(int si = 0; si < dd->num_subsets(); ++si){
+		if(!dd->is_def_in_subset(fct, si)) continue;
+		for(TIter iter = dd->template begin<TElem>(si);
+				iter != dd->template end<TElem>(si); ++iter){
+			if((*iter)->reference_object_id() != roid)
+				UG_THROW("SumFactorizationOperator: Only "<<roid<<" elements "
+						"supported, but subset "<<si<<" contains a "<<
+						(*iter)->reference_object_id());
+			++m_numElem;
+		}
+	}
+	m_numBatch = (m_numElem + VL - 1) / VL;
+
+	m_vInd.resize(m_numBatch*nDoF*VL);
+	m_vGeom.assign(m_numBatch*nQP*numGeom*VL, 0.0);
+
+//	quadrature points and weights of the tensor product rule
+	std::vector<MathVector<dim> > vQP(nQP);
+	std::vector<number> vWeight(nQP);
+	for(size_t q = 0; q < nQP; ++q){
+		size_t r = q; vWeight[q] = 1.0;
+		for(int d = 0; d < dim; ++d, r /= m_nq){
+			vQP[q][d] = quad.point(r % m_nq)[0];
+			vWeight[q] *= quad.weight(r % m_nq);
+		}
+	}
+
+//	collect indices and geometric factors
+	const TDomain& dom = *m_spApproxSpace->domain();
+	std::vector<MathVector<dim> > vCorner;
+	std::vector<DoFIndex> vElemInd;
+	MathMatrix<dim, dim> JTInv;
+	size_t e = 0;
+	for(int si = 0; si < dd->num_subsets(); ++si){
+		if(!dd->is_def_in_subset(fct, si)) continue;
+		for(TIter iter = dd->template begin<TElem>(si);
+				iter != dd->template end<TElem>(si); ++iter, ++e){
+			TElem* elem = *iter;
+			const size_t b = e / VL, l = e % VL;
+
+			dd->dof_indices(elem, fct, vElemInd);
+			for(size_t i = 0; i < nDoF; ++i)
+				m_vInd[(b*nDoF + vLex[i])*VL + l] = vElemInd[i];
+
+			CollectCornerCoordinates(vCorner, *elem, dom);
+			DimReferenceMapping<dim, dim>& map
+				= ReferenceMappingProvider::get<dim, dim>(roid, vCorner);
+
+			for(size_t q = 0; q < nQP; ++q){
+				const number det = map.jacobian_transposed_inverse(JTInv, vQP[q]);
+				const number w = vWeight[q] * std::fabs(det);
+				number* g = &m_vGeom[(b*nQP + q)*numGeom*VL + l];
+
+			//	w * k * J^{-1} J^{-T} (upper triangle, row-wise)
+				size_t cmp = 0;
+				for(int i = 0; i < dim; ++i)
+					for(int j = i; j < dim; ++j, ++cmp){
+						number s = 0.0;
+						for(int k = 0; k < dim; ++k) s += JTInv(k, i) * JTInv(k, j);
+						g[cmp*VL] = w * m_diffusion * s;
+					}
+				g[cmp*VL] = w * m_reaction;
+			}
+		}
+	}
+
+//	padded lanes use the indices of the first lane (with zero factors)
+	for(size_t l = m_numElem % VL; l != 0 && l < VL; ++l)
+		for(size_t i = 0; i < nDoF; ++i)
+			m_vInd[((m_numBatch-1)*nDoF + i)*VL + l]
+			       = m_vInd[((m_numBatch-1)*nDoF + i)*VL];
+
+//	lane buffers
+	size_t bufSize = VL;
+	for(int d = 0; d < dim; ++d) bufSize *= std::max(m_n, m_nq);
+	m_vU.resize(bufSize);
+	for(size_t k = 0; k < 2*(dim+1); ++k) m_vT[k].resize(bufSize);
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::init_dirichlet()
+{
+	ConstSmartPtr<DoFDistribution> dd = m_spApproxSpace->dof_distribution(this->m_gl);
+	const size_t fct = dd->fct_id_by_name(m_fctName.c_str());
+
+	m_vDirichletInd.clear();
+	if(m_vDirichletSubset.empty()) return;
+
+	SubsetGroup ssGrp(dd->subset_handler(), m_vDirichletSubset);
+	std::vector<DoFIndex> vInd;
+	for(size_t s = 0; s < ssGrp.size(); ++s){
+		const int si = ssGrp[s];
+		if(!dd->is_def_in_subset(fct, si)) continue;
+
+		for(DoFDistribution::traits<Vertex>::const_iterator iter = dd->template begin<Vertex>(si);
+				iter != dd->template end<Vertex>(si); ++iter){
+			dd->inner_dof_indices(*iter, fct, vInd);
+			m_vDirichletInd.insert(m_vDirichletInd.end(), vInd.begin(), vInd.end());
+		}
+		if(dim >= 2)
+		for(DoFDistribution::traits<Edge>::const_iterator iter = dd->template begin<Edge>(si);
+				iter != dd->template end<Edge>(si); ++iter){
+			dd->dof_indices(*iter, fct, vInd);
+			m_vDirichletInd.insert(m_vDirichletInd.end(), vInd.begin(), vInd.end());
+		}
+		if(dim >= 3)
+		for(DoFDistribution::traits<Face>::const_iterator iter = dd->template begin<Face>(si);
+				iter != dd->template end<Face>(si); ++iter){
+			dd->dof_indices(*iter, fct, vInd);
+			m_vDirichletInd.insert(m_vDirichletInd.end(), vInd.begin(), vInd.end());
+		}
+	}
+
+	std::sort(m_vDirichletInd.begin(), m_vDirichletInd.end());
+	m_vDirichletInd.erase(std::unique(m_vDirichletInd.begin(), m_vDirichletInd.end()),
+	                      m_vDirichletInd.end());
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::init_diagonal()
+{
+	ConstSmartPtr<DoFDistribution> dd = m_spApproxSpace->dof_distribution(this->m_gl);
+	const static size_t VL = sm_batchSize;
+
+	m_spDiag = SmartPtr<vector_type>(new vector_type(dd->num_indices()));
+	vector_type& diag = *m_spDiag;
+	diag.set(0.0);
+#ifdef UG_PARALLEL
+	diag.set_layouts(dd->layouts());
+	diag.set_storage_type(PST_ADDITIVE);
+#endif
+
+	size_t nDoF = 1, nQP = 1;
+	for(int d = 0; d < dim; ++d) {nDoF *= m_n; nQP *= m_nq;}
+
+//	d_i = sum_q (grad phi_i)^T G_q (grad phi_i) + m_q phi_i^2
+	std::vector<number> vVal(nQP*nDoF), vGrad(nQP*nDoF*dim);
+	for(size_t i = 0; i < nDoF; ++i)
+		for(size_t q = 0; q < nQP; ++q){
+			size_t ri = i, rq = q;
+			number val = 1.0;
+			number* grad = &vGrad[(i*nQP + q)*dim];
+			for(int j = 0; j < dim; ++j) grad[j] = 1.0;
+			for(int d = 0; d < dim; ++d, ri /= m_n, rq /= m_nq){
+				const number b = m_vB[(rq % m_nq)*m_n + ri % m_n];
+				const number db = m_vD[(rq % m_nq)*m_n + ri % m_n];
+				val *= b;
+				for(int j = 0; j < dim; ++j) grad[j] *= (j == d) ? db : b;
+			}
+			vVal[i*nQP + q] = val;
+		}
+
+	for(size_t b = 0; b < m_numBatch; ++b)
+		for(size_t l = 0; l < VL && b*VL + l < m_numElem; ++l)
+			for(size_t i = 0; i < nDoF; ++i){
+				number s = 0.0;
+				for(size_t q = 0; q < nQP; ++q){
+					const number* g = &m_vGeom[(b*nQP + q)*numGeom*VL + l];
+					const number* grad = &vGrad[(i*nQP + q)*dim];
+					size_t cmp = 0;
+					for(int j = 0; j < dim; ++j)
+						for(int k = j; k < dim; ++k, ++cmp)
+							s += ((j == k) ? 1.0 : 2.0) * g[cmp*VL] * grad[j] * grad[k];
+					s += g[cmp*VL] * vVal[i*nQP + q] * vVal[i*nQP + q];
+				}
+				const DoFIndex& ind = m_vInd[(b*nDoF + i)*VL + l];
+				BlockRef(diag[ind[0]], ind[1]) += s;
+			}
+
+	for(size_t k = 0; k < m_vDirichletInd.size(); ++k)
+		BlockRef(diag[m_vDirichletInd[k][0]], m_vDirichletInd[k][1]) = 1.0;
+
+#ifdef UG_PARALLEL
+	diag.change_storage_type(PST_CONSISTENT);
+#endif
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::
+contract(number* out, const number* in, const number* M,
+         size_t nrow, size_t ncol, int d, const size_t* shape, bool bAdd) const
+{
+	size_t pre = sm_batchSize, post = 1;
+	for(int k = 0; k < d; ++k) pre *= shape[k];
+	for(int k = d+1; k < dim; ++k) post *= shape[k];
+
+	for(size_t b = 0; b < post; ++b)
+		for(size_t r = 0; r < nrow; ++r){
+			number* o = out + (b*nrow + r)*pre;
+			if(!bAdd) for(size_t a = 0; a < pre; ++a) o[a] = 0.0;
+			for(size_t c = 0; c < ncol; ++c){
+				const number m = M[r*ncol + c];
+				const number* i = in + (b*ncol + c)*pre;
+				for(size_t a = 0; a < pre; ++a) o[a] += m * i[a];
+			}
+		}
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::apply_batch(size_t b)
+{
+	const static size_t VL = sm_batchSize;
+	const bool bMass = (m_reaction != 0.0);
+
+//	buffers: index d for the d-th gradient component, index dim for values
+	number* src[dim+1]; number* dst[dim+1];
+	for(int k = 0; k <= dim; ++k){
+		src[k] = &m_vT[k][0];
+		dst[k] = &m_vT[dim+1+k][0];
+	}
+	src[dim] = &m_vU[0];
+
+	size_t shape[dim];
+	for(int d = 0; d < dim; ++d) shape[d] = m_n;
+
+//	values and reference gradients at the quadrature points
+	for(int d = 0; d < dim; ++d){
+		if(bMass || d < dim-1)
+			contract(dst[dim], src[dim], &m_vB[0], m_nq, m_n, d, shape, false);
+		contract(dst[d], src[dim], &m_vD[0], m_nq, m_n, d, shape, false);
+		for(int k = 0; k < d; ++k)
+			contract(dst[k], src[k], &m_vB[0], m_nq, m_n, d, shape, false);
+		shape[d] = m_nq;
+		if(d == 0) src[dim] = &m_vT[dim][0];
+		for(int k = 0; k <= dim; ++k) std::swap(src[k], dst[k]);
+	}
+
+//	apply the geometric factors
+	size_t nQP = 1;
+	for(int d = 0; d < dim; ++d) nQP *= m_nq;
+	const number* geom = &m_vGeom[b*nQP*numGeom*VL];
+	for(size_t q = 0; q < nQP; ++q, geom += numGeom*VL){
+		const size_t o = q*VL;
+		size_t cmp = 0;
+		for(int j = 0; j < dim; ++j){
+			for(size_t l = 0; l < VL; ++l) dst[j][o+l] = 0.0;
+		}
+		for(int j = 0; j < dim; ++j)
+			for(int k = j; k < dim; ++k, ++cmp){
+				const number* g = geom + cmp*VL;
+				for(size_t l = 0; l < VL; ++l){
+					dst[j][o+l] += g[l] * src[k][o+l];
+					if(k != j) dst[k][o+l] += g[l] * src[j][o+l];
+				}
+			}
+		if(bMass){
+			const number* g = geom + cmp*VL;
+			for(size_t l = 0; l < VL; ++l) dst[dim][o+l] = g[l] * src[dim][o+l];
+		}
+	}
+	for(int k = 0; k <= dim; ++k) std::swap(src[k], dst[k]);
+
+//	test with the transposed contractions
+	for(int d = dim-1; d >= 0; --d){
+		if(bMass || d < dim-1){
+			contract(dst[dim], src[dim], &m_vBt[0], m_n, m_nq, d, shape, false);
+			contract(dst[dim], src[d], &m_vDt[0], m_n, m_nq, d, shape, true);
+		}
+		else
+			contract(dst[dim], src[d], &m_vDt[0], m_n, m_nq, d, shape, false);
+		for(int k = 0; k < d; ++k)
+			contract(dst[k], src[k], &m_vBt[0], m_n, m_nq, d, shape, false);
+		shape[d] = m_n;
+		for(int k = 0; k <= dim; ++k) std::swap(src[k], dst[k]);
+	}
+
+//	result
+	size_t nDoF = 1;
+	for(int d = 0; d < dim; ++d) nDoF *= m_n;
+	std::copy(src[dim], src[dim] + nDoF*VL, m_vU.begin());
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::
+apply(vector_type& f, const vector_type& u)
+{
+	PROFILE_BEGIN_GROUP(SumFactorizationOperator_apply, "discretization");
+	if(!m_bInit) init();
+
+	#ifdef UG_PARALLEL
+	if(!u.has_storage_type(PST_CONSISTENT))
+		UG_THROW("SumFactorizationOperator::apply: Inadequate storage format of u.");
+	#endif
+
+	if(f.size() != u.size())
+		UG_THROW("SumFactorizationOperator::apply: Size mismatch: f: "
+				<<f.size()<<", u: "<<u.size());
+
+	const static size_t VL = sm_batchSize;
+	size_t nDoF = 1;
+	for(int d = 0; d < dim; ++d) nDoF *= m_n;
+
+	f.set(0.0);
+	for(size_t b = 0; b < m_numBatch; ++b){
+		const DoFIndex* ind = &m_vInd[b*nDoF*VL];
+
+	//	gather
+		for(size_t i = 0; i < nDoF*VL; ++i)
+			m_vU[i] = BlockRef(u[ind[i][0]], ind[i][1]);
+
+		apply_batch(b);
+
+	//	scatter
+		for(size_t i = 0; i < nDoF*VL; ++i)
+			BlockRef(f[ind[i][0]], ind[i][1]) += m_vU[i];
+	}
+
+//	identity rows
+	for(size_t k = 0; k < m_vDirichletInd.size(); ++k){
+		const DoFIndex& ind = m_vDirichletInd[k];
+		BlockRef(f[ind[0]], ind[1]) = BlockRef(u[ind[0]], ind[1]);
+	}
+
+	#ifdef UG_PARALLEL
+	f.set_storage_type(PST_ADDITIVE);
+	#endif
+}
+
+template <typename TDomain, typename TAlgebra>
+void SumFactorizationOperator<TDomain, TAlgebra>::
+apply_sub(vector_type& f, const vector_type& u)
+{
+	#ifdef UG_PARALLEL
+	if(!f.has_storage_type(PST_ADDITIVE))
+		UG_THROW("SumFactorizationOperator::apply_sub: Inadequate storage format of f.");
+	#endif
+
+	if(m_spTmp.invalid() || m_spTmp->size() != f.size())
+		m_spTmp = f.clone_without_values();
+
+	apply(*m_spTmp, u);
+	f -= *m_spTmp;
+}
+
+template <typename TDomain, typename TAlgebra>
+const typename TAlgebra::vector_type&
+SumFactorizationOperator<TDomain, TAlgebra>::diagonal()
+{
+	if(!m_bInit) init();
+	return *m_spDiag;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// MatrixFreeJacobi
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TDomain, typename TAlgebra>
+bool MatrixFreeJacobi<TDomain, TAlgebra>::
+init(SmartPtr<ILinearOperator<vector_type> > L)
+{
+	m_spOp = L;
+	m_spSumFactOp = L.template cast_dynamic<op_type>();
+	m_spMatDiag = SPNULL;
+	if(m_spSumFactOp.valid()){
+		m_spSumFactOp->init();
+		return true;
+	}
+
+//	fall back to the diagonal of an assembled matrix
+	SmartPtr<matrix_op_type> spMat = L.template cast_dynamic<matrix_op_type>();
+	if(spMat.invalid())
+		UG_THROW("MatrixFreeJacobi: Operator must be a SumFactorizationOperator "
+				"or an assembled matrix operator.");
+
+	const matrix_type& A = *spMat;
+	m_spMatDiag = SmartPtr<vector_type>(new vector_type(A.num_rows()));
+	vector_type& diag = *m_spMatDiag;
+	for(size_t i = 0; i < diag.size(); ++i)
+		for(size_t k = 0; k < GetSize(diag[i]); ++k)
+			BlockRef(diag[i], k) = BlockRef(A(i, i), k, k);
+
+#ifdef UG_PARALLEL
+	diag.set_layouts(A.layouts());
+	diag.set_storage_type(PST_ADDITIVE);
+	diag.change_storage_type(PST_CONSISTENT);
+#endif
+	return true;
+}
+
+template <typename TDomain, typename TAlgebra>
+bool MatrixFreeJacobi<TDomain, TAlgebra>::
+apply(vector_type& c, const vector_type& d)
+{
+	PROFILE_BEGIN_GROUP(MatrixFreeJacobi_apply, "algebra");
+	if(m_spOp.invalid())
+		UG_THROW("MatrixFreeJacobi: Not initialized.");
+
+	const vector_type& diag = m_spSumFactOp.valid() ? m_spSumFactOp->diagonal()
+													: *m_spMatDiag;
+	const number damp = damping()->damping();
+
+//	c = damp * D^{-1} d (additive, since d is additive and D consistent)
+	for(size_t i = 0; i < c.size(); ++i)
+		for(size_t k = 0; k < GetSize(c[i]); ++k){
+			const number di = BlockRef(diag[i], k);
+			BlockRef(c[i], k) = (di != 0.0) ? damp * BlockRef(d[i], k) / di : 0.0;
+		}
+
+	#ifdef UG_PARALLEL
+	c.set_storage_type(PST_ADDITIVE);
+	c.change_storage_type(PST_CONSISTENT);
+	#endif
+	return true;
+}
+
+template <typename TDomain, typename TAlgebra>
+bool MatrixFreeJacobi<TDomain, TAlgebra>::
+apply_update_defect(vector_type& c, vector_type& d)
+{
+	if(!apply(c, d)) return false;
+	m_spOp->apply_sub(d, c);
+	return true;
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__OPERATOR__LINEAR_OPERATOR__SUM_FACTORIZATION_OPERATOR_IMPL__ */
@@ -34,6 +34,7 @@
 #define __H__UG__LIB_DISC__OPERATOR__NON_LINEAR_OPERATOR__NEWTON_SOLVER__NEWTON__
 
 #include <cmath>
+#include <algorithm>
 
 #include "lib_algebra/operator/interface/operator_inverse.h"
 #include "lib_algebra/operator/interface/linear_operator_inverse.h"
@@ -43,6 +44,7 @@
 #include "lib_disc/assemble_interface.h"
 #include "lib_disc/operator/non_linear_operator/assembled_non_linear_operator.h"
 #include "lib_disc/operator/linear_operator/assembled_linear_operator.h"
+#include "lib_disc/operator/linear_operator/jacobian_free_operator.h"
 #include "../line_search.h"
 #include "newton_update_interface.h"
 #include "lib_algebra/operator/debug_writer.h"
@@ -144,6 +146,77 @@ class NewtonSolver
 		void clear_step_update(SmartPtr<INewtonUpdate > NU)
 			{m_stepUpdate.clear();}
 
+	///	sets the operator used as Jacobian
+	/**
+	 * By default, the Jacobian is assembled as a matrix. Passing a
+	 * JacobianFreeOperator results in a Jacobian-free Newton-Krylov method:
+	 * the linear solver applies the exact Jacobian by finite differences,
+	 * while the assembled (possibly lagged, cf. set_jacobian_reuse) matrix of
+	 * the operator is only used by the preconditioner.
+	 */
+		void set_jacobian_operator(SmartPtr<AssembledLinearOperator<TAlgebra> > J)
+		{
+			m_J = J;
+			m_spJFO = J.template cast_dynamic<JacobianFreeOperator<TAlgebra> >();
+			renew_jacobian();
+		}
+
+	///	sets the maximum number of Newton steps a Jacobian is used for
+	/**
+	 * For maxSteps > 1, the Jacobian is only reassembled every maxSteps
+	 * Newton steps (modified Newton method). The Jacobian and the setup of
+	 * the linear solver are kept between calls of apply, as long as the
+	 * problem size does not change. A value of 1 (default) results in the
+	 * classical Newton method.
+	 */
+		void set_jacobian_reuse(int maxSteps) {m_maxJacobianAge = std::max(maxSteps, 1);}
+
+	///	sets the maximum number of Newton steps a linear solver setup is used for
+	/**
+	 * For maxSteps > 1, the linear solver (and thus its preconditioner, e.g.
+	 * ILU factorization or multigrid coarse operators) is only reinitialized
+	 * every maxSteps Newton steps, while the Jacobian may be reassembled more
+	 * often. Since the linear solver operates on the same Jacobian object, the
+	 * current Jacobian is solved for with a stale preconditioner. A value of
+	 * 1 (default) reinitializes the solver in every step.
+	 */
+		void set_preconditioner_reuse(int maxSteps) {m_maxPrecondAge = std::max(maxSteps, 1);}
+
+	///	sets the Newton contraction rate above which Jacobian and setup are renewed
+	/**
+	 * If the rate of the last Newton step exceeds the given value, the reused
+	 * Jacobian and linear solver setup are discarded and recomputed in the
+	 * next step, regardless of their age. Default: 0.5
+	 */
+		void set_reuse_contraction_limit(number rate) {m_reuseRateLimit = rate;}
+
+	///	enables adaptive linear tolerances (Eisenstat-Walker, choice 2)
+	/**
+	 * The relative reduction of the linear solver's convergence check (which
+	 * must be a StdConvCheck) is set in every Newton step to
+	 * 	eta_k = min(etaMax, gamma * (|F_k| / |F_{k-1}|)^alpha)
+	 * including the usual safeguards. The original reduction is restored
+	 * at the end of apply.
+	 */
+		void set_eisenstat_walker(bool bEnable) {m_bEisenstatWalker = bEnable;}
+
+	///	sets the parameters of the Eisenstat-Walker forcing terms
+		void set_eisenstat_walker_params(number etaMax, number gamma, number alpha)
+			{m_ewEtaMax = etaMax; m_ewGamma = gamma; m_ewAlpha = alpha;}
+
+	///	number of Jacobian assemblies and linear solver setups (since last clear)
+	/// \{
+		int num_jacobian_assemblies() const {return m_numJacobianAssemblies;}
+		int num_linsolver_setups() const {return m_numLinSolverSetups;}
+	/// \}
+
+	private:
+	///	computes the Eisenstat-Walker forcing term for the current step
+		number forcing_term(int step, number defect, number rate);
+
+	///	discards reused Jacobian and linear solver setup
+		void renew_jacobian() {m_jacobianAge = m_maxJacobianAge; m_precondAge = m_maxPrecondAge;}
+
 	private:
 	///	help functions for debug output
 	///	\{
@@ -169,6 +242,8 @@ class NewtonSolver
 		SmartPtr<AssembledOperator<algebra_type> > m_N;
 	///	jacobi operator
 		SmartPtr<AssembledLinearOperator<algebra_type> > m_J;
+	///	jacobi operator, if matrix-free
+		SmartPtr<JacobianFreeOperator<algebra_type> > m_spJFO;
 	///	assembling
 		SmartPtr<IAssemble<TAlgebra> > m_spAss;
 
@@ -183,6 +258,26 @@ class NewtonSolver
 		int m_dgbCall;
 		int m_lastNumSteps;
 
+	///	reuse policy for Jacobian and linear solver setup
+	/// \{
+		int m_maxJacobianAge;
+		int m_maxPrecondAge;
+		number m_reuseRateLimit;
+		int m_jacobianAge;
+		int m_precondAge;
+		int m_numJacobianAssemblies;
+		int m_numLinSolverSetups;
+	/// \}
+
+	///	Eisenstat-Walker forcing terms
+	/// \{
+		bool m_bEisenstatWalker;
+		number m_ewEtaMax;
+		number m_ewGamma;
+		number m_ewAlpha;
+		number m_ewEta;
+	/// \}
+
 	/// convergence history of linear solver
 	/// \{
 		std::vector<int> m_vTotalLinSolverSteps;
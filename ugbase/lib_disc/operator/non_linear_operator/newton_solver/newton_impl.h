@@ -65,7 +65,19 @@ NewtonSolver(SmartPtr<ILinearOperatorInverse<vector_type> > LinearSolver,
 			m_J(NULL),
 			m_spAss(NULL),
 			m_dgbCall(0),
-			m_lastNumSteps(0)
+			m_lastNumSteps(0),
+			m_maxJacobianAge(1),
+			m_maxPrecondAge(1),
+			m_reuseRateLimit(0.5),
+			m_jacobianAge(0),
+			m_precondAge(0),
+			m_numJacobianAssemblies(0),
+			m_numLinSolverSetups(0),
+			m_bEisenstatWalker(false),
+			m_ewEtaMax(0.9),
+			m_ewGamma(0.9),
+			m_ewAlpha(0.5 * (1.0 + std::sqrt(5.0))),
+			m_ewEta(0.9)
 {};
 
 template <typename TAlgebra>
@@ -78,7 +90,19 @@ NewtonSolver() :
 	m_J(NULL),
 	m_spAss(NULL),
 	m_dgbCall(0),
-	m_lastNumSteps(0)
+	m_lastNumSteps(0),
+	m_maxJacobianAge(1),
+	m_maxPrecondAge(1),
+	m_reuseRateLimit(0.5),
+	m_jacobianAge(0),
+	m_precondAge(0),
+	m_numJacobianAssemblies(0),
+	m_numLinSolverSetups(0),
+	m_bEisenstatWalker(false),
+	m_ewEtaMax(0.9),
+	m_ewGamma(0.9),
+	m_ewAlpha(0.5 * (1.0 + std::sqrt(5.0))),
+	m_ewEta(0.9)
 {};
 
 template <typename TAlgebra>
@@ -91,7 +115,19 @@ NewtonSolver(SmartPtr<IOperator<vector_type> > N) :
 	m_J(NULL),
 	m_spAss(NULL),
 	m_dgbCall(0),
-	m_lastNumSteps(0)
+	m_lastNumSteps(0),
+	m_maxJacobianAge(1),
+	m_maxPrecondAge(1),
+	m_reuseRateLimit(0.5),
+	m_jacobianAge(0),
+	m_precondAge(0),
+	m_numJacobianAssemblies(0),
+	m_numLinSolverSetups(0),
+	m_bEisenstatWalker(false),
+	m_ewEtaMax(0.9),
+	m_ewGamma(0.9),
+	m_ewAlpha(0.5 * (1.0 + std::sqrt(5.0))),
+	m_ewEta(0.9)
 {
 	init(N);
 };
@@ -106,7 +142,19 @@ NewtonSolver(SmartPtr<IAssemble<TAlgebra> > spAss) :
 	m_J(NULL),
 	m_spAss(NULL),
 	m_dgbCall(0),
-	m_lastNumSteps(0)
+	m_lastNumSteps(0),
+	m_maxJacobianAge(1),
+	m_maxPrecondAge(1),
+	m_reuseRateLimit(0.5),
+	m_jacobianAge(0),
+	m_precondAge(0),
+	m_numJacobianAssemblies(0),
+	m_numLinSolverSetups(0),
+	m_bEisenstatWalker(false),
+	m_ewEtaMax(0.9),
+	m_ewGamma(0.9),
+	m_ewAlpha(0.5 * (1.0 + std::sqrt(5.0))),
+	m_ewEta(0.9)
 {
 	m_spAss = spAss;
 	m_N = SmartPtr<AssembledOperator<TAlgebra> >(new AssembledOperator<TAlgebra>(m_spAss));
@@ -153,11 +201,19 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 		UG_THROW("NewtonSolver::apply: Linear Solver not set.");
 
 //	Jacobian
+	if(m_spJFO.valid() && m_spJFO->discretization() != m_spAss)
+		UG_THROW("NewtonSolver::apply: Jacobian operator must use the "
+				"discretization of the nonlinear operator.");
 	if(m_J.invalid() || m_J->discretization() != m_spAss) {
 		m_J = make_sp(new AssembledLinearOperator<TAlgebra>(m_spAss));
+		renew_jacobian();
 	}
+	if(m_J->level() != m_N->level()) renew_jacobian();
 	m_J->set_level(m_N->level());
 
+//	a reused Jacobian must match the current problem size
+	if(m_J->get_matrix().num_rows() != u.size()) renew_jacobian();
+
 //	create tmp vectors
 	SmartPtr<vector_type> spD = u.clone_without_values();
 	SmartPtr<vector_type> spC = u.clone_without_values();
@@ -195,6 +251,24 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 // 	start convergence check
 	m_spConvCheck->start(*spD);
 
+//	adaptive linear tolerances need a standard convergence check
+	StdConvCheck<vector_type>* pLinConvCheck = NULL;
+	if(m_bEisenstatWalker)
+	{
+		pLinConvCheck = dynamic_cast<StdConvCheck<vector_type>*>
+							(m_spLinearSolver->convergence_check().get());
+		if(!pLinConvCheck)
+			UG_LOG("WARNING in 'NewtonSolver::apply': Eisenstat-Walker forcing "
+					"terms require a StdConvCheck for the linear solver. Ignored.\n");
+	}
+
+//	restores the linear reduction on every exit
+	struct ReductionGuard{
+		StdConvCheck<vector_type>* pConvCheck; number reduction;
+		~ReductionGuard() {if(pConvCheck) pConvCheck->set_reduction(reduction);}
+	} reductionGuard = {pLinConvCheck,
+						pLinConvCheck ? pLinConvCheck->relative_reduction() : 0.0};
+
 	for(size_t i = 0; i < m_stepUpdate.size(); ++i)
 		m_stepUpdate[i]->update();
 
@@ -211,29 +285,54 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 		for(size_t i = 0; i < m_innerStepUpdate.size(); ++i)
 			m_innerStepUpdate[i]->update();
 
-	// 	Compute Jacobian
-		try{
-		NEWTON_PROFILE_BEGIN(NewtonComputeJacobian);
-		m_J->init(u);
-		NEWTON_PROFILE_END();
-		}UG_CATCH_THROW("NewtonSolver::apply: Initialization of Jacobian failed.");
+	//	decide if Jacobian and linear solver setup are renewed. The setup is
+	//	only renewed together with the Jacobian, since otherwise nothing changed
+		const bool bRenewJ = (m_jacobianAge >= m_maxJacobianAge);
+		const bool bRenewSetup = bRenewJ && (m_precondAge >= m_maxPrecondAge);
 
-	//	Write Jacobian for debug
-		std::string matname("NEWTON_Jacobian");
-		matname.append(ext);
-		write_debug(m_J->get_matrix(), matname.c_str());
+	// 	Compute Jacobian
+		if(bRenewJ)
+		{
+			try{
+			NEWTON_PROFILE_BEGIN(NewtonComputeJacobian);
+			m_J->init(u);
+			NEWTON_PROFILE_END();
+			}UG_CATCH_THROW("NewtonSolver::apply: Initialization of Jacobian failed.");
+			m_jacobianAge = 0;
+			m_numJacobianAssemblies++;
+
+		//	Write Jacobian for debug
+			std::string matname("NEWTON_Jacobian");
+			matname.append(ext);
+			write_debug(m_J->get_matrix(), matname.c_str());
+		}
 
 	// 	Init Jacobi Inverse
-		try{
-		NEWTON_PROFILE_BEGIN(NewtonPrepareLinSolver);
-		if(!m_spLinearSolver->init(m_J, u))
+		if(bRenewSetup)
 		{
-			UG_LOG("ERROR in 'NewtonSolver::apply': Cannot init Inverse Linear "
-					"Operator for Jacobi-Operator.\n");
-			return false;
+			try{
+			NEWTON_PROFILE_BEGIN(NewtonPrepareLinSolver);
+			if(!m_spLinearSolver->init(m_J, u))
+			{
+				UG_LOG("ERROR in 'NewtonSolver::apply': Cannot init Inverse Linear "
+						"Operator for Jacobi-Operator.\n");
+				renew_jacobian();
+				return false;
+			}
+			NEWTON_PROFILE_END();
+			}UG_CATCH_THROW("NewtonSolver::apply: Initialization of Linear Solver failed.");
+			m_precondAge = 0;
+			m_numLinSolverSetups++;
 		}
-		NEWTON_PROFILE_END();
-		}UG_CATCH_THROW("NewtonSolver::apply: Initialization of Linear Solver failed.");
+
+	//	matrix-free Jacobian is always linearized at the current iterate
+		if(m_spJFO.valid())
+			m_spJFO->set_linearization_point(u, *spD);
+
+	//	set adaptive linear tolerance
+		if(pLinConvCheck)
+			pLinConvCheck->set_reduction(forcing_term(loopCnt, m_spConvCheck->defect(),
+			                                          m_spConvCheck->rate()));
 
 	// 	Solve Linearized System
 		try{
@@ -242,10 +341,13 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 		{
 			UG_LOG("ERROR in 'NewtonSolver::apply': Cannot apply Inverse Linear "
 					"Operator for Jacobi-Operator.\n");
+			renew_jacobian();
 			return false;
 		}
 		NEWTON_PROFILE_END();
 		}UG_CATCH_THROW("NewtonSolver::apply: Application of Linear Solver failed.");
+		m_jacobianAge++;
+		m_precondAge++;
 
 	//	store convergence history
 		const int numSteps = m_spLinearSolver->step();
@@ -266,6 +368,7 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 			{
 				UG_LOG("ERROR in 'NewtonSolver::apply': "
 						"Newton Solver did not converge.\n");
+				renew_jacobian();
 				return false;
 			}
 			NEWTON_PROFILE_END();
@@ -294,6 +397,10 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 		if(loopCnt-1 >= (int)m_vNonLinSolverRates.size()) m_vNonLinSolverRates.resize(loopCnt, 0);
 		m_vNonLinSolverRates[loopCnt-1] += m_spConvCheck->rate();
 
+	//	renew reused Jacobian and setup if the contraction degrades
+		if(!bRenewSetup && m_spConvCheck->rate() > m_reuseRateLimit)
+			renew_jacobian();
+
 	//	write defect for debug
 		std::string name("NEWTON_Defect"); name.append(ext);
 		write_debug(*spD, name.c_str());
@@ -306,7 +413,38 @@ bool NewtonSolver<TAlgebra>::apply(vector_type& u)
 	// reset offset of output for linear solver to previous value
 	m_spLinearSolver->convergence_check()->set_offset(stdLinOffset);
 
-	return m_spConvCheck->post();
+	const bool bSuccess = m_spConvCheck->post();
+	if(!bSuccess) renew_jacobian();
+	return bSuccess;
+}
+
+template <typename TAlgebra>
+number NewtonSolver<TAlgebra>::
+forcing_term(int step, number defect, number rate)
+{
+//	Eisenstat-Walker, choice 2, with safeguard against too small terms
+	number eta = m_ewEtaMax;
+	if(step > 0)
+	{
+		eta = m_ewGamma * std::pow(rate, m_ewAlpha);
+		const number etaSafe = m_ewGamma * std::pow(m_ewEta, m_ewAlpha);
+		if(etaSafe > 0.1) eta = std::max(eta, etaSafe);
+		eta = std::min(eta, m_ewEtaMax);
+	}
+
+//	avoid oversolving near the nonlinear tolerance (cf. Kelley, 1995)
+	StdConvCheck<vector_type>* pConvCheck =
+		dynamic_cast<StdConvCheck<vector_type>*>(m_spConvCheck.get());
+	if(pConvCheck && defect > 0.0 && pConvCheck->reduction() > 0.0)
+	{
+		const number initDefect = defect / pConvCheck->reduction();
+		const number tol = std::max(pConvCheck->minimum_defect(),
+		                            pConvCheck->relative_reduction() * initDefect);
+		eta = std::min(m_ewEtaMax, std::max(eta, 0.5 * tol / defect));
+	}
+
+	m_ewEta = eta;
+	return eta;
 }
 
 template <typename TAlgebra>
@@ -395,6 +533,8 @@ void NewtonSolver<TAlgebra>::clear_average_convergence()
 	m_vNonLinSolverRates.clear();
 	m_vLinSolverCalls.clear();
 	m_vTotalLinSolverSteps.clear();
+	m_numJacobianAssemblies = 0;
+	m_numLinSolverSetups = 0;
 }
 
 template <typename TAlgebra>
@@ -437,6 +577,13 @@ std::string NewtonSolver<TAlgebra>::config_string() const
 	ss << " LineSearch: ";
 	if(m_spLineSearch.valid())		ss << ConfigShift(m_spLineSearch->config_string()) << "\n";
 	else							ss << " not set.\n";
+	if(m_maxJacobianAge > 1 || m_maxPrecondAge > 1)
+		ss << " Reuse: Jacobian for " << m_maxJacobianAge << " steps, linear solver "
+		   "setup for " << m_maxPrecondAge << " steps, contraction limit "
+		   << m_reuseRateLimit << "\n";
+	if(m_bEisenstatWalker)
+		ss << " Eisenstat-Walker: etaMax = " << m_ewEtaMax << ", gamma = "
+		   << m_ewGamma << ", alpha = " << m_ewAlpha << "\n";
 	return ss.str();
 }
 
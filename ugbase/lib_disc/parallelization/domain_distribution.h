@@ -86,6 +86,22 @@ static bool DistributeDomain(TDomain& domainOut,
 							 PartitionMap& partitionMap,
 							 bool createVerticalInterfaces);
 
+///	writes the local parts of a distributed domain to a partitioned archive
+/**	Each process writes its part of the grid, the positions, the subset
+ * handlers and the horizontal and vertical interfaces into a common
+ * archive using MPI-IO (see SavePartitionedGrid).
+ * Only available in parallel builds.*/
+template <typename TDomain>
+static void SavePartitionedDomain(TDomain& domain, const char* filename);
+
+///	loads a domain written by SavePartitionedDomain
+/**	Each process only reads its own part of the archive, so that no
+ * distribution is required afterwards. The domain has to be empty and the
+ * number of processes has to match the number of processes used for writing.
+ * Only available in parallel builds.*/
+template <typename TDomain>
+static void LoadPartitionedDomain(TDomain& domain, const char* filename);
+
 }//	end of namespace
 
 ////////////////////////////////
@@ -41,6 +41,7 @@
 #ifdef UG_PARALLEL
 	#include "pcl/pcl.h"
 	#include "lib_grid/parallelization/distribution.h"
+	#include "lib_grid/parallelization/partitioned_grid_io.h"
 #endif
 
 
@@ -359,6 +360,35 @@ PartitionDistributedDomain_LevelBased(TDomain& domain, PartitionMap& partitionMa
 }
 
 
+#ifdef UG_PARALLEL
+///	adds serializers for the positions and all subset handlers of the domain
+template <typename TDomain>
+static void AddDomainDataSerializers(TDomain& domain,
+									 GridDataSerializationHandler& serializer)
+{
+	typedef typename TDomain::position_attachment_type	position_attachment_type;
+
+	SPVertexDataSerializer posSerializer =
+			GeomObjAttachmentSerializer<Vertex, position_attachment_type>::
+							create(*domain.grid(), domain.position_attachment());
+
+	SPGridDataSerializer shSerializer = SubsetHandlerSerializer::
+											create(*domain.subset_handler());
+
+	serializer.add(posSerializer);
+	serializer.add(shSerializer);
+
+	std::vector<std::string> additionalSHNames = domain.additional_subset_handler_names();
+	for(size_t i = 0; i < additionalSHNames.size(); ++i){
+		SmartPtr<ISubsetHandler> sh = domain.additional_subset_handler(additionalSHNames[i]);
+		if(sh.valid()){
+			SPGridDataSerializer shSerializer = SubsetHandlerSerializer::create(*sh);
+			serializer.add(shSerializer);
+		}
+	}
+}
+#endif
+
 template <typename TDomain>
 static bool DistributeDomain(TDomain& domainOut,
 							 PartitionMap& partitionMap,
@@ -378,8 +408,6 @@ static bool DistributeDomain(TDomain& domainOut,
 
 #ifdef UG_PARALLEL
 
-	typedef typename TDomain::position_attachment_type	position_attachment_type;
-	
 //	used to check whether all processes are correctly prepared for redistribution
 	//bool performDistribution = true;
 
@@ -409,25 +437,8 @@ static bool DistributeDomain(TDomain& domainOut,
 */
 
 //	data serialization
-	SPVertexDataSerializer posSerializer =
-			GeomObjAttachmentSerializer<Vertex, position_attachment_type>::
-								create(*pGrid, domainOut.position_attachment());
-
-	SPGridDataSerializer shSerializer = SubsetHandlerSerializer::
-											create(*domainOut.subset_handler());
-
 	GridDataSerializationHandler serializer;
-	serializer.add(posSerializer);
-	serializer.add(shSerializer);
-
-	std::vector<std::string> additionalSHNames = domainOut.additional_subset_handler_names();
-	for(size_t i = 0; i < additionalSHNames.size(); ++i){
-		SmartPtr<ISubsetHandler> sh = domainOut.additional_subset_handler(additionalSHNames[i]);
-		if(sh.valid()){
-			SPGridDataSerializer shSerializer = SubsetHandlerSerializer::create(*sh);
-			serializer.add(shSerializer);
-		}
-	}
+	AddDomainDataSerializers(domainOut, serializer);
 
 //	now call redistribution
 	DistributeGrid(*pGrid, partitionHandler, serializer, createVerticalInterfaces,
@@ -440,6 +451,34 @@ static bool DistributeDomain(TDomain& domainOut,
 	return true;
 }
 
+template <typename TDomain>
+static void SavePartitionedDomain(TDomain& domain, const char* filename)
+{
+	PROFILE_FUNC_GROUP("parallelization");
+#ifdef UG_PARALLEL
+	GridDataSerializationHandler serializer;
+	AddDomainDataSerializers(domain, serializer);
+	SavePartitionedGrid(*domain.grid(), serializer, filename);
+#else
+	UG_THROW("SavePartitionedDomain: Only available in parallel builds. "
+			 "Use SaveDomain instead.");
+#endif
+}
+
+template <typename TDomain>
+static void LoadPartitionedDomain(TDomain& domain, const char* filename)
+{
+	PROFILE_FUNC_GROUP("parallelization");
+#ifdef UG_PARALLEL
+	GridDataSerializationHandler serializer;
+	AddDomainDataSerializers(domain, serializer);
+	LoadPartitionedGrid(*domain.grid(), serializer, filename);
+#else
+	UG_THROW("LoadPartitionedDomain: Only available in parallel builds. "
+			 "Use LoadDomain instead.");
+#endif
+}
+
 }//	end of namespace
 
 #endif
@@ -230,24 +230,24 @@ ReferenceMappingProvider()
 //	set mappings
 
 //	edge
-	set_mapping<1,1>(ROID_EDGE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 1> > >::get());
-	set_mapping<1,2>(ROID_EDGE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 2> > >::get());
-	set_mapping<1,3>(ROID_EDGE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 3> > >::get());
+	set_mapping<1,1>(ROID_EDGE, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 1> > >::get());
+	set_mapping<1,2>(ROID_EDGE, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 2> > >::get());
+	set_mapping<1,3>(ROID_EDGE, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceEdge, 3> > >::get());
 
 //	triangle
-	set_mapping<2,2>(ROID_TRIANGLE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTriangle, 2> > >::get());
-	set_mapping<2,3>(ROID_TRIANGLE, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTriangle, 3> > >::get());
+	set_mapping<2,2>(ROID_TRIANGLE, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTriangle, 2> > >::get());
+	set_mapping<2,3>(ROID_TRIANGLE, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTriangle, 3> > >::get());
 
 //	quadrilateral
-	set_mapping<2,2>(ROID_QUADRILATERAL, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceQuadrilateral, 2> > >::get());
-	set_mapping<2,3>(ROID_QUADRILATERAL, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceQuadrilateral, 3> > >::get());
+	set_mapping<2,2>(ROID_QUADRILATERAL, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceQuadrilateral, 2> > >::get());
+	set_mapping<2,3>(ROID_QUADRILATERAL, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceQuadrilateral, 3> > >::get());
 
 //	3d elements
-	set_mapping<3,3>(ROID_TETRAHEDRON, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTetrahedron, 3> > >::get());
-	set_mapping<3,3>(ROID_PRISM, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferencePrism, 3> > >::get());
-	set_mapping<3,3>(ROID_PYRAMID, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferencePyramid, 3> > >::get());
-	set_mapping<3,3>(ROID_HEXAHEDRON, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceHexahedron, 3> > >::get());
-	set_mapping<3,3>(ROID_OCTAHEDRON, Provider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceOctahedron, 3> > >::get());
+	set_mapping<3,3>(ROID_TETRAHEDRON, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceTetrahedron, 3> > >::get());
+	set_mapping<3,3>(ROID_PRISM, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferencePrism, 3> > >::get());
+	set_mapping<3,3>(ROID_PYRAMID, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferencePyramid, 3> > >::get());
+	set_mapping<3,3>(ROID_HEXAHEDRON, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceHexahedron, 3> > >::get());
+	set_mapping<3,3>(ROID_OCTAHEDRON, ThreadProvider<DimReferenceMappingWrapper<ReferenceMapping<ReferenceOctahedron, 3> > >::get());
 }
 
 
@@ -36,6 +36,7 @@
 
 #include "common/common.h"
 #include "common/math/ugmath.h"
+#include "common/util/provider.h"
 #include "lib_grid/grid/grid_base_objects.h"
 
 namespace ug{
@@ -163,9 +164,13 @@ class DimReferenceMapping
 
 /// class to provide reference mappings
 /**
- *	This class provides references mappings. It is implemented as a Singleton.
+ *	This class provides references mappings. It is implemented as a Singleton
+ *	per thread: since a mapping is updated for the corners of the current
+ *	element, every thread uses its own set of mappings.
  */
 class ReferenceMappingProvider {
+	friend class ThreadProvider<ReferenceMappingProvider>;
+
 	private:
 	// 	disallow private constructor
 		ReferenceMappingProvider();
@@ -177,11 +182,10 @@ class ReferenceMappingProvider {
 	// 	private destructor
 		~ReferenceMappingProvider(){};
 
-	// 	Singleton provider
+	// 	Singleton provider (one instance per thread)
 		static ReferenceMappingProvider& inst()
 		{
-			static ReferenceMappingProvider myInst;
-			return myInst;
+			return ThreadProvider<ReferenceMappingProvider>::get();
 		};
 
 	//	This is very dirty implementation, since casting to void. But, it is
@@ -37,6 +37,7 @@
 #include "lib_grid/tools/selector_grid.h"
 #include "lib_disc/spatial_disc/local_to_global/local_to_global_mapper.h"
 #include "lib_disc/spatial_disc/elem_disc/elem_disc_interface.h"
+#include "lib_disc/common/revision_counter.h"
 
 namespace ug{
 
@@ -114,7 +115,8 @@ class AssemblingTuner
 		m_bSingleAssIndex(false), m_SingleAssIndex(0),
 		m_bForceRegGrid(false), m_bModifySolutionImplemented(false),
 		m_ConstraintTypesEnabled(CT_ALL), m_ElemTypesEnabled(EDT_ALL),
-		m_bMatrixIsConst(false)
+		m_bMatrixIsConst(false), m_bReuseMatrixPattern(false),
+		m_pMassOp(NULL), m_pStiffOp(NULL)
 		{
 			m_pMapper = &m_pMapperCommon;
 		}
@@ -249,6 +251,59 @@ class AssemblingTuner
 	 */
 		bool matrix_is_const() const {return m_bMatrixIsConst;}
 
+	/**
+	 * specify whether the sparsity pattern of an assembled matrix is reused
+	 *
+	 * If enabled, a matrix that has already been assembled for the current
+	 * revision of the DoFDistribution is not cleared completely, but only
+	 * its values are set to zero. Subsequent assemblings then add into the
+	 * existing connections instead of rebuilding the pattern. The pattern is
+	 * rebuilt automatically whenever the DoFDistribution changes (e.g. after
+	 * refinement, redistribution or reordering).
+	 *
+	 * @param bReuse set true if the matrix pattern should be reused
+	 */
+		void set_reuse_matrix_pattern(bool bReuse) {m_bReuseMatrixPattern = bReuse;}
+
+	/**
+	 * whether the sparsity pattern of an assembled matrix is reused
+	 *
+	 * @return true iff pattern is reused
+	 */
+		bool matrix_pattern_reused() const {return m_bReuseMatrixPattern;}
+
+	/**
+	 * sets assembled mass and stiffness matrix of a linear, time-invariant problem
+	 *
+	 * If set, the instationary assembling of the jacobian and of the linear
+	 * system does not loop the elements for the matrix, but forms it as
+	 * s_m0 * M + s_a0 * A from the given matrices. The mass and stiffness part
+	 * of the previous time steps is added to the right-hand side by products
+	 * with M and A, so that only the sources are assembled element-wise.
+	 * If the matrix is const in addition, the constraints only adjust the
+	 * right-hand side, since they have been applied to the matrix already.
+	 *
+	 * The matrices must not contain the constraints. Pass NULL to disable.
+	 *
+	 * @param pMass		mass matrix M
+	 * @param pStiff	stiffness matrix A
+	 */
+		void set_time_invariant_operators(const matrix_type* pMass, const matrix_type* pStiff)
+		{
+			UG_COND_THROW((pMass == NULL) != (pStiff == NULL),
+			              "AssemblingTuner: Mass and stiffness matrix must be set both.");
+			m_pMassOp = pMass; m_pStiffOp = pStiff;
+		}
+
+	///	returns if the matrices of a linear, time-invariant problem are set
+		bool time_invariant_operators_set() const {return m_pMassOp != NULL;}
+
+	///	returns the mass matrix of a linear, time-invariant problem (or NULL)
+		const matrix_type* mass_operator() const {return m_pMassOp;}
+
+	///	returns the stiffness matrix of a linear, time-invariant problem (or NULL)
+		const matrix_type* stiffness_operator() const {return m_pStiffOp;}
+
 	protected:
 	///	default LocalToGlobalMapper
 		LocalToGlobalMapper<TAlgebra> m_pMapperCommon;
@@ -281,6 +336,16 @@ class AssemblingTuner
 
 	/// disables matrix assembling if set to false
 		bool m_bMatrixIsConst;
+
+	///	reuses the sparsity pattern of the matrix if set to true
+		bool m_bReuseMatrixPattern;
+
+	///	revision of the DoFDistribution the matrix pattern has been built for
+		mutable RevisionCounter m_PatternRevision;
+
+	///	mass and stiffness matrix of a linear, time-invariant problem
+		const matrix_type* m_pMassOp;
+		const matrix_type* m_pStiffOp;
 };
 
 } // end namespace ug
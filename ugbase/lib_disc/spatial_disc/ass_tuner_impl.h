@@ -57,7 +57,18 @@ void AssemblingTuner<TAlgebra>::resize(ConstSmartPtr<DoFDistribution> dd,
 	}
 	else{
 		const size_t numIndex = dd->num_indices();
+
+	//	keep the pattern, if it has been built for the same index revision
+		if(m_bReuseMatrixPattern
+			&& m_PatternRevision == dd->revision()
+			&& mat.num_rows() == numIndex && mat.num_cols() == numIndex)
+		{
+			mat.clear_retain_structure();
+			return;
+		}
+
 		mat.resize_and_clear(numIndex, numIndex);
+		m_PatternRevision = dd->revision();
 	}
 }
 
@@ -34,18 +34,25 @@
 #define __H__UG__LIB_DISC__SPATIAL_DISC__DISC_UTIL__GEOM_PROVIDER__
 
 #include <map>
+#include "common/util/provider.h"
 #include "lib_disc/local_finite_element/local_finite_element_id.h"
 
 namespace ug{
 
 
-/// Geom Provider, holding a single instance of a geometry
+/// Geom Provider, holding a single instance of a geometry per thread
 /**
  * This class is used to wrap an object into a singleton-like provider, such
  * that construction computations is avoided, if the object is used several times.
  *
  * In addition, the object can be shared between unrelated code parts, if the
  * same object is intended to be used, but no passing is possible or wanted.
+ *
+ * Since a geometry is updated for the currently assembled element, every
+ * thread gets its own set of instances (see ThreadProvider). Thus, geometries
+ * can be updated concurrently for different elements by different threads.
+ * Note, that this does not make the assembling thread-safe: the DataEvaluator
+ * and the element discretizations are not per thread (see DataEvaluatorBase).
  */
 template <typename TGeom>
 class GeomProvider
@@ -61,18 +68,6 @@ class GeomProvider
 		static const bool staticLocalData = TGeom::staticLocalData;
 
 	protected:
-		/// private constructor
-		GeomProvider() {m_mLFEIDandOrder.clear();}
-
-		/// destructor
-		~GeomProvider() {clear_geoms();}
-
-		/// singleton provider
-		static GeomProvider<TGeom>& inst() {
-			static GeomProvider<TGeom> inst;
-			return inst;
-		}
-
 		/// struct to sort keys
 		struct LFEIDandQuadOrder{
 				LFEIDandQuadOrder(const LFEID lfeID, const int order)
@@ -89,17 +84,32 @@ class GeomProvider
 			const int m_order;
 		};
 
-		/// vector holding instances
-		typedef std::map<LFEIDandQuadOrder, TGeom*> MapType;
-		static MapType m_mLFEIDandOrder;
+		/// map holding instances, one per thread
+		class MapType : public std::map<LFEIDandQuadOrder, TGeom*>
+		{
+			public:
+				/// destructor
+				~MapType() {clear_geoms();}
+
+				/// clears all instances
+				void clear_geoms(){
+					typedef typename MapType::iterator MapIter;
+					for(MapIter iter = this->begin(); iter != this->end(); ++iter)
+						if(iter->second)
+							delete iter->second;
+
+					this->clear();
+				}
+		};
 
 		/// returns class based on identifier
 		static TGeom& get_class(const LFEID lfeID, const int quadOrder) {
 
 			LFEIDandQuadOrder key(lfeID, quadOrder);
+			MapType& map = ThreadProvider<MapType>::get();
 
 			typedef std::pair<typename MapType::iterator,bool> ret_type;
-			ret_type ret = m_mLFEIDandOrder.insert(std::pair<LFEIDandQuadOrder,TGeom*>(key,NULL));
+			ret_type ret = map.insert(std::pair<LFEIDandQuadOrder,TGeom*>(key,NULL));
 
 			// newly inserted, need construction of data
 			if(ret.second == true){
@@ -114,16 +124,6 @@ class GeomProvider
 			return *ret.first->second;
 		}
 
-		/// clears all instances
-		static void clear_geoms(){
-			typedef typename std::map<LFEIDandQuadOrder, TGeom*>::iterator MapIter;
-			for(MapIter iter = m_mLFEIDandOrder.begin(); iter != m_mLFEIDandOrder.end(); ++iter)
-				if(iter->second)
-					delete iter->second;
-
-			m_mLFEIDandOrder.clear();
-		}
-
 	public:
 		///	type of provided object
 		typedef TGeom Type;
@@ -134,28 +134,26 @@ class GeomProvider
 			if(staticLocalData) return get();
 
 			// return the object based on identifier
-			return inst().get_class(lfeID, quadOrder);
+			return get_class(lfeID, quadOrder);
 		}
 
 		///	returns a singleton based on the identifier
 		static inline TGeom& get(){
-			static TGeom inst;
 			if(!staticLocalData)
 				UG_THROW("GeomProvider: accessing geometry without keys, but"
 						 " geometry may change local data. Use access by keys instead.");
-			return inst;
+			return ThreadProvider<TGeom>::get();
 		}
 
-		///	clears all singletons
+		///	clears all singletons (of all threads)
 		static inline void clear(){
-			inst().clear_geoms();
+			std::vector<MapType*> vMap;
+			ThreadProvider<MapType>::instances(vMap);
+			for(size_t t = 0; t < vMap.size(); ++t)
+				vMap[t]->clear_geoms();
 		}
 };
 
-template <typename TGeom>
-std::map<typename GeomProvider<TGeom>::LFEIDandQuadOrder, TGeom*> GeomProvider<TGeom>::m_mLFEIDandOrder
-						= std::map<typename GeomProvider<TGeom>::LFEIDandQuadOrder, TGeom*>();
-
 
 } // end namespace ug
 
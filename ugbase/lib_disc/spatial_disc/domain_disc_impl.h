@@ -38,6 +38,7 @@
 #include "lib_disc/common/groups_util.h"
 #include "lib_disc/function_spaces/error_indicator_util.h"
 #include "lib_disc/spatial_disc/subset_assemble_util.h"
+#include "lib_algebra/algebra_common/sparsematrix_util.h"
 #ifdef UG_PARALLEL
 #include "lib_disc/parallelization/parallelization_util.h"
 #endif
@@ -1387,8 +1388,18 @@ assemble_jacobian(matrix_type& J,
 		} UG_CATCH_THROW("'DomainDiscretization': Cannot modify solution.");
 	}
 
+//	form J = M + s_a0 * A, if the matrices of a linear, time-invariant
+//	problem are given (the element loop is skipped then)
+	size_t numSubsets = unionSubsets.size();
+	if(m_spAssTuner->time_invariant_operators_set())
+	{
+		MatAdd(J, 1.0, *m_spAssTuner->mass_operator(),
+		       s_a0, *m_spAssTuner->stiffness_operator());
+		numSubsets = 0;
+	}
+
 //	loop subsets
-	for(size_t i = 0; i < unionSubsets.size(); ++i)
+	for(size_t i = 0; i < numSubsets; ++i)
 	{
 	//	get subset
 		const int si = unionSubsets[i];
@@ -1709,9 +1720,16 @@ assemble_linear(matrix_type& mat, vector_type& rhs,
 //	update the elem discs
 	update_disc_items();
 
+//	matrices of a linear, time-invariant problem
+	const matrix_type* pMass = m_spAssTuner->mass_operator();
+	const matrix_type* pStiff = m_spAssTuner->stiffness_operator();
+
 //	reset matrix to zero and resize
 	if (!m_spAssTuner->matrix_is_const())
-		m_spAssTuner->resize(dd, mat);
+	{
+		if(pMass) MatAdd(mat, vScaleMass[0], *pMass, vScaleStiff[0], *pStiff);
+		else m_spAssTuner->resize(dd, mat);
+	}
 	m_spAssTuner->resize(dd, rhs);
 
 //	Union of Subsets
@@ -1789,7 +1807,19 @@ assemble_linear(matrix_type& mat, vector_type& rhs,
 						" subset "<<si<< " failed.");
 	}
 
-//	post process
+//	mass and stiffness part of the old time steps
+	if(pMass)
+	{
+		for(size_t t = 1; t < vScaleMass.size(); ++t)
+		{
+			pMass->axpy(rhs, 1.0, rhs, -vScaleMass[t], *vSol->solution(t));
+			if(vScaleStiff[t] != 0.0)
+				pStiff->axpy(rhs, 1.0, rhs, -vScaleStiff[t], *vSol->solution(t));
+		}
+	}
+
+//	post process (a const matrix formed from the operators is already adjusted)
+	const bool bAdjustRhsOnly = pMass && m_spAssTuner->matrix_is_const();
 	try{
 	for(int type = 1; type < CT_ALL; type = type << 1){
 		if(!(m_spAssTuner->constraint_type_enabled(type))) continue;
@@ -1797,7 +1827,10 @@ assemble_linear(matrix_type& mat, vector_type& rhs,
 			if(m_vConstraint[i]->type() & type)
 			{
 				m_vConstraint[i]->set_ass_tuner(m_spAssTuner);
-				m_vConstraint[i]->adjust_linear(mat, rhs, dd, type, vSol->time(0));
+				if(bAdjustRhsOnly)
+					m_vConstraint[i]->adjust_rhs(rhs, *vSol->solution(0), dd, type, vSol->time(0));
+				else
+					m_vConstraint[i]->adjust_linear(mat, rhs, dd, type, vSol->time(0));
 			}
 	}
 	} UG_CATCH_THROW("Cannot adjust linear.");
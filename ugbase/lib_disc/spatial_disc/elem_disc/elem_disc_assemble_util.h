@@ -70,6 +70,11 @@ extern DebugID DID_ELEM_DISC_ASSEMBLE_UTIL;
  * discretizations to the elements in given subsets and adds the local data
  * to the global ones.
  *
+ * The element loops are serial. There is no threaded assembling within one
+ * process, since the element discretizations, their data imports and the
+ * UserData they evaluate keep per-element state, that is shared by all
+ * elements of a loop. Parallelism is obtained by distributing the grid.
+ *
  * \tparam TDomain		domain type
  * \tparam TAlgebra		algebra type
  */
@@ -1064,10 +1069,15 @@ public:
 		LocalVectorTimeSeries locTimeSeries;
 		locTimeSeries.read_times(vSol);
 
+	//	if the operators are given, the matrix and the mass and stiffness part
+	//	of the old time steps are not assembled element-wise
+		const bool bOperators = spAssTuner->time_invariant_operators_set();
+		const bool bAssMatrix = !spAssTuner->matrix_is_const() && !bOperators;
+
 	//	prepare for given elem discs
 		try
 		{
-		DataEvaluator<domain_type> Eval(MASS | STIFF | RHS,
+		DataEvaluator<domain_type> Eval(bOperators ? RHS : (MASS | STIFF | RHS),
 						   vElemDisc, dd->function_pattern(), bNonRegularGrid,
 						   &locTimeSeries, &vScaleMass, &vScaleStiff);
 
@@ -1112,11 +1122,11 @@ public:
 		//	prepare element
 			try
 			{
-				Eval.prepare_elem(locU, elem, id, vCornerCoords, ind, true);
+				Eval.prepare_elem(locU, elem, id, vCornerCoords, ind, bAssMatrix);
 			}
 			UG_CATCH_THROW("(instationary) AssembleLinear: Cannot prepare element.");
 
-		if (!spAssTuner->matrix_is_const())
+		if (bAssMatrix)
 		{
 		//	Assemble JM
 			try
@@ -1164,6 +1174,9 @@ public:
 				Eval.set_time_point(t);
 				number scaleStiff = vScaleStiff[t];
 
+			//	only the sources remain, if the operators are given
+				if (bOperators && scaleStiff == 0.0) continue;
+
 			//	prepare element
 				try
 				{
@@ -1174,16 +1187,19 @@ public:
 			//	Assemble dM
 				try
 				{
-					tmpLocRhs = 0.0;
-					Eval.add_def_M_elem(tmpLocRhs, locU, elem, vCornerCoords, PT_INSTATIONARY);
-					locRhs.scale_append(-vScaleMass[t], tmpLocRhs);
+					if (!bOperators)
+					{
+						tmpLocRhs = 0.0;
+						Eval.add_def_M_elem(tmpLocRhs, locU, elem, vCornerCoords, PT_INSTATIONARY);
+						locRhs.scale_append(-vScaleMass[t], tmpLocRhs);
+					}
 				}
 				UG_CATCH_THROW("(instationary) AssembleLinear: Cannot compute Jacobian (M).");
 
 			//	Assemble dA
 				try
 				{
-					if (scaleStiff != 0.0)
+					if (!bOperators && scaleStiff != 0.0)
 					{
 						tmpLocRhs = 0.0;
 						Eval.add_def_A_elem(tmpLocRhs, locU, elem, vCornerCoords, PT_INSTATIONARY);
@@ -1207,7 +1223,7 @@ public:
 
 		//	send local to global matrix & rhs
 			try{
-				if (!spAssTuner->matrix_is_const())
+				if (bAssMatrix)
 					spAssTuner->add_local_mat_to_global(A, locA, dd);
 				spAssTuner->add_local_vec_to_global(rhs, locRhs, dd);
 			}
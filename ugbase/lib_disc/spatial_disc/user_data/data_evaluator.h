@@ -49,6 +49,11 @@ enum ProcessType {PT_ALL=0, PT_STATIONARY, PT_INSTATIONARY, MAX_PROCESS};
  * evaluation of the data in the correct order. In addition the coupling
  * contributions due to Import/Exports are computed by this class and can be
  * added to the local jacobian/defect.
+ *
+ * The evaluator is not thread-safe. It writes the element state into the
+ * element discretizations, their DataImports and the UserData they evaluate,
+ * which exist only once per process. Thus, two evaluators for the same
+ * element discretizations must not be used concurrently.
  */
 template <typename TDomain, typename TElemDisc> // TElemDisc = IElemDisc<TDomain>
 class DataEvaluatorBase
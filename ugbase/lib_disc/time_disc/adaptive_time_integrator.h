@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR__
+#define __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR__
+
+// other ug libraries
+#include "common/common.h"
+#include "lib_algebra/operator/interface/operator_inverse.h"
+
+// module intern libraries
+#include "lib_disc/time_disc/theta_time_step.h"
+#include "lib_disc/operator/non_linear_operator/assembled_non_linear_operator.h"
+
+namespace ug{
+
+/// \ingroup lib_disc_time_assemble
+/// @{
+
+/// time integrator with adaptive step size control
+/**
+ * This class advances a VectorTimeSeries by a one-stage multistep time
+ * discretization (ThetaTimeStep or BDF) up to a given end time, choosing the
+ * time step size such that an estimate of the local error stays below a
+ * prescribed tolerance.
+ *
+ * For BDF of order k the local error is estimated by Milne's device, i.e.
+ * from the difference of the computed solution and a predictor, that
+ * extrapolates the k+1 latest solutions of the time series. The difference
+ * is scaled by the error constant of the (variable step) BDF formula and the
+ * predictor. The order is raised step by step as previous solutions become
+ * available. For the first step and for other schemes the error is estimated
+ * by step doubling, i.e. by comparing one step with two steps of half size,
+ * where the solution of the half steps is kept. The extrapolation is also
+ * used as start iterate for the solver. The step size is chosen by a PI
+ * controller
+ * \f[
+ * 	\Delta t_{new} = \Delta t \cdot \rho \cdot err_n^{-k_I} \cdot
+ * 						\left(\frac{err_{n-1}}{err_n}\right)^{k_P},
+ * \f]
+ * where err is the error measured in units of atol + rtol * |u|. A step with
+ * err > 1 or a failing solver is rejected and repeated with a smaller step.
+ *
+ * The solutions are stored in the passed time series, whose vectors are
+ * recycled once enough time points are kept. The solver is initialized once
+ * with an AssembledOperator of the time discretization, such that any reuse
+ * of assembled operators (e.g. by
+ * MultiStepTimeDiscretization::set_linear_time_invariant or by the Jacobian
+ * reuse of the NewtonSolver) carries over from step to step.
+ *
+ * \tparam	TAlgebra	algebra type
+ */
+template <typename TAlgebra>
+class AdaptiveTimeIntegrator
+{
+	public:
+	/// Type of algebra
+		typedef TAlgebra algebra_type;
+
+	/// Type of algebra vector
+		typedef typename algebra_type::vector_type vector_type;
+
+	///	Type of time discretization
+		typedef MultiStepTimeDiscretization<TAlgebra> time_disc_type;
+
+	///	Type of solver
+		typedef IOperatorInverse<vector_type> solver_type;
+
+	public:
+	///	constructor
+		AdaptiveTimeIntegrator(SmartPtr<time_disc_type> spTimeDisc,
+		                       SmartPtr<solver_type> spSolver);
+
+	///	sets the relative and absolute tolerance for the local error
+		void set_tolerance(number rtol, number atol) {m_rtol = rtol; m_atol = atol;}
+
+	///	sets the time step size used for the first step
+		void set_initial_time_step(number dt) {m_dt = dt;}
+
+	///	sets the bounds for the time step size
+		void set_time_step_bounds(number dtMin, number dtMax) {m_dtMin = dtMin; m_dtMax = dtMax;}
+
+	///	sets the bounds for the change of the step size within one step
+		void set_step_factor_bounds(number minFactor, number maxFactor)
+			{m_minFactor = minFactor; m_maxFactor = maxFactor;}
+
+	///	sets the safety factor of the step size controller
+		void set_safety(number safety) {m_safety = safety;}
+
+	///	sets the exponents of the PI controller (scaled by 1/(order+1))
+		void set_pi_params(number kI, number kP) {m_kI = kI; m_kP = kP;}
+
+	///	sets the order of schemes other than BDF, used for step doubling (0 = 1)
+		void set_order(size_t order) {m_order = order;}
+
+	///	sets the grid level used for assembling
+		void set_grid_level(const GridLevel& gl) {m_gl = gl;}
+
+	///	sets the output verbosity
+		void set_verbose(bool bVerbose) {m_bVerbose = bVerbose;}
+
+	///	advances the time series up to the end time
+	/**
+	 * The latest solution of the time series is used as start value. On
+	 * return the latest solution is the one at the end time.
+	 *
+	 * \returns false if the step size falls below the minimal step size
+	 */
+		bool apply(SmartPtr<VectorTimeSeries<vector_type> > spSolTimeSeries,
+		           number endTime);
+
+	///	returns the number of accepted steps of the last call to apply
+		size_t num_accepted_steps() const {return m_numAccepted;}
+
+	///	returns the number of rejected steps of the last call to apply
+		size_t num_rejected_steps() const {return m_numRejected;}
+
+	///	returns the step size proposed for the next step
+		number time_step() const {return m_dt;}
+
+	///	returns the scaled error estimate of the last accepted step
+		number last_error() const {return m_lastErr;}
+
+	protected:
+	///	computes the polynomial extrapolation of the time series at a time
+		void extrapolate(vector_type& pred,
+		                 ConstSmartPtr<VectorTimeSeries<vector_type> > spSol,
+		                 size_t numPoints, number time) const;
+
+	///	returns the factor relating the BDF-k local error to u - predictor
+		number milne_factor(ConstSmartPtr<VectorTimeSeries<vector_type> > spSol,
+		                    size_t k, number time) const;
+
+	///	prepares a step, predicts the start value and solves the step
+		bool solve_step(vector_type& u, vector_type& pred,
+		                SmartPtr<VectorTimeSeries<vector_type> > spSol,
+		                number dt, size_t numPoints);
+
+	///	returns a recycled vector or a new one
+		SmartPtr<vector_type> take_vector(std::vector<SmartPtr<vector_type> >& vFree,
+		                                  const vector_type& v) const;
+
+	protected:
+	///	time discretization
+		SmartPtr<time_disc_type> m_spTimeDisc;
+
+	///	solver for the time step problems
+		SmartPtr<solver_type> m_spSolver;
+
+	///	tolerances
+		number m_rtol, m_atol;
+
+	///	current step size and bounds
+		number m_dt, m_dtMin, m_dtMax;
+
+	///	controller parameters
+		number m_minFactor, m_maxFactor, m_safety, m_kI, m_kP;
+
+	///	order of the scheme
+		size_t m_order;
+
+	///	grid level
+		GridLevel m_gl;
+
+	///	verbosity
+		bool m_bVerbose;
+
+	///	statistics
+		size_t m_numAccepted, m_numRejected;
+		number m_lastErr;
+};
+
+/// @}
+
+} // end namespace ug
+
+// include implementation
+#include "adaptive_time_integrator_impl.h"
+
+#endif /* __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR__ */
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+
+#ifndef __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR_IMPL__
+#define __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR_IMPL__
+
+#include <algorithm>
+#include <cmath>
+
+#include "adaptive_time_integrator.h"
+
+namespace ug{
+
+template <typename TAlgebra>
+AdaptiveTimeIntegrator<TAlgebra>::
+AdaptiveTimeIntegrator(SmartPtr<time_disc_type> spTimeDisc,
+                       SmartPtr<solver_type> spSolver)
+	: m_spTimeDisc(spTimeDisc), m_spSolver(spSolver),
+	  m_rtol(1e-3), m_atol(1e-6),
+	  m_dt(1e-3), m_dtMin(1e-10), m_dtMax(1e10),
+	  m_minFactor(0.2), m_maxFactor(5.0), m_safety(0.9), m_kI(0.3), m_kP(0.4),
+	  m_order(0), m_gl(), m_bVerbose(true),
+	  m_numAccepted(0), m_numRejected(0), m_lastErr(0.0)
+{
+	UG_COND_THROW(spTimeDisc.invalid(), "AdaptiveTimeIntegrator: No time disc passed.");
+	UG_COND_THROW(spSolver.invalid(), "AdaptiveTimeIntegrator: No solver passed.");
+}
+
+template <typename TAlgebra>
+void AdaptiveTimeIntegrator<TAlgebra>::
+extrapolate(vector_type& pred,
+            ConstSmartPtr<VectorTimeSeries<vector_type> > spSol,
+            size_t numPoints, number time) const
+{
+//	Lagrange interpolation through the latest time points, evaluated at time
+	for(size_t i = 0; i < numPoints; ++i)
+	{
+		number l = 1.0;
+		for(size_t j = 0; j < numPoints; ++j)
+		{
+			if(j == i) continue;
+			l *= (time - spSol->time(j)) / (spSol->time(i) - spSol->time(j));
+		}
+
+		if(i == 0) VecScaleAssign(pred, l, *spSol->solution(0));
+		else VecScaleAdd(pred, 1.0, pred, l, *spSol->solution(i));
+	}
+}
+
+template <typename TAlgebra>
+number AdaptiveTimeIntegrator<TAlgebra>::
+milne_factor(ConstSmartPtr<VectorTimeSeries<vector_type> > spSol,
+             size_t k, number time) const
+{
+//	With the predictor through the time points t_0 > ... > t_k and the
+//	coefficient alpha = sum_{j<k} 1/(time - t_j) of the new solution in the
+//	BDF-k formula, the leading error terms of BDF-k and predictor give
+//		err = (u - pred) / (1 + alpha * (time - t_k)).
+//	For constant steps this is Milne's constant C/(C*-C), e.g. 1/3 for BDF1
+//	and 2/11 for BDF2.
+	number alpha = 0.0;
+	for(size_t j = 0; j < k; ++j)
+		alpha += 1.0 / (time - spSol->time(j));
+
+	return 1.0 / (1.0 + alpha * (time - spSol->time(k)));
+}
+
+template <typename TAlgebra>
+bool AdaptiveTimeIntegrator<TAlgebra>::
+solve_step(vector_type& u, vector_type& pred,
+           SmartPtr<VectorTimeSeries<vector_type> > spSol,
+           number dt, size_t numPoints)
+{
+//	prepare step and predict start value
+	m_spTimeDisc->prepare_step(spSol, dt);
+	extrapolate(pred, spSol, std::min(numPoints, spSol->size()),
+	            m_spTimeDisc->future_time());
+	u = pred;
+
+//	solve
+	if(!m_spSolver->prepare(u)) return false;
+	return m_spSolver->apply(u);
+}
+
+template <typename TAlgebra>
+SmartPtr<typename AdaptiveTimeIntegrator<TAlgebra>::vector_type>
+AdaptiveTimeIntegrator<TAlgebra>::
+take_vector(std::vector<SmartPtr<vector_type> >& vFree, const vector_type& v) const
+{
+	if(vFree.empty()) return v.clone_without_values();
+
+	SmartPtr<vector_type> sp = vFree.back();
+	vFree.pop_back();
+	return sp;
+}
+
+template <typename TAlgebra>
+bool AdaptiveTimeIntegrator<TAlgebra>::
+apply(SmartPtr<VectorTimeSeries<vector_type> > spSol, number endTime)
+{
+	PROFILE_FUNC_GROUP("discretization");
+	UG_COND_THROW(spSol.invalid() || spSol->size() == 0,
+	              "AdaptiveTimeIntegrator: Time series must contain a start value.");
+	UG_COND_THROW(m_spTimeDisc->num_stages() != 1,
+	              "AdaptiveTimeIntegrator: Only one-stage time discretizations supported.");
+
+//	BDF is started with order 1 and raised as previous solutions become available
+	BDF<TAlgebra>* pBDF = dynamic_cast<BDF<TAlgebra>*>(m_spTimeDisc.get());
+	const size_t bdfOrder = m_spTimeDisc->num_prev_steps();
+
+//	order of the scheme and number of time points kept
+	const size_t order = pBDF ? bdfOrder : ((m_order > 0) ? m_order : 1);
+	const size_t numKeep = order + 1;
+
+//	init solver
+	SmartPtr<AssembledOperator<TAlgebra> > spOp =
+		make_sp(new AssembledOperator<TAlgebra>(m_spTimeDisc, m_gl));
+	if(!m_spSolver->init(spOp))
+		UG_THROW("AdaptiveTimeIntegrator: Cannot init solver.");
+
+//	work vectors (solutions removed from the time series are recycled)
+	std::vector<SmartPtr<vector_type> > vFree;
+	SmartPtr<vector_type> spU = spSol->latest()->clone();
+	SmartPtr<vector_type> spMid = spU->clone_without_values();
+	SmartPtr<vector_type> spFull = spU->clone_without_values();
+	SmartPtr<vector_type> spPred = spU->clone_without_values();
+	SmartPtr<vector_type> spTmp = spU->clone_without_values();
+
+	m_numAccepted = m_numRejected = 0;
+	number time = spSol->time(0);
+	number errOld = 1.0;
+	m_dt = std::min(std::max(m_dt, m_dtMin), m_dtMax);
+
+	while(endTime - time > 1e-12 * m_dtMax)
+	{
+	//	do not step beyond the end time, avoid tiny last steps
+		number dt = m_dt;
+		if(time + dt > endTime || (endTime - (time + dt)) < 1e-8 * dt)
+			dt = endTime - time;
+
+	//	Milne's device needs k+1 previous solutions for BDF-k; the order is
+	//	raised as they become available. Otherwise, i.e. for the first step
+	//	and for other schemes, the error is estimated by step doubling.
+		size_t p = order;
+		if(pBDF)
+		{
+			p = std::min(bdfOrder, std::max(spSol->size(), (size_t)2) - 1);
+			pBDF->set_order(p);
+		}
+		const bool bMilne = (pBDF != NULL) && spSol->size() >= p + 1;
+
+	//	solve, for step doubling also with two steps of half size
+		bool bSuccess, bMidPushed = false;
+		if(bMilne)
+			bSuccess = solve_step(*spU, *spPred, spSol, dt, p + 1);
+		else
+		{
+			bSuccess = solve_step(*spFull, *spPred, spSol, dt, p + 1);
+			if(bSuccess)
+				bSuccess = solve_step(*spMid, *spPred, spSol, 0.5 * dt, p + 1);
+			if(bSuccess)
+			{
+				spSol->push(spMid, m_spTimeDisc->future_time());
+				bMidPushed = true;
+				bSuccess = solve_step(*spU, *spPred, spSol, 0.5 * dt, p + 1);
+			}
+		}
+		const number futureTime = m_spTimeDisc->future_time();
+
+		if(!bSuccess)
+		{
+			if(bMidPushed) spSol->remove_latest();
+			++m_numRejected;
+			m_dt = dt * m_minFactor;
+			if(m_bVerbose)
+				UG_LOG("AdaptiveTimeIntegrator: Solver failed at t = " << time
+				       << ", retrying with dt = " << m_dt << ".\n");
+			if(m_dt < m_dtMin) break;
+			continue;
+		}
+
+	//	estimate local error (norms are computed on copies, since they
+	//	may change the parallel storage type)
+		number errAbs;
+		if(bMilne)
+		{
+			VecScaleAdd(*spTmp, 1.0, *spU, -1.0, *spPred);
+			errAbs = spTmp->norm() * milne_factor(spSol, p, futureTime);
+		}
+		else
+		{
+			VecScaleAdd(*spTmp, 1.0, *spU, -1.0, *spFull);
+			errAbs = spTmp->norm() / (std::pow(2.0, (number)p) - 1.0);
+		}
+		*spTmp = *spU;
+		const number err = std::max(errAbs / (m_atol + m_rtol * spTmp->norm()), 1e-10);
+
+		const number expo = 1.0 / (p + 1);
+		if(err > 1.0)
+		{
+			if(bMidPushed) spSol->remove_latest();
+			++m_numRejected;
+			m_dt = dt * std::max(m_minFactor, m_safety * std::pow(err, -expo));
+			if(m_bVerbose)
+				UG_LOG("AdaptiveTimeIntegrator: Step rejected at t = " << time
+				       << " (err = " << err << "), retrying with dt = " << m_dt << ".\n");
+			if(m_dt < m_dtMin) break;
+			continue;
+		}
+
+	//	accept: store solution, recycle the vectors no longer needed
+		spSol->push(spU, futureTime);
+		while(spSol->size() > numKeep)
+		{
+			vFree.push_back(spSol->oldest());
+			spSol->remove_oldest();
+		}
+		spU = take_vector(vFree, *spTmp);
+		if(bMidPushed) spMid = take_vector(vFree, *spTmp);
+
+		m_spTimeDisc->finish_step(spSol);
+
+		++m_numAccepted;
+		time = futureTime;
+		m_lastErr = err;
+
+	//	PI controller
+		number factor = m_safety * std::pow(err, -m_kI * expo)
+		                         * std::pow(errOld / err, m_kP * expo);
+		factor = std::min(std::max(factor, m_minFactor), m_maxFactor);
+		errOld = err;
+		m_dt = std::min(std::max(dt * factor, m_dtMin), m_dtMax);
+
+		if(m_bVerbose)
+			UG_LOG("AdaptiveTimeIntegrator: Step " << m_numAccepted << " accepted, t = "
+			       << time << ", dt = " << dt << ", err = " << err
+			       << ", next dt = " << m_dt << "\n");
+	}
+
+//	restore the requested order
+	if(pBDF) pBDF->set_order(bdfOrder);
+
+	if(m_dt < m_dtMin)
+	{
+		UG_LOG("AdaptiveTimeIntegrator: Time step size " << m_dt << " below "
+		       "minimal step size " << m_dtMin << " at t = " << time << ".\n");
+		m_dt = m_dtMin;
+		return false;
+	}
+
+	if(m_bVerbose)
+		UG_LOG("AdaptiveTimeIntegrator: Reached t = " << time << " with "
+		       << m_numAccepted << " accepted and " << m_numRejected
+		       << " rejected steps.\n");
+
+	return true;
+}
+
+} // end namespace ug
+
+#endif /* __H__UG__LIB_DISC__TIME_DISC__ADAPTIVE_TIME_INTEGRATOR_IMPL__ */
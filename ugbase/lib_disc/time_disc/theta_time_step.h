@@ -71,11 +71,62 @@ class MultiStepTimeDiscretization
 	/// constructor
 		MultiStepTimeDiscretization(SmartPtr<IDomainDiscretization<algebra_type> > spDD)
 			: ITimeDiscretization<TAlgebra>(spDD),
-			  m_pPrevSol(NULL)
+			  m_pPrevSol(NULL),
+			  m_bLinearTimeInvariant(false),
+			  m_spMass(new matrix_type), m_spStiff(new matrix_type),
+			  m_bOpCacheValid(false), m_numOpAssemblies(0),
+			  m_bSysMatValid(false), m_bSysMatChanged(true),
+			  m_sysScaleMass(0.0), m_sysScaleStiff(0.0)
 		{}
 
 		virtual ~MultiStepTimeDiscretization(){};
 
+	///	declares the problem as linear with time-invariant operators
+	/**
+	 * If enabled, the mass matrix M and the stiffness matrix A of the domain
+	 * discretization are assembled only once (without constraints) and kept.
+	 * The system matrix of a step is then formed as s_m0 * M + s_a0 * A by a
+	 * sparse matrix addition. The mass and stiffness part of the previous
+	 * time steps is added to the right-hand side by products with M and A,
+	 * only the sources and boundary values are assembled element-wise.
+	 *
+	 * assemble_linear forms the system matrix only if the scaling factors
+	 * have changed (i.e. the time step size or the scheme), the cached
+	 * matrices have been reassembled or invalidate_system_matrix() has been
+	 * called. Otherwise the passed matrix is left untouched and
+	 * system_matrix_changed() returns false, so that the caller can keep
+	 * the setup of its solver. Thus, the same matrix must be passed in each
+	 * step and must not be changed in between.
+	 *
+	 * This is only valid if all element discretizations are linear, do not
+	 * contain stationary parts and their operators do not depend on time.
+	 * This is not checked. Since the constraints are applied to the system
+	 * matrix only when it is formed, the constrained DoFs must not change
+	 * between the steps (only the boundary values may).
+	 */
+		void set_linear_time_invariant(bool bLTI)
+		{
+			m_bLinearTimeInvariant = bLTI;
+			invalidate_operator_cache();
+		}
+
+	///	returns if the problem is treated as linear and time-invariant
+		bool linear_time_invariant() const {return m_bLinearTimeInvariant;}
+
+	///	forces a reassembling of the cached mass and stiffness matrix
+		void invalidate_operator_cache() {m_bOpCacheValid = false; m_bSysMatValid = false;}
+
+	///	returns the number of assemblings of the cached operators
+		size_t num_operator_assemblies() const {return m_numOpAssemblies;}
+
+	///	forces the system matrix to be formed in the next call of assemble_linear
+	/**	This is needed if another matrix is passed or the matrix has been changed.*/
+		void invalidate_system_matrix() {m_bSysMatValid = false;}
+
+	///	returns if the last call of assemble_linear has formed the system matrix
+	/**	If false, the matrix is unchanged and a solver set up for it can be reused.*/
+		bool system_matrix_changed() const {return m_bSysMatChanged;}
+
 	/// \copydoc ITimeDiscretization::num_prev_steps()
 		virtual size_t num_prev_steps() const {return m_prevSteps;}
 
@@ -134,6 +185,34 @@ class MultiStepTimeDiscretization
 		                              number dt, number currentTime,
 		                              ConstSmartPtr<VectorTimeSeries<vector_type> > prevSol) = 0;
 
+	///	(re-)assembles the cached mass and stiffness matrix if the grid has changed
+		void update_operator_cache(const vector_type& u, const GridLevel& gl);
+
+	///	restores the settings of the assembling tuner changed for the cached operators
+		class TunerGuard
+		{
+			public:
+				TunerGuard(AssemblingTuner<TAlgebra>& tuner)
+					: m_tuner(tuner), m_bMatrixIsConst(tuner.matrix_is_const()),
+					  m_constraints(tuner.enabled_constraints()),
+					  m_pMass(tuner.mass_operator()), m_pStiff(tuner.stiffness_operator())
+				{}
+
+				~TunerGuard()
+				{
+					m_tuner.set_matrix_is_const(m_bMatrixIsConst);
+					m_tuner.enable_constraints(m_constraints);
+					m_tuner.set_time_invariant_operators(m_pMass, m_pStiff);
+				}
+
+			private:
+				AssemblingTuner<TAlgebra>& m_tuner;
+				bool m_bMatrixIsConst;
+				int m_constraints;
+				const matrix_type* m_pMass;
+				const matrix_type* m_pStiff;
+		};
+
 		size_t m_prevSteps;					///< number of previous steps needed.
 		std::vector<number> m_vScaleMass;	///< Scaling for mass part
 		std::vector<number> m_vScaleStiff;	///< Scaling for stiffness part
@@ -141,6 +220,17 @@ class MultiStepTimeDiscretization
 		SmartPtr<VectorTimeSeries<vector_type> > m_pPrevSol;	///< Previous solutions
 		number m_dt; 								///< Time Step size
 		number m_futureTime;						///< Future Time
+
+		bool m_bLinearTimeInvariant;			///< linear, time-invariant problem
+		SmartPtr<matrix_type> m_spMass;			///< cached mass matrix
+		SmartPtr<matrix_type> m_spStiff;		///< cached stiffness matrix
+		GridLevel m_opCacheGL;					///< grid level of cached matrices
+		bool m_bOpCacheValid;					///< cached matrices valid
+		size_t m_numOpAssemblies;				///< assemblings of cached matrices
+		bool m_bSysMatValid;					///< system matrix formed and unchanged
+		bool m_bSysMatChanged;					///< last assemble_linear formed the matrix
+		number m_sysScaleMass;					///< s_m0 of the formed system matrix
+		number m_sysScaleStiff;					///< s_a0 of the formed system matrix
 };
 
 /// theta time stepping scheme
@@ -129,9 +129,22 @@ assemble_jacobian(matrix_type& J, const vector_type& u, const GridLevel& gl)
 	SmartPtr<vector_type> pU(const_cast<vector_type*>(&u), &DummyRefCount);
 	m_pPrevSol->push(pU, m_futureTime);
 
-//	assemble jacobian using current iterate
+//	assemble jacobian using current iterate (for linear, time-invariant
+//	problems it is formed from the cached operators)
 	try{
-		this->m_spDomDisc->assemble_jacobian(J, m_pPrevSol, m_vScaleStiff[0], gl);
+		if(m_bLinearTimeInvariant)
+		{
+			update_operator_cache(u, gl);
+
+			AssemblingTuner<TAlgebra>& assTuner = *this->m_spDomDisc->ass_tuner();
+			TunerGuard tunerGuard(assTuner);
+			assTuner.set_time_invariant_operators(m_spMass.get(), m_spStiff.get());
+			m_bSysMatValid = false;
+
+			this->m_spDomDisc->assemble_jacobian(J, m_pPrevSol, m_vScaleStiff[0], gl);
+		}
+		else
+			this->m_spDomDisc->assemble_jacobian(J, m_pPrevSol, m_vScaleStiff[0], gl);
 	}UG_CATCH_THROW("MultiStepTimeDiscretization: Cannot assemble jacobian.");
 
 //	pop unknown solution to solution time series
@@ -191,6 +204,28 @@ assemble_linear(matrix_type& A, vector_type& b, const GridLevel& gl)
 				m_prevSteps <<", but only "<< m_pPrevSol->size() << " passed.");
 
 
+//	for linear, time-invariant problems the matrix is formed from the cached
+//	operators, and only if the scaling has changed. The old time steps enter
+//	the right-hand side by products with the cached operators.
+	AssemblingTuner<TAlgebra>& assTuner = *this->m_spDomDisc->ass_tuner();
+	TunerGuard tunerGuard(assTuner);
+
+	m_bSysMatChanged = true;
+	if(m_bLinearTimeInvariant)
+	{
+		try{
+			update_operator_cache(*m_pPrevSol->latest(), gl);
+		}UG_CATCH_THROW("MultiStepTimeDiscretization: Cannot assemble cached operators.");
+
+		m_bSysMatChanged = !m_bSysMatValid
+							|| m_sysScaleMass != m_vScaleMass[0]
+							|| m_sysScaleStiff != m_vScaleStiff[0];
+
+		assTuner.set_time_invariant_operators(m_spMass.get(), m_spStiff.get());
+		assTuner.set_matrix_is_const(!m_bSysMatChanged);
+	}
+	m_bSysMatValid = false;
+
 //	push unknown solution to solution time series (not used, but formally needed)
 	m_pPrevSol->push(m_pPrevSol->latest(), m_futureTime);
 
@@ -201,6 +236,14 @@ assemble_linear(matrix_type& A, vector_type& b, const GridLevel& gl)
 
 //	pop unknown solution from solution time series
 	m_pPrevSol->remove_latest();
+
+//	remember the scaling the system matrix has been formed for
+	if(m_bLinearTimeInvariant)
+	{
+		m_bSysMatValid = true;
+		m_sysScaleMass = m_vScaleMass[0];
+		m_sysScaleStiff = m_vScaleStiff[0];
+	}
 }
 
 template <typename TAlgebra>
@@ -290,6 +333,31 @@ calc_error(const vector_type& u, vector_type* u_vtk)
 }
 
 
+template <typename TAlgebra>
+void MultiStepTimeDiscretization<TAlgebra>::
+update_operator_cache(const vector_type& u, const GridLevel& gl)
+{
+	if(m_bOpCacheValid && m_opCacheGL == gl && m_spMass->num_rows() == u.size())
+		return;
+
+	PROFILE_BEGIN_GROUP(MultiStepTimeDiscretization_update_operator_cache, "discretization MultiStepTimeDiscretization");
+
+//	the constraints are applied to the formed system, not to the operators
+	AssemblingTuner<TAlgebra>& assTuner = *this->m_spDomDisc->ass_tuner();
+	TunerGuard tunerGuard(assTuner);
+	assTuner.enable_constraints(CT_NONE);
+	assTuner.set_time_invariant_operators(NULL, NULL);
+
+	m_bOpCacheValid = false;
+	m_bSysMatValid = false;
+	this->m_spDomDisc->assemble_mass_matrix(*m_spMass, u, gl);
+	this->m_spDomDisc->assemble_stiffness_matrix(*m_spStiff, u, gl);
+
+	m_opCacheGL = gl;
+	m_bOpCacheValid = true;
+	++m_numOpAssemblies;
+}
+
 template <typename TAlgebra>
 void MultiStepTimeDiscretization<TAlgebra>::
 finish_step(SmartPtr<VectorTimeSeries<vector_type> > currSol)
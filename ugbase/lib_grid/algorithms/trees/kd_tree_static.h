@@ -50,7 +50,7 @@ class KDVertexDistance
 {
 	public:
 		KDVertexDistance()	{}
-		KDVertexDistance(Vertex* vrt, float nDistSQ) : vertex(vrt), distSQ(nDistSQ)	{}
+		KDVertexDistance(Vertex* vrt, number nDistSQ) : vertex(vrt), distSQ(nDistSQ)	{}
 
 		Vertex*		vertex;
 		number			distSQ;
@@ -95,7 +95,7 @@ class KDTreeStatic
 				void clear();
 
 				Node*		m_pChild[2];	//	0: pos, 1: neg
-				float		m_fSplitValue;
+				number		m_fSplitValue;
 				int			m_iSplitDimension;
 				VertexVec*	m_pvVertices;
 		};
@@ -154,7 +154,7 @@ class KDTreeStatic
 
 	//	some helper vars for neighbourhood search
 		int		m_numNeighboursFound;
-		float	m_maxDistSQ;
+		number	m_maxDistSQ;
 };
 
 /// @}
@@ -95,7 +95,12 @@ create_from_grid(Grid& grid, TVrtIterator vrtsBegin, TVrtIterator vrtsEnd,
 	m_aaPos = aaPos;
 	m_iSplitThreshold = splitThreshold;
 	m_splitDimension = splitDimension;	//	how the split dimensions are chosen
-	return create_barycentric(vrtsBegin, vrtsEnd, grid.num_vertices(), &m_parentNode, 0, maxTreeDepth);
+
+	int numVertices = 0;
+	for(TVrtIterator iter = vrtsBegin; iter != vrtsEnd; ++iter)
+		++numVertices;
+
+	return create_barycentric(vrtsBegin, vrtsEnd, numVertices, &m_parentNode, 0, maxTreeDepth);
 }
 
 template<class TPositionAttachment, int numDimensions, class TVector>
@@ -190,10 +195,10 @@ neighbourhood(KDVertexDistanceList& vrtsOut, Node* pNode, TVector& pos, int numC
 		for(VertexVec::iterator iter = pNode->m_pvVertices->begin(); iter != pNode->m_pvVertices->end(); iter++)
 		{
 		//	calculate the distance of the current point and the test point
-			float distSQ = 0;
+			number distSQ = 0;
 			for(int i = 0; i < numDimensions; ++i)
 			{
-				float t = pos[i] - m_aaPos[*iter].coord(i);
+				number t = pos[i] - m_aaPos[*iter].coord(i);
 				distSQ += (t*t);
 			}
 
@@ -263,7 +268,7 @@ neighbourhood(KDVertexDistanceList& vrtsOut, Node* pNode, TVector& pos, int numC
 				neighbourhood(vrtsOut, pNode->m_pChild[1 - bestNodeIndex], pos, numClosest);
 			else
 			{
-				float t = pos[pNode->m_iSplitDimension] - pNode->m_fSplitValue;
+				number t = pos[pNode->m_iSplitDimension] - pNode->m_fSplitValue;
 				if(t*t < m_maxDistSQ)
 					neighbourhood(vrtsOut, pNode->m_pChild[1 - bestNodeIndex], pos, numClosest);
 			}
@@ -293,11 +298,11 @@ create_barycentric(TVertexIterator vrts_begin, TVertexIterator vrts_end, int num
 	}
 
 //	loop through the points and calculate the barycentre
-	float barycentre = 0;
+	number barycentre = 0;
 	{
 		for(TVertexIterator iter = vrts_begin; iter != vrts_end; iter++)
 			barycentre += m_aaPos[*iter].coord(actDimension);
-		barycentre /= (float)numVertices;
+		barycentre /= (number)numVertices;
 	}
 
 //	fill the lists for the poitive and negative subnodes
@@ -306,12 +311,16 @@ create_barycentric(TVertexIterator vrts_begin, TVertexIterator vrts_end, int num
 	int numPos = 0;
 	int numNeg = 0;
 	{
-		for(TVertexIterator iter = vrts_begin; iter != vrts_end; iter++, numPos++, numNeg++)
+		for(TVertexIterator iter = vrts_begin; iter != vrts_end; iter++)
 		{
-			if(m_aaPos[*iter].coord(actDimension) >= barycentre)
+			if(m_aaPos[*iter].coord(actDimension) >= barycentre){
 				lstPos.push_back(*iter);
-			else
+				numPos++;
+			}
+			else{
 				lstNeg.push_back(*iter);
+				numNeg++;
+			}
 		}
 	}
 //	create the subnodes
@@ -167,8 +167,9 @@ template <class T> class UG_API AttachmentDataContainer : public IAttachmentData
 		virtual void defragment(size_t* pNewIndices, size_t numValidElements)
 			{
 				size_t numOldElems = size();
-				DataContainer vDataOld = m_vData;
-				m_vData.resize(numValidElements);
+				DataContainer vDataOld;
+				vDataOld.swap(m_vData);
+				m_vData.resize(numValidElements, m_defaultValue);
 				for(size_t i = 0; i < numOldElems; ++i)
 				{
 					size_t nInd = pNewIndices[i];
@@ -387,9 +388,19 @@ class UG_API AttachmentPipe
 	 */
 		void unregister_element(const TElem& elem);
 
-	/**	Aligns data with elements and removes unused data-memory.*/
+	/**	Aligns data with elements and removes unused data-memory.
+	 * Does nothing if the pipe is not fragmented.*/
 		void defragment();
 
+	///	Renumbers the data indices of all elements in their iteration order.
+	/**	In contrast to defragment, the data is also reordered if the pipe is
+	 * not fragmented, but elements have been registered in an order differing
+	 * from the order in which they are iterated. Afterwards the i-th data
+	 * entry corresponds to the i-th element and iterating the elements accesses
+	 * the attached data arrays sequentially.
+	 * Does nothing if the data is already stored in iteration order.*/
+		void compact();
+
 	/**\brief attaches a new data-array to the pipe.
 	 *
 	 * Attachs a new attachment and creates a container which holds the
@@ -292,6 +292,14 @@ defragment()
 	if(!is_fragmented())
 		return;
 
+	compact();
+}
+
+template <class TElem, class TElemHandler>
+void
+AttachmentPipe<TElem, TElemHandler>::
+compact()
+{
 //	if num_elements == 0, then simply resize all data-containers to 0.
 	if(num_elements() == 0)
 	{
@@ -303,35 +311,45 @@ defragment()
 		}
 		m_stackFreeEntries = UINTStack();
 		m_numDataEntries = 0;
+		m_containerSize = 0;
+		return;
 	}
-	else
-	{
-	//	calculate the fragmentation array. It has to be of the same size as the fragmented data containers.
-		std::vector<uint> vNewIndices(num_data_entries(), INVALID_ATTACHMENT_INDEX);
 
-	//	iterate through the elements and calculate the new index of each
-		size_t counter = 0;
-		typename atraits::element_iterator iter = atraits::elements_begin(m_pHandler);
-		typename atraits::element_iterator end = atraits::elements_end(m_pHandler);
+//	calculate the fragmentation array. It has to be of the same size as the fragmented data containers.
+	std::vector<size_t> vNewIndices(get_container_size(), INVALID_ATTACHMENT_INDEX);
 
-		for(; iter != end; ++iter){
-			vNewIndices[atraits::get_data_index(m_pHandler, (*iter))] = counter;
-			atraits::set_data_index(m_pHandler, (*iter), counter);
-			++counter;
-		}
+//	iterate through the elements and calculate the new index of each
+	size_t counter = 0;
+	bool bInOrder = !is_fragmented();
+	typename atraits::element_iterator iter = atraits::elements_begin(m_pHandler);
+	typename atraits::element_iterator end = atraits::elements_end(m_pHandler);
 
-	//	after defragmentation there are no free indices.
-		m_stackFreeEntries = UINTStack();
-		m_numDataEntries = counter;
+	for(; iter != end; ++iter){
+		const size_t oldInd = atraits::get_data_index(m_pHandler, (*iter));
+		if(oldInd != counter) bInOrder = false;
+		vNewIndices[oldInd] = counter;
+		++counter;
+	}
 
-	//	now iterate through the attached data-containers and defragment each one.
-		{
-			for(AttachmentEntryIterator iter = m_attachmentEntryContainer.begin();
-						iter != m_attachmentEntryContainer.end(); iter++)
-			{
-				(*iter).m_pContainer->defragment(&vNewIndices.front(), num_elements());
-			}
-		}
+//	nothing to do if the data is already stored in iteration order
+	if(bInOrder)
+		return;
+
+	for(iter = atraits::elements_begin(m_pHandler); iter != end; ++iter){
+		atraits::set_data_index(m_pHandler, (*iter),
+						vNewIndices[atraits::get_data_index(m_pHandler, (*iter))]);
+	}
+
+//	after defragmentation there are no free indices.
+	m_stackFreeEntries = UINTStack();
+	m_numDataEntries = counter;
+	m_containerSize = counter;
+
+//	now iterate through the attached data-containers and defragment each one.
+	for(AttachmentEntryIterator iter = m_attachmentEntryContainer.begin();
+				iter != m_attachmentEntryContainer.end(); iter++)
+	{
+		(*iter).m_pContainer->defragment(&vNewIndices.front(), num_elements());
 	}
 }
 
@@ -1053,7 +1053,7 @@ read_subset_handler_elements(ISubsetHandler& shOut,
 	while(elemNode)
 	{
 	//	read the indices
-		stringstream ss(elemNode->value(), ios_base::in);
+		NumberTokenReader ss(elemNode->value(), elemNode->value_size());
 
 		size_t index;
 		while(!ss.eof()){
@@ -1159,7 +1159,7 @@ read_selector_elements(ISelector& selOut, const char* elemNodeName,
 	while(elemNode)
 	{
 	//	read the indices
-		stringstream ss(elemNode->value(), ios_base::in);
+		NumberTokenReader ss(elemNode->value(), elemNode->value_size());
 
 		size_t index;
 		int state;
@@ -1371,9 +1371,8 @@ create_edges(std::vector<Edge*>& edgesOut,
 			Grid& grid, rapidxml::xml_node<>* node,
 			std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the edges
 	int i1, i2;
@@ -1407,9 +1406,8 @@ create_constraining_edges(std::vector<Edge*>& edgesOut,
 						  Grid& grid, rapidxml::xml_node<>* node,
 			 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the edges
 	int i1, i2;
@@ -1443,9 +1441,8 @@ create_constrained_edges(std::vector<Edge*>& edgesOut,
 						  Grid& grid, rapidxml::xml_node<>* node,
 			 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the edges
 	int i1, i2;
@@ -1489,9 +1486,8 @@ create_triangles(std::vector<Face*>& facesOut,
 				  Grid& grid, rapidxml::xml_node<>* node,
 				  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1526,9 +1522,8 @@ create_constraining_triangles(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1564,9 +1559,8 @@ create_constrained_triangles(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the triangles
 	int i1, i2, i3;
@@ -1611,9 +1605,8 @@ create_quadrilaterals(std::vector<Face*>& facesOut,
 					   Grid& grid, rapidxml::xml_node<>* node,
 					   std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1650,9 +1643,8 @@ create_constraining_quadrilaterals(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1691,9 +1683,8 @@ create_constrained_quadrilaterals(std::vector<Face*>& facesOut,
 					  Grid& grid, rapidxml::xml_node<>* node,
 					  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the quadrilaterals
 	int i1, i2, i3, i4;
@@ -1742,9 +1733,8 @@ create_tetrahedrons(std::vector<Volume*>& volsOut,
 					 Grid& grid, rapidxml::xml_node<>* node,
 					 std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the tetrahedrons
 	int i1, i2, i3, i4;
@@ -1781,9 +1771,8 @@ create_hexahedrons(std::vector<Volume*>& volsOut,
 					Grid& grid, rapidxml::xml_node<>* node,
 					std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5, i6, i7, i8;
@@ -1824,9 +1813,8 @@ create_prisms(std::vector<Volume*>& volsOut,
 			  Grid& grid, rapidxml::xml_node<>* node,
 			  std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5, i6;
@@ -1865,9 +1853,8 @@ create_pyramids(std::vector<Volume*>& volsOut,
 				Grid& grid, rapidxml::xml_node<>* node,
 				std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the hexahedrons
 	int i1, i2, i3, i4, i5;
@@ -1905,9 +1892,8 @@ create_octahedrons(std::vector<Volume*>& volsOut,
 					Grid& grid, rapidxml::xml_node<>* node,
 					std::vector<Vertex*>& vrts)
 {
-//	create a buffer with which we can access the data
-	string str(node->value(), node->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(node->value(), node->value_size());
 
 //	read the octahedrons
 	int i1, i2, i3, i4, i5, i6;
@@ -2196,9 +2182,8 @@ UGXFileInfo::calculate_vertex_node_bbox(rapidxml::xml_node<>* vrtNode, AABox<vec
 	if (numSrcCoords > 3)
 		return false;
 
-//	create a buffer with which we can access the data
-	std::string str(vrtNode->value(), vrtNode->value_size());
-	std::stringstream ss(str, std::ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(vrtNode->value(), vrtNode->value_size());
 
 	AABox<vector3> box(vector3(0, 0, 0), vector3(0, 0, 0));
 	vector3 min(0, 0, 0);
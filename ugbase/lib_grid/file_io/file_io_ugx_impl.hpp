@@ -37,6 +37,7 @@
 #include <cstring>
 #include "lib_grid/algorithms/debug_util.h"
 #include "lib_grid/global_attachments.h"
+#include "common/util/number_token_reader.h"
 
 namespace ug
 {
@@ -700,9 +701,8 @@ create_vertices(std::vector<Vertex*>& vrtsOut, Grid& grid,
 	if(numSrcCoords < 1 || numDestCoords < 1)
 		return false;
 
-//	create a buffer with which we can access the data
-	string str(vrtNode->value(), vrtNode->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(vrtNode->value(), vrtNode->value_size());
 
 //	if numDestCoords == numSrcCoords parsing will be faster
 	if(numSrcCoords == numDestCoords){
@@ -785,9 +785,8 @@ create_constrained_vertices(std::vector<Vertex*>& vrtsOut,
 	if(numSrcCoords < 1 || numDestCoords < 1)
 		return false;
 
-//	create a buffer with which we can access the data
-	string str(vrtNode->value(), vrtNode->value_size());
-	stringstream ss(str, ios_base::in);
+//	read the numbers directly from the buffer of the node
+	NumberTokenReader ss(vrtNode->value(), vrtNode->value_size());
 
 //	we have to be careful with reading.
 //	if numDestCoords < numSrcCoords we'll ignore some coords,
@@ -37,6 +37,7 @@
 #include "common/common.h"
 #include "lib_grid/attachments/attached_list.h"
 #include "lib_grid/tools/periodic_boundary_manager.h"
+#include "lib_grid/lib_grid_messages.h"
 
 #ifdef UG_PARALLEL
 #include "lib_grid/parallelization/distributed_grid.h"
@@ -61,7 +62,8 @@ Grid::Grid() :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_bAutoDefragment(false)
 {
 	m_hashCounter = 0;
 	m_currentMark = 0;
@@ -79,7 +81,8 @@ Grid::Grid(uint options) :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_bAutoDefragment(false)
 {
 	m_hashCounter = 0;
 	m_currentMark = 0;
@@ -97,7 +100,8 @@ Grid::Grid(const Grid& grid) :
 	m_bMarking(false),
 	m_aMark("Grid_Mark", false),
 	m_distGridMgr(NULL),
-	m_periodicBndMgr(NULL)
+	m_periodicBndMgr(NULL),
+	m_bAutoDefragment(false)
 {
 	m_hashCounter = 0;
 	m_currentMark = 0;
@@ -236,6 +240,56 @@ void Grid::clear_geometry()
 	
 //	reset options
 	set_options(opts);
+
+//	return chunks of object sizes which are no longer used by any grid
+	GridObject::release_unused_memory();
+}
+
+void Grid::defragment()
+{
+	get_attachment_pipe<Vertex>().compact();
+	get_attachment_pipe<Edge>().compact();
+	get_attachment_pipe<Face>().compact();
+	get_attachment_pipe<Volume>().compact();
+}
+
+void Grid::set_auto_defragment(bool enable)
+{
+	if(enable == m_bAutoDefragment)
+		return;
+
+	m_bAutoDefragment = enable;
+	if(enable){
+		m_spAdaptionCallbackId = m_messageHub->register_class_callback(
+										this, &Grid::adaption_callback);
+		m_spDistributionCallbackId = m_messageHub->register_class_callback(
+										this, &Grid::distribution_callback);
+		m_spCreationCallbackId = m_messageHub->register_class_callback(
+										this, &Grid::creation_callback);
+	}
+	else{
+		m_spAdaptionCallbackId = MessageHub::SPCallbackId();
+		m_spDistributionCallbackId = MessageHub::SPCallbackId();
+		m_spCreationCallbackId = MessageHub::SPCallbackId();
+	}
+}
+
+void Grid::adaption_callback(const GridMessage_Adaption& msg)
+{
+	if(msg.adaption_ends())
+		defragment();
+}
+
+void Grid::distribution_callback(const GridMessage_Distribution& msg)
+{
+	if(msg.msg() == GMDT_DISTRIBUTION_STOPS)
+		defragment();
+}
+
+void Grid::creation_callback(const GridMessage_Creation& msg)
+{
+	if(msg.msg() == GMCT_CREATION_STOPS)
+		defragment();
 }
 
 template <class TElem>
@@ -72,6 +72,11 @@ class DistributedGridManager;
 //	"lib_grid/tools/periodic_boundary_identifier.h"
 class PeriodicBoundaryManager;
 
+//	predeclaration of grid messages, defined in "lib_grid/lib_grid_messages.h"
+class GridMessage_Adaption;
+class GridMessage_Distribution;
+class GridMessage_Creation;
+
 /**
  * \brief Grid, MultiGrid and GridObjectCollection are contained in this group
  * \defgroup lib_grid_grid grid
@@ -355,6 +360,30 @@ class UG_API Grid
 	///	clears the grids attachments. The geometry remains.
 		void clear_attachments();
 
+	////////////////////////////////////////////////
+	//	attachment data layout
+	///	renumbers the attachment data of all elements in their iteration order
+	/**	Elements which are created during refinement or redistribution reuse
+	 * free data entries or are appended to the attachment arrays, so that
+	 * iterating the elements of a grid accesses the attached data (positions,
+	 * dof indices, ...) in arbitrary order. This method reorders the data of
+	 * vertices, edges, faces and volumes such that iterating over the
+	 * elements of the grid (and thus also over those of a subset) touches the
+	 * attachment arrays sequentially. Unused data entries are released.
+	 *
+	 * Note that this changes the data index of the elements and invalidates
+	 * raw pointers to attachment data arrays. Attachment accessors remain valid.*/
+		void defragment();
+
+	///	enables or disables the automatic renumbering of attachment data.
+	/**	If enabled, defragment is called whenever an adaption, a
+	 * redistribution or the creation of a grid has been finished (as signaled
+	 * through the grid's message hub). Disabled by default.*/
+		void set_auto_defragment(bool enable);
+
+	///	returns whether the attachment data is automatically renumbered
+		bool auto_defragment() const	{return m_bAutoDefragment;}
+
 	////////////////////////////////////////////////
 	//	element creation
 	///	create a custom element.
@@ -985,6 +1014,13 @@ class UG_API Grid
 								m_faceElementStorage, m_volumeElementStorage);
 		}
 
+	///	callbacks which trigger defragment if auto-defragmentation is enabled
+	/**	\{ */
+		void adaption_callback(const GridMessage_Adaption& msg);
+		void distribution_callback(const GridMessage_Distribution& msg);
+		void creation_callback(const GridMessage_Creation& msg);
+	/**	\} */
+
 	///	copies the contents from the given grid to this grid.
 	/**	Make sure that the grid on which this method is called is
 	 *	empty before the method is called.*/
@@ -1198,6 +1234,12 @@ class UG_API Grid
 		SPMessageHub 							m_messageHub;
 		DistributedGridManager*		m_distGridMgr;
 		PeriodicBoundaryManager*	m_periodicBndMgr;
+
+	//	automatic renumbering of attachment data
+		bool						m_bAutoDefragment;
+		MessageHub::SPCallbackId	m_spAdaptionCallbackId;
+		MessageHub::SPCallbackId	m_spDistributionCallbackId;
+		MessageHub::SPCallbackId	m_spCreationCallbackId;
 };
 
 /** \} */
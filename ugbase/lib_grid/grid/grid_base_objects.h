@@ -148,9 +148,14 @@ template<> class attachment_traits<Volume*, ElementStorage<Volume> >;
  * In order to be used by libGrid, all derivatives of GridObject
  * have to specialize geometry_traits<GeomObjectType>.
  *
+ * All grid objects are allocated through the SmallObjectAllocator. Objects of
+ * the same size are thus placed in common chunks in the order of their
+ * creation, which avoids a call to malloc/free for each object and improves
+ * locality when iterating over the elements of a grid.
+ *
  * \ingroup lib_grid_grid_objects
  */
-class UG_API GridObject/* : public SmallObject<>*/
+class UG_API GridObject : public SmallObject<256, 65536>
 {
 	friend class Grid;
 	friend class attachment_traits<Vertex*, ElementStorage<Vertex> >;
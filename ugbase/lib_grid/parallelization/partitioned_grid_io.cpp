@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+#include <map>
+#include "partitioned_grid_io.h"
+#include "distributed_grid.h"
+#include "grid_object_id.h"
+#include "common/serialization.h"
+#include "common/util/string_util.h"
+#include "pcl/parallel_archive.h"
+#include "common/profiler/profiler.h"
+
+using namespace std;
+
+namespace ug{
+
+static const int PGIO_MAGIC_NUMBER = 38256139;
+static const int PGIO_VERSION = 1;
+
+static string PartitionFilename(const pcl::ProcessCommunicator& procComm)
+{
+	return string("grid_p") + ToString(procComm.get_local_proc_id());
+}
+
+///	writes the interfaces of all layouts of the given type as local indices
+template <class TElem>
+static void SerializeLayouts(BinaryBuffer& out, GridLayoutMap& glm,
+							 MultiElementAttachmentAccessor<AInt>& aaInt)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Map::iterator	MapIter;
+	typedef typename GridLayoutMap::Types<TElem>::Layout		Layout;
+	typedef typename Layout::Interface							Interface;
+	typedef typename Layout::iterator							InterfaceIter;
+
+	int numLayouts = 0;
+	for(MapIter iter = glm.layouts_begin<TElem>();
+		iter != glm.layouts_end<TElem>(); ++iter)
+		++numLayouts;
+	Serialize(out, numLayouts);
+
+	for(MapIter iter = glm.layouts_begin<TElem>();
+		iter != glm.layouts_end<TElem>(); ++iter)
+	{
+		Layout& layout = iter->second;
+		Serialize(out, (int)iter->first);
+		Serialize(out, (int)layout.num_levels());
+		for(size_t lvl = 0; lvl < layout.num_levels(); ++lvl){
+			int numInterfaces = 0;
+			for(InterfaceIter i = layout.begin(lvl); i != layout.end(lvl); ++i)
+				++numInterfaces;
+			Serialize(out, numInterfaces);
+
+			for(InterfaceIter i = layout.begin(lvl); i != layout.end(lvl); ++i){
+				Interface& intfc = layout.interface(i);
+				Serialize(out, (int)layout.proc_id(i));
+				Serialize(out, (int)intfc.size());
+			//	the order of the entries defines the pairing with the
+			//	interface on the neighbor process and thus has to be preserved.
+				for(typename Interface::iterator e = intfc.begin();
+					e != intfc.end(); ++e)
+				{
+					Serialize(out, aaInt[intfc.get_element(e)]);
+				}
+			}
+		}
+	}
+}
+
+///	rebuilds the layouts of the given type from local indices into elems
+template <class TElem>
+static void DeserializeLayouts(BinaryBuffer& in, GridLayoutMap& glm,
+							   const vector<TElem*>& elems)
+{
+	typedef typename GridLayoutMap::Types<TElem>::Layout		Layout;
+	typedef typename Layout::Interface							Interface;
+
+	int numLayouts;
+	Deserialize(in, numLayouts);
+	for(int i_layout = 0; i_layout < numLayouts; ++i_layout){
+		int key, numLevels;
+		Deserialize(in, key);
+		Deserialize(in, numLevels);
+		Layout& layout = glm.get_layout<TElem>(key);
+
+		for(int lvl = 0; lvl < numLevels; ++lvl){
+			int numInterfaces;
+			Deserialize(in, numInterfaces);
+			for(int i_intfc = 0; i_intfc < numInterfaces; ++i_intfc){
+				int procID, numEntries;
+				Deserialize(in, procID);
+				Deserialize(in, numEntries);
+				Interface& intfc = layout.interface(procID, lvl);
+				for(int i = 0; i < numEntries; ++i){
+					int ind;
+					Deserialize(in, ind);
+					UG_COND_THROW(ind < 0 || ind >= (int)elems.size(),
+								  "Invalid interface entry in partitioned grid.");
+					intfc.push_back(elems[ind]);
+				}
+			}
+		}
+	}
+}
+
+
+void SavePartitionedGrid(MultiGrid& mg,
+						 GridDataSerializationHandler& serializer,
+						 const char* filename,
+						 const pcl::ProcessCommunicator& procComm)
+{
+	PROFILE_FUNC_GROUP("grid");
+	UG_COND_THROW(!mg.is_parallel(), "SavePartitionedGrid: Can't save a serial "
+				  "grid as partitioned grid. Compile ug with -DPARALLEL=ON");
+
+	GridLayoutMap& glm = mg.distributed_grid_manager()->grid_layout_map();
+
+	const bool hasIDs = mg.has_attachment<Vertex>(aGeomObjID)
+						&& mg.has_attachment<Edge>(aGeomObjID)
+						&& mg.has_attachment<Face>(aGeomObjID)
+						&& mg.has_attachment<Volume>(aGeomObjID);
+
+	AInt aLocalInd("partitioned-grid-io-tmp-local-index");
+	mg.attach_to_all(aLocalInd);
+	MultiElementAttachmentAccessor<AInt> aaInt(mg, aLocalInd);
+
+	pcl::ParallelArchive archive(filename, procComm);
+	BinaryBuffer& out = archive.create_BinaryBuffer_file(PartitionFilename(procComm));
+
+	Serialize(out, PGIO_MAGIC_NUMBER);
+	Serialize(out, PGIO_VERSION);
+	Serialize(out, (int)procComm.size());
+	Serialize(out, hasIDs);
+
+	if(hasIDs){
+		MultiElementAttachmentAccessor<AGeomObjID> aaID(mg, aGeomObjID);
+		SerializeMultiGridElements(mg, mg.get_grid_objects(), aaInt, out, &aaID);
+	}
+	else
+		SerializeMultiGridElements(mg, mg.get_grid_objects(), aaInt, out);
+
+	serializer.write_infos(out);
+	serializer.serialize(out, mg.get_grid_objects());
+
+	SerializeLayouts<Vertex>(out, glm, aaInt);
+	SerializeLayouts<Edge>(out, glm, aaInt);
+	SerializeLayouts<Face>(out, glm, aaInt);
+	SerializeLayouts<Volume>(out, glm, aaInt);
+	Serialize(out, PGIO_MAGIC_NUMBER);
+
+	mg.detach_from_all(aLocalInd);
+
+	archive.write();
+}
+
+
+void LoadPartitionedGrid(MultiGrid& mg,
+						 GridDataSerializationHandler& serializer,
+						 const char* filename,
+						 const pcl::ProcessCommunicator& procComm)
+{
+	PROFILE_FUNC_GROUP("grid");
+	UG_COND_THROW(!mg.is_parallel(), "LoadPartitionedGrid: Can't load a "
+				  "partitioned grid into a serial grid. Compile ug with -DPARALLEL=ON");
+	UG_COND_THROW(mg.num<Vertex>() > 0, "LoadPartitionedGrid: The given grid "
+				  "has to be empty.");
+
+//	each process only reads its own part of the archive
+	map<string, BinaryBuffer> files;
+	pcl::ProcessCommunicator pc = procComm;
+	pcl::ReadParallelArchive(pc, filename, files);
+
+	map<string, BinaryBuffer>::iterator fileIter = files.find(PartitionFilename(procComm));
+	UG_COND_THROW(fileIter == files.end(), "LoadPartitionedGrid: No partition for "
+				  "process " << procComm.get_local_proc_id() << " in " << filename);
+	BinaryBuffer& in = fileIter->second;
+
+	int magic, version, numProcs;
+	bool hasIDs;
+	Deserialize(in, magic);
+	Deserialize(in, version);
+	Deserialize(in, numProcs);
+	Deserialize(in, hasIDs);
+	UG_COND_THROW(magic != PGIO_MAGIC_NUMBER || version != PGIO_VERSION,
+				  "LoadPartitionedGrid: " << filename << " is not a partitioned grid.");
+	UG_COND_THROW(numProcs != (int)procComm.size(),
+				  "LoadPartitionedGrid: " << filename << " was written by "
+				  << numProcs << " processes, but is loaded by " << procComm.size());
+
+	DistributedGridManager& distGridMgr = *mg.distributed_grid_manager();
+	GridLayoutMap& glm = distGridMgr.grid_layout_map();
+
+	SPMessageHub msgHub = mg.message_hub();
+	msgHub->post_message(GridMessage_Creation(GMCT_CREATION_STARTS));
+
+//	interfaces are built explicitly from the stored layouts below
+	distGridMgr.enable_interface_management(false);
+
+	vector<Vertex*>	vrts;
+	vector<Edge*>	edges;
+	vector<Face*>	faces;
+	vector<Volume*>	vols;
+
+	if(hasIDs){
+		if(!mg.has_attachment<Vertex>(aGeomObjID))	mg.attach_to<Vertex>(aGeomObjID);
+		if(!mg.has_attachment<Edge>(aGeomObjID))	mg.attach_to<Edge>(aGeomObjID);
+		if(!mg.has_attachment<Face>(aGeomObjID))	mg.attach_to<Face>(aGeomObjID);
+		if(!mg.has_attachment<Volume>(aGeomObjID))	mg.attach_to<Volume>(aGeomObjID);
+		MultiElementAttachmentAccessor<AGeomObjID> aaID(mg, aGeomObjID);
+		DeserializeMultiGridElements(mg, in, &vrts, &edges, &faces, &vols, &aaID);
+	}
+	else
+		DeserializeMultiGridElements(mg, in, &vrts, &edges, &faces, &vols);
+
+	serializer.deserialization_starts();
+	serializer.read_infos(in);
+	serializer.deserialize(in, vrts.begin(), vrts.end());
+	serializer.deserialize(in, edges.begin(), edges.end());
+	serializer.deserialize(in, faces.begin(), faces.end());
+	serializer.deserialize(in, vols.begin(), vols.end());
+
+	DeserializeLayouts<Vertex>(in, glm, vrts);
+	DeserializeLayouts<Edge>(in, glm, edges);
+	DeserializeLayouts<Face>(in, glm, faces);
+	DeserializeLayouts<Volume>(in, glm, vols);
+
+	Deserialize(in, magic);
+	UG_COND_THROW(magic != PGIO_MAGIC_NUMBER, "LoadPartitionedGrid: Magic number "
+				  "mismatch after deserialization. Please make sure to use a "
+				  "serializer matching the one used in SavePartitionedGrid.");
+
+	glm.remove_empty_interfaces();
+	distGridMgr.enable_interface_management(true);
+	distGridMgr.grid_layouts_changed(false);
+
+	msgHub->post_message(GridMessage_Creation(GMCT_CREATION_STOPS));
+	serializer.deserialization_done();
+}
+
+}//	end of namespace
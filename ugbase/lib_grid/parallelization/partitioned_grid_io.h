@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2015:  G-CSC, Goethe University Frankfurt
+ * 
+ * This file is part of UG4.
+ * 
+ * UG4 is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License version 3 (as published by the
+ * Free Software Foundation) with the following additional attribution
+ * requirements (according to LGPL/GPL v3 §7):
+ * 
+ * (1) The following notice must be displayed in the Appropriate Legal Notices
+ * of covered and combined works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (2) The following notice must be displayed at a prominent place in the
+ * terminal output of covered works: "Based on UG4 (www.ug4.org/license)".
+ * 
+ * (3) The following bibliography is recommended for citation and must be
+ * preserved in all covered files:
+ * "Reiter, S., Vogel, A., Heppner, I., Rupp, M., and Wittum, G. A massively
+ *   parallel geometric multigrid solver on hierarchically distributed grids.
+ *   Computing and visualization in science 16, 4 (2013), 151-164"
+ * "Vogel, A., Reiter, S., Rupp, M., Nägel, A., and Wittum, G. UG4 -- a novel
+ *   flexible software system for simulating pde based models on high performance
+ *   computers. Computing and visualization in science 16, 4 (2013), 165-179"
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ */
+#ifndef __H__UG_partitioned_grid_io
+#define __H__UG_partitioned_grid_io
+
+#include "lib_grid/multi_grid.h"
+#include "lib_grid/algorithms/serialization.h"
+#include "pcl/pcl_process_communicator.h"
+
+namespace ug{
+
+///	Writes the local parts of a distributed multi-grid to a partitioned archive.
+/**	The archive is written through pcl::ParallelArchive, i.e. all processes
+ * write their part of the grid in parallel into one tar file using MPI-IO.
+ * Besides the grid elements, global ids (if attached) and the data of
+ * the given serializer, the vertical and horizontal interfaces of the
+ * grid layout map are stored.
+ *
+ * The archive can be loaded through LoadPartitionedGrid on the same number
+ * of processes, where each process only reads its own part. This avoids
+ * loading the whole grid on one process and distributing it afterwards.
+ *
+ * \note	Collective on procComm.*/
+void SavePartitionedGrid(MultiGrid& mg,
+						 GridDataSerializationHandler& serializer,
+						 const char* filename,
+						 const pcl::ProcessCommunicator& procComm =
+								 	 	 	 	 pcl::ProcessCommunicator());
+
+///	Loads the local part of a distributed multi-grid from a partitioned archive.
+/**	The archive has to be written by SavePartitionedGrid on the same number of
+ * processes. The given grid has to be empty and the serializer has to contain
+ * the same data-serializers (in the same order) as the one used for writing.
+ *
+ * The method posts GridMessage_Creation(GMCT_CREATION_STARTS) and
+ * GridMessage_Creation(GMCT_CREATION_STOPS) to the message hub of the grid.
+ *
+ * \note	Collective on procComm.*/
+void LoadPartitionedGrid(MultiGrid& mg,
+						 GridDataSerializationHandler& serializer,
+						 const char* filename,
+						 const pcl::ProcessCommunicator& procComm =
+								 	 	 	 	 pcl::ProcessCommunicator());
+
+}//	end of namespace
+
+#endif	//__H__UG_partitioned_grid_io
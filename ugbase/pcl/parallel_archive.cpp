@@ -63,7 +63,8 @@ void WriteParallelArchive(ProcessCommunicator &pc, std::string strFilename, cons
 					MPI_MODE_CREATE | MPI_MODE_RDWR, MPI_INFO_NULL, &fh);
 
 
-	int mySize = 0;
+	//	offsets are 64 bit, so that archives larger than 2GB can be written
+	long long mySize = 0;
 	if(bLast) mySize += 1024;
 	size_t ug4tarLookupSize = sizeof(size_t)*pc.size();
 	if(bFirst) mySize += sizeof(TarHeader) + ug4tarLookupSize + Get512Padding(ug4tarLookupSize);
@@ -76,19 +77,21 @@ void WriteParallelArchive(ProcessCommunicator &pc, std::string strFilename, cons
 		mySize += sizeof(TarHeader) + s + Get512Padding(s);
 	}
 
-	int myOffset = 0;
-	MPI_Scan(&mySize, &myOffset, 1, MPI_INT, MPI_SUM, m_mpiComm);
+	long long myOffset = 0;
+	MPI_Scan(&mySize, &myOffset, 1, MPI_LONG_LONG, MPI_SUM, m_mpiComm);
 	myOffset-=mySize;
 //	UG_LOG_ALL_PROCS("MySize = " << mySize << "\n" << "MyOffset = " << myOffset << "\n");
 
+	long long totalSize = 0;
+	MPI_Allreduce(&mySize, &totalSize, 1, MPI_LONG_LONG, MPI_SUM, m_mpiComm);
 
-	MPI_File_seek(fh, myOffset, MPI_SEEK_SET);
+	MPI_File_seek(fh, (MPI_Offset)myOffset, MPI_SEEK_SET);
 
-	std::vector<int> allOffsets;
+	std::vector<long long> allOffsets;
 	if(bFirst) allOffsets.resize(pc.size());
 	else allOffsets.resize(1);
-	MPI_Gather(&myOffset, 1, MPI_INT,
-			&allOffsets[0], 1, MPI_INT, pc.get_proc_id(0), m_mpiComm);
+	MPI_Gather(&myOffset, 1, MPI_LONG_LONG,
+			&allOffsets[0], 1, MPI_LONG_LONG, pc.get_proc_id(0), m_mpiComm);
 
 	if(bFirst)
 	{
@@ -101,7 +104,8 @@ void WriteParallelArchive(ProcessCommunicator &pc, std::string strFilename, cons
 		 // write header
 		 MPI_File_write(fh, (void*)&t, sizeof(t), MPI_BYTE, &status);
 		 // write file
-		 MPI_File_write(fh, (void*)&allOffsets[0], ug4tarLookupSize, MPI_BYTE, &status);
+		 std::vector<size_t> lookupTable(allOffsets.begin(), allOffsets.end());
+		 MPI_File_write(fh, (void*)&lookupTable[0], ug4tarLookupSize, MPI_BYTE, &status);
 		 // write padding
 		 MPI_File_write(fh, (void*)padding, Get512Padding(ug4tarLookupSize), MPI_BYTE, &status);
 	}
@@ -131,8 +135,99 @@ void WriteParallelArchive(ProcessCommunicator &pc, std::string strFilename, cons
 	if(bLast)
 		MPI_File_write(fh, (void*)padding, 2*512, MPI_BYTE, &status);
 
+//	an existing larger file would otherwise keep its old tail
+	MPI_File_set_size(fh, (MPI_Offset)totalSize);
 	MPI_File_close(&fh);
 }
 
 
+void ReadParallelArchive(ProcessCommunicator &pc, std::string strFilename,
+						 std::map<std::string, BinaryBuffer> &filesOut)
+{
+	MPI_Comm mpiComm = pc.get_mpi_communicator();
+	MPI_File fh;
+	MPI_Status status;
+	const int root = 0;
+	bool bFirst = pc.get_local_proc_id() == root;
+
+	char filename[1024];
+	strcpy(filename, strFilename.c_str());
+	if(MPI_File_open(mpiComm, filename, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh)
+		!= MPI_SUCCESS)
+	{
+		UG_THROW("ReadParallelArchive: Couldn't open archive " << strFilename);
+	}
+
+	MPI_Offset fileSize;
+	MPI_File_get_size(fh, &fileSize);
+
+//	only the first process reads the lookup table. It then sends the begin and
+//	end of its segment to each process.
+	std::vector<long long> segments;
+	long long numEntries = 0;
+	if(bFirst)
+	{
+		TarHeader t;
+		if(fileSize >= (MPI_Offset)sizeof(TarHeader))
+			MPI_File_read_at(fh, 0, (void*)&t, sizeof(t), MPI_BYTE, &status);
+		if(strncmp(t.filename, ".tar_lookup_table", sizeof(t.filename)) == 0)
+		{
+			size_t tableSize = strtoul(t.octalFileSize, NULL, 8);
+			numEntries = tableSize / sizeof(size_t);
+			std::vector<size_t> lookupTable(numEntries);
+			if(numEntries > 0)
+				MPI_File_read_at(fh, sizeof(TarHeader), (void*)&lookupTable[0],
+								 tableSize, MPI_BYTE, &status);
+
+			segments.resize(2 * numEntries);
+			for(long long i = 0; i < numEntries; ++i){
+				segments[2*i] = lookupTable[i];
+				segments[2*i+1] = (i+1 < numEntries) ? (long long)lookupTable[i+1]
+													  : (long long)fileSize;
+			}
+		}
+	}
+
+	MPI_Bcast(&numEntries, 1, MPI_LONG_LONG, root, mpiComm);
+	if(numEntries != (long long)pc.size()){
+		MPI_File_close(&fh);
+		UG_THROW("ReadParallelArchive: Archive " << strFilename << " was written by "
+				 << numEntries << " processes, but is read by " << pc.size() << ".");
+	}
+
+	long long mySegment[2];
+	MPI_Scatter(bFirst ? &segments[0] : NULL, 2, MPI_LONG_LONG,
+				mySegment, 2, MPI_LONG_LONG, root, mpiComm);
+
+	std::vector<char> data(mySegment[1] - mySegment[0]);
+	if(!data.empty())
+		MPI_File_read_at(fh, (MPI_Offset)mySegment[0], (void*)&data[0],
+						 (int)data.size(), MPI_BYTE, &status);
+	MPI_File_close(&fh);
+
+//	parse the tar headers of the local segment
+	size_t pos = 0;
+	while(pos + sizeof(TarHeader) <= data.size())
+	{
+		TarHeader t;
+		memcpy((void*)&t, &data[pos], sizeof(TarHeader));
+		pos += sizeof(TarHeader);
+		if(t.filename[0] == 0)
+			break;
+
+		std::string name(t.filename, strnlen(t.filename, sizeof(t.filename)));
+		size_t size = strtoul(t.octalFileSize, NULL, 8);
+		UG_COND_THROW(pos + size > data.size(), "ReadParallelArchive: File "
+					  << name << " in archive " << strFilename << " is truncated.");
+
+		if(name != ".tar_lookup_table"){
+			BinaryBuffer& buf = filesOut[name];
+			buf.clear();
+			buf.write(&data[pos], size);
+		}
+		pos += size + Get512Padding(size);
+	}
+}
+
+
 }
@@ -34,6 +34,7 @@
 #define PARALLEL_ARCHIVE_H_
 
 #include "pcl_process_communicator.h"
+#include "common/util/binary_buffer.h"
 #include "common/util/binary_stream.h"
 #include "common/log.h"
 #include <map>
@@ -75,10 +76,21 @@ void WriteParallelArchive(pcl::ProcessCommunicator &pc, std::string strFilename,
 {
 	std::vector<FileBufferDescriptor> fdesc;
 	for(typename std::map<std::string, TBuffer>::const_iterator it = files.begin(); it != files.end(); ++it)
-		 files.push_back(FileBufferDescriptor(ug::FilenameWithoutPath(it->first), it->second));
+		 fdesc.push_back(FileBufferDescriptor(ug::FilenameWithoutPath(it->first), it->second));
 	WriteParallelArchive(pc, strFilename, fdesc);
 }
 
+/**
+ * Reads the files which the calling process wrote to an archive created by
+ * WriteParallelArchive (or ParallelArchive). Each process only reads its own
+ * segment of the archive, using the lookup table stored by the first process.
+ * NOTE: Collective on pc. pc has to have the same size as the communicator
+ * which was used to write the archive.
+ * @param filesOut	maps the names of the files to their content.
+ */
+void ReadParallelArchive(pcl::ProcessCommunicator &pc, std::string strFilename,
+						 std::map<std::string, ug::BinaryBuffer> &filesOut);
+
 /**
  * This class creates one .a archive out of several parallel file writes
  * This has two advantages
@@ -420,6 +420,7 @@ bool InterfaceCommunicator<TLayout>::
 communicate_and_resume(int tag)
 {
 	PCL_PROFILE(pcl_IntCom_communicate);
+	PCL_TIMELINE(pcl_IntCom_communicate);
 
 	if(!(m_vSendRequests.empty() && m_vReceiveRequests.empty())){
 		UG_THROW("Can't communicate since a previous communication is still pending! "
@@ -679,6 +680,7 @@ wait()
 //		by waiting for the next one etc...
 	{
 		PCL_PROFILE(pcl_IntCom_MPIWait);
+		PCL_TIMELINE(pcl_IntCom_MPIWait);
 		Waitall(m_vReceiveRequests, m_vSendRequests);
 	}
 	
@@ -319,6 +319,7 @@ allreduce(const void* sendBuf, void* recBuf, int count,
 		  DataType type, ReduceOperation op) const
 {
 	PCL_PROFILE(pcl_ProcCom_allreduce);
+	PCL_TIMELINE(pcl_ProcCom_allreduce);
 	if(is_local()) {memcpy(recBuf, sendBuf, count*GetSize(type)); return;}
 	UG_COND_THROW(empty(),	"ERROR in ProcessCommunicator::allreduce: empty communicator.");
 
@@ -334,6 +335,24 @@ allreduce(const size_t &t, pcl::ReduceOperation op) const
 	return (size_t)ret;
 }
 
+void
+ProcessCommunicator::
+iallreduce(const void* sendBuf, void* recBuf, int count,
+		   DataType type, ReduceOperation op, MPI_Request* request) const
+{
+	PCL_PROFILE(pcl_ProcCom_iallreduce);
+	*request = MPI_REQUEST_NULL;
+	if(is_local()) {memcpy(recBuf, sendBuf, count*GetSize(type)); return;}
+	UG_COND_THROW(empty(),	"ERROR in ProcessCommunicator::iallreduce: empty communicator.");
+
+#if MPI_VERSION >= 3
+	MPI_Iallreduce(const_cast<void*>(sendBuf), recBuf, count, type, op,
+				   m_comm->m_mpiComm, request);
+#else
+	MPI_Allreduce(const_cast<void*>(sendBuf), recBuf, count, type, op, m_comm->m_mpiComm);
+#endif
+}
+
 void
 ProcessCommunicator::
 gather(const void* sendBuf, int sendCount, DataType sendType,
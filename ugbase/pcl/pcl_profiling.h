@@ -44,10 +44,28 @@
 	#define PCL_PROFILE_FUNC()	PROFILE_FUNC_GROUP("pcl")
 	#define PCL_PROFILE(name)	PROFILE_BEGIN_GROUP(name, "pcl")
 	#define PCL_PROFILE_END()	PROFILE_END()
+//	communication is already contained in the timeline as a profiled zone
+	#define PCL_TIMELINE(name)
 #else
 	#define PCL_PROFILE_FUNC()
 	#define PCL_PROFILE(name)
 	#define PCL_PROFILE_END()
+
+/**	PCL_TIMELINE marks a communication step in the timeline of the native
+ * profiler, without adding a zone to the profile tree. Recording only takes
+ * place if the timeline has been enabled (see EnableProfilerTimeline).*/
+	#ifdef UG_PROFILER_NATIVE
+		#include "common/profiler/native_profiler.h"
+		#define PCL_TIMELINE(name)										\
+			static Shiny::ProfileZone __pclTimelineZone_##name = {		\
+				NULL, Shiny::ProfileZone::STATE_HIDDEN, #name,			\
+				"pcl", __FILE__, __LINE__,								\
+				{ { 0, 0 }, { 0, 0 }, { 0, 0 } }						\
+			};															\
+			ug::NativeTimelineScope __pclTimeline_##name(&__pclTimelineZone_##name);
+	#else
+		#define PCL_TIMELINE(name)
+	#endif
 #endif
 
 #endif